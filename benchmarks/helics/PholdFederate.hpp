@@ -20,6 +20,7 @@ SPDX-License-Identifier: BSD-3-Clause
 class PholdFederate: public BenchmarkFederate {
   public:
     int evCount{0};  // number of events handled by this federate
+    int grantCount{0};  // number of time grants received by this federate
 
   private:
     helics::Endpoint* ept{nullptr};
@@ -75,6 +76,7 @@ class PholdFederate: public BenchmarkFederate {
     void doAddBenchmarkResults() override
     {
         addResult("EVENT COUNT", "EvCount", std::to_string(evCount));
+        addResult("GRANT COUNT", "GrantCount", std::to_string(grantCount));
     }
 
     void doParamInit(helics::FederateInfo& /*fi*/) override
@@ -121,6 +123,7 @@ class PholdFederate: public BenchmarkFederate {
 
         while (nextTime < finalTime) {
             nextTime = fed->requestTime(finalTime);
+            grantCount++;
             // for each event message received, create a new event
             while (ept->hasMessage()) {
                 auto m = ept->getMessage();
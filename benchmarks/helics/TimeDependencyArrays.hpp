@@ -0,0 +1,344 @@
+/*
+Copyright (c) 2017-2021,
+Battelle Memorial Institute; Lawrence Livermore National Security, LLC; Alliance for Sustainable
+Energy, LLC.  See the top-level NOTICE for additional details. All rights reserved.
+SPDX-License-Identifier: BSD-3-Clause
+*/
+#pragma once
+
+#include "helics/core/ActionMessage.hpp"
+#include "helics/core/TimeDependencies.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace helics {
+/** structure of arrays copy of a set of dependencies
+@details the fields read by the grant checks and minimum time computations are held in separate
+contiguous arrays so those scans only load the data they use instead of every DependencyInfo.  The
+results match the TimeDependencies versions of the same operations.  The arrays are loaded from a
+TimeDependencies object and can be kept current through updateTime; changes to the dependency set
+require a reload.  The time coordinators do not use this layout, it is kept with the benchmarks to
+compare against TimeDependencies.
+*/
+class TimeDependencyArrays {
+  public:
+    /** default constructor*/
+    TimeDependencyArrays() = default;
+    /** construct from an existing set of dependencies*/
+    explicit TimeDependencyArrays(const TimeDependencies& deps) { load(deps); }
+    /** replace the contents with a copy of a set of dependencies*/
+    void load(const TimeDependencies& deps);
+    /** update the info about a dependency based on a message*/
+    bool updateTime(const ActionMessage& m);
+    /** get the number of dependencies*/
+    auto size() const { return fedIDs.size(); }
+    /**  check if there are no dependencies*/
+    bool empty() const { return fedIDs.empty(); }
+    /** get a copy of the dependency information for a particular object
+    @return a default DependencyInfo if the id is not present*/
+    DependencyInfo getDependencyInfo(GlobalFederateId id) const;
+
+    /** check if the dependencies would allow a grant of the time
+    @param iterating true if the object is iterating
+    @param desiredGrantTime  the time to check for granting
+    @return true if the object is ready
+    */
+    bool checkIfReadyForTimeGrant(bool iterating, Time desiredGrantTime) const;
+
+    /** compute the minimum times over the non-parent dependencies*/
+    TimeData generateMinTimeUpstream(bool restricted,
+                                     GlobalFederateId self,
+                                     GlobalFederateId ignore = GlobalFederateId{}) const;
+    /** compute the minimum times over the parent dependencies*/
+    TimeData generateMinTimeDownstream(bool restricted,
+                                       GlobalFederateId self,
+                                       GlobalFederateId ignore = GlobalFederateId{}) const;
+    /** compute the minimum times over all the dependencies*/
+    TimeData generateMinTimeTotal(bool restricted,
+                                  GlobalFederateId self,
+                                  GlobalFederateId ignore = GlobalFederateId{}) const;
+
+  private:
+    // bits of the flags array, the connection bits mirror the connection types checked by the
+    // minimum time computations
+    static constexpr std::uint8_t dependency_bit{0x01U};
+    static constexpr std::uint8_t dependent_bit{0x02U};
+    static constexpr std::uint8_t non_granting_bit{0x04U};
+    static constexpr std::uint8_t delayed_timing_bit{0x08U};
+    static constexpr std::uint8_t forwarding_bit{0x10U};
+    static constexpr std::uint8_t cyclic_bit{0x20U};
+    static constexpr std::uint8_t parent_connection_bit{0x40U};
+    static constexpr std::uint8_t self_connection_bit{0x80U};
+
+    /** filter for the connection type used in the minimum time computations*/
+    enum class ConnectionFilter : uint8_t { all, non_parent, parent };
+    /** find the index of a federate id or size() if not present*/
+    std::size_t findIndex(GlobalFederateId id) const;
+    /** copy the data at an index into a DependencyInfo*/
+    DependencyInfo gather(std::size_t index) const;
+    /** copy the data from a DependencyInfo into an index*/
+    void scatter(std::size_t index, const DependencyInfo& dep);
+    /** generate a Time from a stored time code*/
+    static Time timeFromCode(Time::baseType code);
+    TimeData generateMinTime(ConnectionFilter filter,
+                             bool restricted,
+                             GlobalFederateId self,
+                             GlobalFederateId ignore) const;
+
+    std::vector<GlobalFederateId::BaseType> fedIDs;  //!< sorted dependency identifiers
+    std::vector<Time::baseType> next;  //!< next possible message or value
+    std::vector<Time::baseType> Te;  //!< the next currently scheduled event
+    std::vector<Time::baseType> minDe;  //!< min dependency event time
+    std::vector<time_state_t> time_state;  //!< the time request state
+    std::vector<std::uint8_t> flags;  //!< dependency flags made of the *_bit constants
+    std::vector<ConnectionType> connection;  //!< the connection type
+    std::vector<GlobalFederateId::BaseType> minFed;  //!< identifier for the min dependency
+    std::vector<GlobalFederateId::BaseType> minFedActual;  //!< forwarded minimum federate
+};
+
+inline Time TimeDependencyArrays::timeFromCode(Time::baseType code)
+{
+    Time result{timeZero};
+    result.setBaseTimeCode(code);
+    return result;
+}
+
+inline void TimeDependencyArrays::load(const TimeDependencies& deps)
+{
+    const auto count = deps.size();
+    fedIDs.resize(count);
+    next.resize(count);
+    Te.resize(count);
+    minDe.resize(count);
+    time_state.resize(count);
+    flags.resize(count);
+    connection.resize(count);
+    minFed.resize(count);
+    minFedActual.resize(count);
+    std::size_t index{0};
+    for (const auto& dep : deps) {
+        scatter(index, dep);
+        ++index;
+    }
+}
+
+inline std::size_t TimeDependencyArrays::findIndex(GlobalFederateId id) const
+{
+    auto res = std::lower_bound(fedIDs.begin(), fedIDs.end(), id.baseValue());
+    if (res == fedIDs.end() || *res != id.baseValue()) {
+        return fedIDs.size();
+    }
+    return static_cast<std::size_t>(res - fedIDs.begin());
+}
+
+inline DependencyInfo TimeDependencyArrays::gather(std::size_t index) const
+{
+    DependencyInfo dep(GlobalFederateId(fedIDs[index]));
+    dep.next = timeFromCode(next[index]);
+    dep.Te = timeFromCode(Te[index]);
+    dep.minDe = timeFromCode(minDe[index]);
+    dep.time_state = time_state[index];
+    dep.minFed = GlobalFederateId(minFed[index]);
+    dep.minFedActual = GlobalFederateId(minFedActual[index]);
+    dep.connection = connection[index];
+    const auto flag = flags[index];
+    dep.dependency = (flag & dependency_bit) != 0;
+    dep.dependent = (flag & dependent_bit) != 0;
+    dep.nonGranting = (flag & non_granting_bit) != 0;
+    dep.delayedTiming = (flag & delayed_timing_bit) != 0;
+    dep.forwarding = (flag & forwarding_bit) != 0;
+    dep.cyclic = (flag & cyclic_bit) != 0;
+    return dep;
+}
+
+inline void TimeDependencyArrays::scatter(std::size_t index, const DependencyInfo& dep)
+{
+    fedIDs[index] = dep.fedID.baseValue();
+    next[index] = dep.next.getBaseTimeCode();
+    Te[index] = dep.Te.getBaseTimeCode();
+    minDe[index] = dep.minDe.getBaseTimeCode();
+    time_state[index] = dep.time_state;
+    minFed[index] = dep.minFed.baseValue();
+    minFedActual[index] = dep.minFedActual.baseValue();
+    connection[index] = dep.connection;
+    unsigned int flag{0U};
+    flag |= dep.dependency ? dependency_bit : 0U;
+    flag |= dep.dependent ? dependent_bit : 0U;
+    flag |= dep.nonGranting ? non_granting_bit : 0U;
+    flag |= dep.delayedTiming ? delayed_timing_bit : 0U;
+    flag |= dep.forwarding ? forwarding_bit : 0U;
+    flag |= dep.cyclic ? cyclic_bit : 0U;
+    flag |= (dep.connection == ConnectionType::parent) ? parent_connection_bit : 0U;
+    flag |= (dep.connection == ConnectionType::self) ? self_connection_bit : 0U;
+    flags[index] = static_cast<std::uint8_t>(flag);
+}
+
+inline DependencyInfo TimeDependencyArrays::getDependencyInfo(GlobalFederateId id) const
+{
+    auto index = findIndex(id);
+    return (index < fedIDs.size()) ? gather(index) : DependencyInfo{};
+}
+
+inline bool TimeDependencyArrays::updateTime(const ActionMessage& m)
+{
+    auto dependency_id = (m.action() != CMD_SEND_MESSAGE) ? m.source_id : m.dest_id;
+
+    auto index = findIndex(GlobalFederateId(dependency_id));
+    if (index >= fedIDs.size() || (flags[index] & dependency_bit) == 0) {
+        return false;
+    }
+    auto dep = gather(index);
+    if (!processDependencyMessage(m, dep)) {
+        return false;
+    }
+    scatter(index, dep);
+    return true;
+}
+
+inline bool TimeDependencyArrays::checkIfReadyForTimeGrant(bool iterating,
+                                                           Time desiredGrantTime) const
+{
+    const auto grantCode = desiredGrantTime.getBaseTimeCode();
+    // non granting dependencies only hold back non iterative requests
+    const std::uint8_t holdMask = iterating ? 0U : non_granting_bit;
+    const auto count = fedIDs.size();
+    for (std::size_t ii = 0; ii < count; ++ii) {
+        const auto flag = flags[ii];
+        if ((flag & dependency_bit) == 0) {
+            continue;
+        }
+        if (next[ii] < grantCode) {
+            return false;
+        }
+        if (next[ii] == grantCode) {
+            if (time_state[ii] == time_state_t::time_granted) {
+                return false;
+            }
+            if (time_state[ii] == time_state_t::time_requested && (flag & holdMask) != 0) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+inline TimeData TimeDependencyArrays::generateMinTime(ConnectionFilter filter,
+                                                      bool restricted,
+                                                      GlobalFederateId self,
+                                                      GlobalFederateId ignore) const
+{
+    // the dependency and connection filters reduce to a single masked compare of the flags
+    std::uint8_t filterMask{dependency_bit};
+    std::uint8_t filterValue{dependency_bit};
+    if (filter != ConnectionFilter::all) {
+        filterMask |= parent_connection_bit;
+        if (filter == ConnectionFilter::parent) {
+            filterValue |= parent_connection_bit;
+        }
+    }
+    const bool checkSelf = self.isValid();
+    const auto selfCode = self.baseValue();
+    const auto ignoreCode = ignore.baseValue();
+    const bool ignoreBroker = ignore.isBroker();
+    const auto invalidFed = GlobalFederateId{}.baseValue();
+
+    // this follows generateMinTimeImplementation with the running values held as time codes
+    auto mNext = Time::maxVal().getBaseTimeCode();
+    auto mTe = mNext;
+    auto mMinDe = mNext;
+    auto mTeAlt = mNext;
+    auto mState = time_state_t::initialized;
+    auto mMinFed = invalidFed;
+    auto mMinFedActual = invalidFed;
+    const auto count = fedIDs.size();
+    for (std::size_t ii = 0; ii < count; ++ii) {
+        const auto flag = flags[ii];
+        if ((flag & filterMask) != filterValue) {
+            continue;
+        }
+        if (checkSelf && minFedActual[ii] == selfCode) {
+            continue;
+        }
+        if (fedIDs[ii] == ignoreCode) {
+            if (ignoreBroker && Te[ii] < mMinDe) {
+                mMinDe = Te[ii];
+            }
+            continue;
+        }
+        const bool external = (flag & self_connection_bit) == 0;
+        const auto depNext = next[ii];
+        if (external) {
+            if (minDe[ii] >= depNext) {
+                if (minDe[ii] < mMinDe) {
+                    mMinDe = minDe[ii];
+                }
+            } else {
+                // this minimum dependent event time received was invalid and can't be trusted
+                mMinDe = Time(-1).getBaseTimeCode();
+            }
+        }
+        if (depNext < mNext) {
+            mNext = depNext;
+            mState = time_state[ii];
+        } else if (depNext == mNext && time_state[ii] == time_state_t::time_granted) {
+            mState = time_state_t::time_granted;
+        }
+        if (external) {
+            const auto depTe = Te[ii];
+            if (depTe < mTe) {
+                mTeAlt = mTe;
+                mTe = depTe;
+                mMinFed = fedIDs[ii];
+                if (GlobalFederateId(minFed[ii]).isValid()) {
+                    mMinFedActual = minFed[ii];
+                }
+            } else if (depTe == mTe) {
+                mMinFed = invalidFed;
+                mTeAlt = mTe;
+            }
+        }
+    }
+
+    TimeData mTime;
+    mTime.next = timeFromCode(mNext);
+    mTime.Te = timeFromCode(mTe);
+    mTime.minDe = timeFromCode(mMinDe);
+    mTime.TeAlt = timeFromCode(mTeAlt);
+    mTime.time_state = mState;
+    mTime.minFed = GlobalFederateId(mMinFed);
+    mTime.minFedActual = GlobalFederateId(mMinFedActual);
+    if (mTime.Te < mTime.minDe) {
+        mTime.minDe = mTime.Te;
+    }
+
+    if (!restricted) {
+        if (mTime.minDe > mTime.next) {
+            mTime.next = mTime.minDe;
+        }
+    }
+    return mTime;
+}
+
+inline TimeData TimeDependencyArrays::generateMinTimeUpstream(bool restricted,
+                                                              GlobalFederateId self,
+                                                              GlobalFederateId ignore) const
+{
+    return generateMinTime(ConnectionFilter::non_parent, restricted, self, ignore);
+}
+
+inline TimeData TimeDependencyArrays::generateMinTimeDownstream(bool restricted,
+                                                                GlobalFederateId self,
+                                                                GlobalFederateId ignore) const
+{
+    return generateMinTime(ConnectionFilter::parent, restricted, self, ignore);
+}
+
+inline TimeData TimeDependencyArrays::generateMinTimeTotal(bool restricted,
+                                                           GlobalFederateId self,
+                                                           GlobalFederateId ignore) const
+{
+    return generateMinTime(ConnectionFilter::all, restricted, self, ignore);
+}
+}  // namespace helics
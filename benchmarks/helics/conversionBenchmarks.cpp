@@ -67,4 +67,28 @@ BENCHMARK_CAPTURE(BMinterpret,
 
 BENCHMARK_CAPTURE(BMinterpret, vector_interp, std::vector<double>{26.5, 18.6, -48.5, -5.4e-12});
 
+static void BMrawDouble_conv(benchmark::State& state)
+{
+    double val{-356.56e-27};
+    std::byte store[helics::detail::rawDoubleSize];
+    for (auto _ : state) {
+        helics::detail::convertToRawBinary(store, val);
+        benchmark::DoNotOptimize(store);
+    }
+}
+BENCHMARK(BMrawDouble_conv);
+
+static void BMrawDouble_interp(benchmark::State& state)
+{
+    std::byte store[helics::detail::rawDoubleSize];
+    helics::detail::convertToRawBinary(store, -356.56e-27);
+    helics::data_view stv(reinterpret_cast<const char*>(store), sizeof(store));
+    double val2;
+    for (auto _ : state) {
+        helics::ValueConverter<double>::interpret(stv, val2);
+        benchmark::DoNotOptimize(val2);
+    }
+}
+BENCHMARK(BMrawDouble_interp);
+
 HELICS_BENCHMARK_MAIN(conversionBenchmark);
@@ -20,7 +20,9 @@ SPDX-License-Identifier: BSD-3-Clause
 
 using helics::CoreType;
 // static constexpr helics::Time tend = 3600.0_t;  // simulation end time
-static void BMphold_singleCore(benchmark::State& state)
+/** run the phold benchmark with all the federates on a single inproc core
+@param coreArgs additional arguments for the core*/
+static void runPholdSingleCore(benchmark::State& state, const std::string& coreArgs)
 {
     for (auto _ : state) {
         state.PauseTiming();
@@ -29,7 +31,7 @@ static void BMphold_singleCore(benchmark::State& state)
         gmlc::concurrency::Barrier brr(static_cast<size_t>(fed_count));
         auto wcore = helics::CoreFactory::create(CoreType::INPROC,
                                                  std::string("--autobroker --federates=") +
-                                                     std::to_string(fed_count));
+                                                     std::to_string(fed_count) + coreArgs);
         std::vector<PholdFederate> feds(fed_count);
         for (int ii = 0; ii < fed_count; ++ii) {
             // phold federate default seed values are deterministic, based on index
@@ -54,16 +56,24 @@ static void BMphold_singleCore(benchmark::State& state)
         }
 
         int totalEvCount = 0;
+        int totalGrantCount = 0;
         for (int ii = 0; ii < fed_count; ++ii) {
             totalEvCount += feds[ii].evCount;
+            totalGrantCount += feds[ii].grantCount;
         }
         state.counters["EvCount"] = totalEvCount;
+        state.counters["GrantCount"] = totalGrantCount;
 
         wcore.reset();
         helics::cleanupHelicsLibrary();
         state.ResumeTiming();
     }
 }
+
+static void BMphold_singleCore(benchmark::State& state)
+{
+    runPholdSingleCore(state, std::string{});
+}
 // Register the function as a benchmark
 BENCHMARK(BMphold_singleCore)
     ->RangeMultiplier(2)
@@ -72,6 +82,22 @@ BENCHMARK(BMphold_singleCore)
     ->Iterations(1)
     ->UseRealTime();
 
+/** phold with a federation time quantum, the second argument is the quantum in ns (0 for none)
+so the GrantCount counter can be compared with the unquantized run*/
+static void BMphold_timeQuantum(benchmark::State& state)
+{
+    runPholdSingleCore(state, " --time_quantum=" + std::to_string(state.range(1)) + "ns");
+}
+// Register the function as a benchmark
+BENCHMARK(BMphold_timeQuantum)
+    ->Args({16, 0})
+    ->Args({16, 2})
+    ->Args({16, 5})
+    ->Args({16, 10})
+    ->Unit(benchmark::TimeUnit::kMillisecond)
+    ->Iterations(1)
+    ->UseRealTime();
+
 static void BMphold_multiCore(benchmark::State& state, CoreType cType)
 {
     for (auto _ : state) {
@@ -116,10 +142,13 @@ static void BMphold_multiCore(benchmark::State& state, CoreType cType)
         }
 
         int totalEvCount = 0;
+        int totalGrantCount = 0;
         for (auto& f : feds) {
             totalEvCount += f.evCount;
+            totalGrantCount += f.grantCount;
         }
         state.counters["EvCount"] = totalEvCount;
+        state.counters["GrantCount"] = totalGrantCount;
 
         broker->disconnect();
         broker.reset();
@@ -0,0 +1,113 @@
+/*
+Copyright (c) 2017-2021,
+Battelle Memorial Institute; Lawrence Livermore National Security, LLC; Alliance for Sustainable
+Energy, LLC.  See the top-level NOTICE for additional details. All rights reserved.
+SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include "helics/application_api/Publications.hpp"
+#include "helics/application_api/ValueFederate.hpp"
+#include "helics/common/JsonProcessingFunctions.hpp"
+#include "helics/core/BrokerFactory.hpp"
+#include "helics/core/CoreFactory.hpp"
+#include "helics_benchmark_main.h"
+
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+/** generate a document with a structure similar to a federate_map response*/
+static Json::Value generateMapDocument(int federateCount)
+{
+    Json::Value base;
+    base["name"] = "root_broker";
+    base["id"] = 1;
+    base["parent"] = 0;
+    base["cores"] = Json::arrayValue;
+    Json::Value core;
+    core["name"] = "benchmark_core_with_a_long_name";
+    core["id"] = 1879048192;
+    core["parent"] = 1;
+    core["federates"] = Json::arrayValue;
+    for (int ii = 0; ii < federateCount; ++ii) {
+        Json::Value fed;
+        fed["name"] = "federate_" + std::to_string(ii);
+        fed["id"] = 131072 + ii;
+        fed["parent"] = 1879048192;
+        fed["next_time"] = 1.5 * ii;
+        core["federates"].append(fed);
+    }
+    base["cores"].append(core);
+    return base;
+}
+
+/** each broker hop in the JSON transport generates and parses text*/
+static void BMqueryRelayJson(benchmark::State& state)
+{
+    auto doc = generateMapDocument(static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        auto str = helics::fileops::generateJsonString(doc);
+        auto val = helics::fileops::loadJsonStr(str);
+        benchmark::DoNotOptimize(val);
+    }
+}
+// Register the function as a benchmark
+BENCHMARK(BMqueryRelayJson)->RangeMultiplier(4)->Range(16, 16384);
+
+/** each broker hop in the binary transport generates and decodes the binary form*/
+static void BMqueryRelayBinary(benchmark::State& state)
+{
+    auto doc = generateMapDocument(static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        auto str = helics::fileops::generateBinaryJson(doc);
+        auto val = helics::fileops::loadJsonStr(str);
+        benchmark::DoNotOptimize(val);
+    }
+}
+// Register the function as a benchmark
+BENCHMARK(BMqueryRelayBinary)->RangeMultiplier(4)->Range(16, 16384);
+
+/** full federate_map query latency through a broker with several cores*/
+static void BMfederateMapQuery(benchmark::State& state)
+{
+    const int feds = static_cast<int>(state.range(0));
+    const int coreCount = 4;
+    auto broker = helics::BrokerFactory::create(helics::CoreType::INPROC,
+                                                "brokerq",
+                                                std::string("-f ") + std::to_string(feds));
+    std::vector<std::shared_ptr<helics::Core>> cores(coreCount);
+    for (int ii = 0; ii < coreCount; ++ii) {
+        cores[ii] = helics::CoreFactory::create(helics::CoreType::INPROC,
+                                                "qcore" + std::to_string(ii),
+                                                "--broker=brokerq");
+    }
+    std::vector<std::unique_ptr<helics::ValueFederate>> federates;
+    federates.reserve(feds);
+    for (int ii = 0; ii < feds; ++ii) {
+        helics::FederateInfo fi(helics::CoreType::INPROC);
+        fi.coreName = "qcore" + std::to_string(ii % coreCount);
+        federates.push_back(
+            std::make_unique<helics::ValueFederate>("qfed" + std::to_string(ii), fi));
+        federates.back()->registerPublication<double>("pub");
+    }
+    for (auto _ : state) {
+        auto res = federates.front()->query("root", "federate_map");
+        benchmark::DoNotOptimize(res);
+    }
+    for (auto& fed : federates) {
+        fed->finalize();
+    }
+    federates.clear();
+    cores.clear();
+    broker->waitForDisconnect();
+}
+// Register the function as a benchmark
+BENCHMARK(BMfederateMapQuery)
+    ->RangeMultiplier(4)
+    ->Range(4, 256)
+    ->Iterations(100)
+    ->Unit(benchmark::TimeUnit::kMillisecond)
+    ->UseRealTime();
+
+HELICS_BENCHMARK_MAIN(queryBenchmark);
@@ -0,0 +1,76 @@
+/*
+Copyright (c) 2017-2021,
+Battelle Memorial Institute; Lawrence Livermore National Security, LLC; Alliance for Sustainable
+Energy, LLC.  See the top-level NOTICE for additional details. All rights reserved.
+SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include "helics/core/DenseRoutingTable.hpp"
+#include "helics/core/GlobalFederateId.hpp"
+#include "helics_benchmark_main.h"
+
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+using namespace helics;  // NOLINT
+
+/** generate the ids of a federation with the given number of federates spread over a set of
+sub brokers, and a random sequence of destinations to route messages to*/
+static std::vector<GlobalFederateId> generateDestinations(int federateCount)
+{
+    std::vector<GlobalFederateId> destinations(4096);
+    std::mt19937 gen(1234);
+    std::uniform_int_distribution<int> dist(0, federateCount - 1);
+    for (auto& dest : destinations) {
+        dest = GlobalFederateId(gGlobalFederateIdShift + dist(gen));
+    }
+    return destinations;
+}
+
+static route_id routeFor(int index)
+{
+    // federates are spread over 64 sub brokers
+    return route_id(index % 64 + 1);
+}
+
+static void BMrouteUnorderedMap(benchmark::State& state)
+{
+    const auto federateCount = static_cast<int>(state.range(0));
+    std::unordered_map<GlobalFederateId, route_id> table;
+    for (int ii = 0; ii < federateCount; ++ii) {
+        table.emplace(GlobalFederateId(gGlobalFederateIdShift + ii), routeFor(ii));
+    }
+    auto destinations = generateDestinations(federateCount);
+    std::size_t index{0};
+    for (auto _ : state) {
+        auto fnd = table.find(destinations[index]);
+        auto route = (fnd != table.end()) ? fnd->second : parent_route_id;
+        benchmark::DoNotOptimize(route);
+        index = (index + 1) & (destinations.size() - 1);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+// Register the function as a benchmark
+BENCHMARK(BMrouteUnorderedMap)->Arg(100)->Arg(10000);
+
+static void BMrouteDenseTable(benchmark::State& state)
+{
+    const auto federateCount = static_cast<int>(state.range(0));
+    DenseRoutingTable table;
+    for (int ii = 0; ii < federateCount; ++ii) {
+        table.emplace(GlobalFederateId(gGlobalFederateIdShift + ii), routeFor(ii));
+    }
+    auto destinations = generateDestinations(federateCount);
+    std::size_t index{0};
+    for (auto _ : state) {
+        auto route = table.getRoute(destinations[index], parent_route_id);
+        benchmark::DoNotOptimize(route);
+        index = (index + 1) & (destinations.size() - 1);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+// Register the function as a benchmark
+BENCHMARK(BMrouteDenseTable)->Arg(100)->Arg(10000);
+
+HELICS_BENCHMARK_MAIN(routingBenchmark);
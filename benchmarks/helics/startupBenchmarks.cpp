@@ -0,0 +1,169 @@
+/*
+Copyright (c) 2017-2021,
+Battelle Memorial Institute; Lawrence Livermore National Security, LLC; Alliance for Sustainable
+Energy, LLC.  See the top-level NOTICE for additional details. All rights reserved.
+SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include "helics/application_api/Federate.hpp"
+#include "helics/application_api/Publications.hpp"
+#include "helics/application_api/ValueFederate.hpp"
+#include "helics/core/BrokerFactory.hpp"
+#include "helics/core/CoreFactory.hpp"
+#include "helics/helics-config.h"
+#include "helics_benchmark_main.h"
+
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <gmlc/concurrency/Barrier.hpp>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using helics::CoreType;
+
+/** connect a large number of cores to a single broker at the same time*/
+static void BMstartup_connectionStorm(benchmark::State& state, CoreType cType)
+{
+    const int coreCount = static_cast<int>(state.range(0));
+    const int threadCount =
+        std::min(coreCount, std::max(4, static_cast<int>(std::thread::hardware_concurrency())));
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto broker = helics::BrokerFactory::create(cType, "startbroker", "--log_level=no_print");
+        std::vector<std::shared_ptr<helics::Core>> cores(coreCount);
+        for (auto& core : cores) {
+            core = helics::CoreFactory::create(cType, "--log_level=no_print");
+        }
+        gmlc::concurrency::Barrier brr(static_cast<size_t>(threadCount) + 1);
+        std::vector<std::thread> threadlist;
+        threadlist.reserve(threadCount);
+        for (int tt = 0; tt < threadCount; ++tt) {
+            threadlist.emplace_back([&, tt]() {
+                brr.wait();
+                for (int ii = tt; ii < coreCount; ii += threadCount) {
+                    cores[ii]->connect();
+                }
+            });
+        }
+        brr.wait();
+        state.ResumeTiming();
+        for (auto& thrd : threadlist) {
+            thrd.join();
+        }
+        state.PauseTiming();
+        auto connected = std::count_if(cores.begin(), cores.end(), [](const auto& core) {
+            return core->isConnected();
+        });
+        if (connected != coreCount) {
+            state.SkipWithError("not all cores connected to the broker");
+        }
+        for (auto& core : cores) {
+            core->disconnect();
+        }
+        broker->disconnect();
+        broker.reset();
+        cores.clear();
+        helics::cleanupHelicsLibrary();
+        state.ResumeTiming();
+    }
+    state.counters["cores"] = static_cast<double>(coreCount);
+    state.counters["core_rate"] = benchmark::Counter(static_cast<double>(coreCount),
+                                                     benchmark::Counter::kIsIterationInvariantRate);
+}
+
+// Register the inproc core benchmarks
+BENCHMARK_CAPTURE(BMstartup_connectionStorm, inprocCore, CoreType::INPROC)
+    ->RangeMultiplier(4)
+    ->Range(32, 2048)
+    ->Iterations(1)
+    ->Unit(benchmark::TimeUnit::kMillisecond)
+    ->UseRealTime();
+
+#ifdef HELICS_ENABLE_TCP_CORE
+// Register the TCP benchmarks, each core uses a loopback connection and its own port
+BENCHMARK_CAPTURE(BMstartup_connectionStorm, tcpCore, CoreType::TCP)
+    ->RangeMultiplier(4)
+    ->Range(32, 512)
+    ->Iterations(1)
+    ->Unit(benchmark::TimeUnit::kMillisecond)
+    ->UseRealTime();
+
+// Register the TCP SS benchmarks
+BENCHMARK_CAPTURE(BMstartup_connectionStorm, tcpssCore, CoreType::TCP_SS)
+    ->RangeMultiplier(4)
+    ->Range(32, 512)
+    ->Iterations(1)
+    ->Unit(benchmark::TimeUnit::kMillisecond)
+    ->UseRealTime();
+#endif
+
+/** register many interfaces from a federate thread per federate on a single core, then enter
+initializing mode so the registrations are delivered to the core*/
+static void BMstartup_parallelRegistration(benchmark::State& state)
+{
+    const int fedCount = static_cast<int>(state.range(0));
+    const int interfaceCount = static_cast<int>(state.range(1));
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto broker = helics::BrokerFactory::create(CoreType::INPROC,
+                                                    "regbroker",
+                                                    "--log_level=no_print --federates=" +
+                                                        std::to_string(fedCount));
+        auto core = helics::CoreFactory::create(CoreType::INPROC,
+                                                "--log_level=no_print --federates=" +
+                                                    std::to_string(fedCount));
+        helics::FederateInfo fi(CoreType::INPROC);
+        fi.coreName = core->getIdentifier();
+        std::vector<std::unique_ptr<helics::ValueFederate>> feds(fedCount);
+        for (int ii = 0; ii < fedCount; ++ii) {
+            feds[ii] = std::make_unique<helics::ValueFederate>("regfed" + std::to_string(ii), fi);
+        }
+        gmlc::concurrency::Barrier brr(static_cast<size_t>(fedCount) + 1);
+        std::vector<std::thread> threadlist;
+        threadlist.reserve(fedCount);
+        for (int ii = 0; ii < fedCount; ++ii) {
+            threadlist.emplace_back([&, ii]() {
+                auto& fed = *feds[ii];
+                const std::string prefix = "pub" + std::to_string(ii) + '_';
+                brr.wait();
+                for (int jj = 0; jj < interfaceCount; ++jj) {
+                    fed.registerGlobalPublication<double>(prefix + std::to_string(jj));
+                }
+                fed.enterInitializingMode();
+            });
+        }
+        brr.wait();
+        state.ResumeTiming();
+        for (auto& thrd : threadlist) {
+            thrd.join();
+        }
+        state.PauseTiming();
+        for (auto& fed : feds) {
+            fed->finalize();
+        }
+        feds.clear();
+        core.reset();
+        broker->waitForDisconnect();
+        broker.reset();
+        helics::cleanupHelicsLibrary();
+        state.ResumeTiming();
+    }
+    state.counters["federates"] = static_cast<double>(fedCount);
+    state.counters["interfaces"] = static_cast<double>(fedCount) * interfaceCount;
+    state.counters["interface_rate"] =
+        benchmark::Counter(static_cast<double>(fedCount) * interfaceCount,
+                           benchmark::Counter::kIsIterationInvariantRate);
+}
+
+BENCHMARK(BMstartup_parallelRegistration)
+    ->Args({8, 1000})
+    ->Args({8, 5000})
+    ->Args({64, 1000})
+    ->Args({64, 5000})
+    ->Iterations(1)
+    ->Unit(benchmark::TimeUnit::kMillisecond)
+    ->UseRealTime();
+
+HELICS_BENCHMARK_MAIN(startupBenchmark);
@@ -0,0 +1,144 @@
+/*
+Copyright (c) 2017-2021,
+Battelle Memorial Institute; Lawrence Livermore National Security, LLC; Alliance for Sustainable
+Energy, LLC.  See the top-level NOTICE for additional details. All rights reserved.
+SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include "TimeDependencyArrays.hpp"
+#include "helics/core/ActionMessage.hpp"
+#include "helics/core/TimeDependencies.hpp"
+#include "helics_benchmark_main.h"
+
+#include <benchmark/benchmark.h>
+#include <vector>
+
+using namespace helics;  // NOLINT
+
+/** generate the dependencies of a coordinator with all its dependencies requesting times at or
+after 1.0*/
+static TimeDependencies generateDependencies(int count)
+{
+    std::vector<DependencyInfo> deps(count);
+    for (int ii = 0; ii < count; ++ii) {
+        auto& dep = deps[ii];
+        dep.fedID = GlobalFederateId{131072 + ii};
+        dep.dependency = true;
+        dep.dependent = true;
+        dep.connection = ConnectionType::child;
+        dep.time_state = time_state_t::time_requested;
+        dep.next = 1.0 + (ii % 97) * 0.01;
+        dep.Te = 1.5 + (ii % 97) * 0.01;
+        dep.minDe = dep.next;
+    }
+    TimeDependencies dependencies;
+    dependencies.setDependencyVector(deps);
+    return dependencies;
+}
+
+/** check the array layout gives the same results as the dependencies it was loaded from*/
+static bool matchesDependencies(const TimeDependencyArrays& arrays,
+                                const TimeDependencies& dependencies)
+{
+    for (Time grant : {Time(0.5), Time(1.0), Time(1.5), Time(2.0)}) {
+        if (arrays.checkIfReadyForTimeGrant(false, grant) !=
+            dependencies.checkIfReadyForTimeGrant(false, grant)) {
+            return false;
+        }
+    }
+    auto arrayTotal = arrays.generateMinTimeTotal(false, GlobalFederateId{});
+    auto total = generateMinTimeTotal(dependencies, false, GlobalFederateId{});
+    return arrayTotal.next == total.next && arrayTotal.Te == total.Te &&
+        arrayTotal.minDe == total.minDe && arrayTotal.TeAlt == total.TeAlt &&
+        arrayTotal.minFed == total.minFed && arrayTotal.time_state == total.time_state;
+}
+
+static void BMtimeDep_grantCheck(benchmark::State& state)
+{
+    const auto dependencies = generateDependencies(static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(dependencies.checkIfReadyForTimeGrant(false, 1.0));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BMtimeDep_grantCheck)->RangeMultiplier(10)->Range(1000, 100000);
+
+static void BMtimeDep_grantCheckArrays(benchmark::State& state)
+{
+    const auto reference = generateDependencies(static_cast<int>(state.range(0)));
+    const TimeDependencyArrays dependencies(reference);
+    if (!matchesDependencies(dependencies, reference)) {
+        state.SkipWithError("array layout results do not match");
+    }
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(dependencies.checkIfReadyForTimeGrant(false, 1.0));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BMtimeDep_grantCheckArrays)->RangeMultiplier(10)->Range(1000, 100000);
+
+static void BMtimeDep_minTime(benchmark::State& state)
+{
+    const auto dependencies = generateDependencies(static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        auto total = generateMinTimeTotal(dependencies, false, GlobalFederateId{});
+        benchmark::DoNotOptimize(total);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BMtimeDep_minTime)->RangeMultiplier(10)->Range(1000, 100000);
+
+static void BMtimeDep_minTimeArrays(benchmark::State& state)
+{
+    const TimeDependencyArrays dependencies(generateDependencies(static_cast<int>(state.range(0))));
+    for (auto _ : state) {
+        auto total = dependencies.generateMinTimeTotal(false, GlobalFederateId{});
+        benchmark::DoNotOptimize(total);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BMtimeDep_minTimeArrays)->RangeMultiplier(10)->Range(1000, 100000);
+
+/** a time request arriving from one dependency followed by the grant check and minimum time
+computation a coordinator performs on each update*/
+static void BMtimeDep_requestCycle(benchmark::State& state)
+{
+    const int count = static_cast<int>(state.range(0));
+    auto dependencies = generateDependencies(count);
+    ActionMessage req(CMD_TIME_REQUEST);
+    int index{0};
+    for (auto _ : state) {
+        req.source_id = GlobalFederateId{131072 + index};
+        req.actionTime = 1.0 + (index % 97) * 0.01;
+        req.Te = req.actionTime;
+        req.Tdemin = req.actionTime;
+        dependencies.updateTime(req);
+        benchmark::DoNotOptimize(dependencies.checkIfReadyForTimeGrant(false, 1.0));
+        auto total = generateMinTimeTotal(dependencies, false, GlobalFederateId{});
+        benchmark::DoNotOptimize(total);
+        index = (index + 1) % count;
+    }
+}
+BENCHMARK(BMtimeDep_requestCycle)->RangeMultiplier(10)->Range(1000, 100000);
+
+static void BMtimeDep_requestCycleArrays(benchmark::State& state)
+{
+    const int count = static_cast<int>(state.range(0));
+    TimeDependencyArrays dependencies(generateDependencies(count));
+    ActionMessage req(CMD_TIME_REQUEST);
+    int index{0};
+    for (auto _ : state) {
+        req.source_id = GlobalFederateId{131072 + index};
+        req.actionTime = 1.0 + (index % 97) * 0.01;
+        req.Te = req.actionTime;
+        req.Tdemin = req.actionTime;
+        dependencies.updateTime(req);
+        benchmark::DoNotOptimize(dependencies.checkIfReadyForTimeGrant(false, 1.0));
+        auto total = dependencies.generateMinTimeTotal(false, GlobalFederateId{});
+        benchmark::DoNotOptimize(total);
+        index = (index + 1) % count;
+    }
+}
+BENCHMARK(BMtimeDep_requestCycleArrays)->RangeMultiplier(10)->Range(1000, 100000);
+
+HELICS_BENCHMARK_MAIN(timeDependencyBenchmark);
@@ -0,0 +1,380 @@
+/*
+Copyright (c) 2017-2021,
+Battelle Memorial Institute; Lawrence Livermore National Security, LLC; Alliance for Sustainable
+Energy, LLC.  See the top-level NOTICE for additional details. All rights reserved.
+SPDX-License-Identifier: BSD-3-Clause
+*/
+
+/* replay a binary trace captured with --tracefile into a standalone broker or core whose comms
+discard everything sent, so only the command processing is measured.  Set HELICS_BROKER_TRACE or
+HELICS_CORE_TRACE to the location of a captured trace, otherwise a trace is captured from a small
+message exchange federation before running.
+
+The commands before the first request to enter executing mode are replayed before the timing starts
+so the federates and interfaces the timed commands refer to exist in the replaying object.  A broker
+assigns the same ids as the traced broker since it processes the same registrations in the same
+order; a core recreates its federates and interfaces through the Core API and its registrations are
+answered with the acknowledgments recorded in the trace.  The trace records each command as it is
+taken from the queue, so the recorded timestamps are processing times and are not used here.*/
+
+#include "MessageExchangeFederate.hpp"
+#include "helics/core/BrokerFactory.hpp"
+#include "helics/core/CommonCore.hpp"
+#include "helics/core/CoreBroker.hpp"
+#include "helics/core/CoreFactory.hpp"
+#include "helics/core/CoreFederateInfo.hpp"
+#include "helics/core/FederateState.hpp"
+#include "helics/core/MessageTrace.hpp"
+#include "helics/core/flagOperations.hpp"
+#include "helics_benchmark_main.h"
+
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <cstdlib>
+#include <gmlc/concurrency/Barrier.hpp>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using helics::CoreType;
+
+/** a trace split into the commands that set up the federation and the commands that are timed*/
+struct ReplayTrace {
+    std::vector<helics::ActionMessage> setup;  //!< commands before the first exec request
+    std::vector<helics::ActionMessage> timed;  //!< commands from the first exec request onward
+    std::vector<helics::ActionMessage> acks;  //!< registration acknowledgments from the parent
+};
+
+/** core with comms that answer registrations from a trace and discard all other messages*/
+class ReplayCore: public helics::CommonCore {
+  public:
+    ReplayCore(const std::string& coreName, const std::vector<helics::ActionMessage>& acks):
+        CommonCore(coreName)
+    {
+        for (const auto& ack : acks) {
+            if (ack.action() == helics::CMD_BROKER_ACK) {
+                brokerAck = ack;
+                brokerAck.name(coreName);
+            } else if (ack.action() == helics::CMD_FED_ACK) {
+                federateAcks.emplace(std::string(ack.name()), ack);
+            }
+        }
+    }
+    ~ReplayCore() override { joinAllThreads(); }
+    /** recreate the federates and interfaces registered in the setup commands of a trace and
+    queue the remaining setup commands*/
+    void replaySetup(const std::vector<helics::ActionMessage>& setup);
+
+  private:
+    bool brokerConnect() override { return true; }
+    void brokerDisconnect() override {}
+    /** answer a registration sent to the broker with the acknowledgment from the trace*/
+    void answerRegistration(const helics::ActionMessage& command);
+    /** register an interface through the Core API
+    @return false if the interface belongs to a federate that was not recreated*/
+    bool registerTraceInterface(
+        const helics::ActionMessage& command,
+        const std::map<helics::GlobalFederateId, helics::LocalFederateId>& federates);
+
+  protected:
+    void transmit(helics::route_id /*rid*/, const helics::ActionMessage& command) override
+    {
+        answerRegistration(command);
+    }
+    void transmit(helics::route_id /*rid*/, helics::ActionMessage&& command) override
+    {
+        answerRegistration(command);
+    }
+    void addRoute(helics::route_id /*rid*/,
+                  int /*interfaceId*/,
+                  const std::string& /*routeInfo*/) override
+    {
+    }
+    void removeRoute(helics::route_id /*rid*/) override {}
+    std::string generateLocalAddressString() const override { return identifier; }
+
+  private:
+    helics::ActionMessage brokerAck{helics::CMD_IGNORE};
+    std::map<std::string, helics::ActionMessage, std::less<>> federateAcks;
+};
+
+void ReplayCore::answerRegistration(const helics::ActionMessage& command)
+{
+    switch (command.action()) {
+        case helics::CMD_REG_BROKER:
+            if (brokerAck.action() == helics::CMD_BROKER_ACK) {
+                addActionMessage(brokerAck);
+            }
+            break;
+        case helics::CMD_REG_FED: {
+            auto ack = federateAcks.find(command.name());
+            if (ack != federateAcks.end()) {
+                addActionMessage(ack->second);
+            }
+        } break;
+        default:
+            break;
+    }
+}
+
+static bool isInterfaceRegistration(const helics::ActionMessage& command)
+{
+    switch (command.action()) {
+        case helics::CMD_REG_PUB:
+        case helics::CMD_REG_INPUT:
+        case helics::CMD_REG_ENDPOINT:
+        case helics::CMD_REG_FILTER:
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool ReplayCore::registerTraceInterface(
+    const helics::ActionMessage& command,
+    const std::map<helics::GlobalFederateId, helics::LocalFederateId>& federates)
+{
+    const std::string name(command.name());
+    const auto& type = command.getString(helics::typeStringLoc);
+    if (command.action() == helics::CMD_REG_FILTER) {
+        const auto& typeOut = command.getString(helics::typeOutStringLoc);
+        if (checkActionFlag(command, helics::clone_flag)) {
+            registerCloningFilter(name, type, typeOut);
+        } else {
+            registerFilter(name, type, typeOut);
+        }
+        return true;
+    }
+    auto fed = federates.find(command.source_id);
+    if (fed == federates.end()) {
+        return false;
+    }
+    switch (command.action()) {
+        case helics::CMD_REG_PUB:
+            registerPublication(fed->second, name, type, command.getString(helics::unitStringLoc));
+            break;
+        case helics::CMD_REG_INPUT:
+            registerInput(fed->second, name, type, command.getString(helics::unitStringLoc));
+            break;
+        default:
+            if (checkActionFlag(command, helics::targetted_flag)) {
+                registerTargetedEndpoint(fed->second, name, type);
+            } else {
+                registerEndpoint(fed->second, name, type);
+            }
+            break;
+    }
+    // the recreated federates never request initialization so their registrations stay staged
+    for (auto& staged : getFederateAt(fed->second)->takeStagedRegistrations()) {
+        addActionMessage(std::move(staged));
+    }
+    return true;
+}
+
+void ReplayCore::replaySetup(const std::vector<helics::ActionMessage>& setup)
+{
+    std::map<helics::GlobalFederateId, helics::LocalFederateId> federates;
+    std::vector<helics::ActionMessage> interfaces;
+    std::vector<helics::ActionMessage> remaining;
+    for (const auto& cmd : setup) {
+        if (cmd.action() == helics::CMD_REG_FED) {
+            auto local = registerFederate(std::string(cmd.name()), helics::CoreFederateInfo{});
+            auto ack = federateAcks.find(cmd.name());
+            if (ack != federateAcks.end()) {
+                federates.emplace(ack->second.dest_id, local);
+            }
+        } else if (isInterfaceRegistration(cmd)) {
+            interfaces.push_back(cmd);
+        } else if (cmd.action() == helics::CMD_MULTI_MESSAGE &&
+                   checkActionFlag(cmd, helics::packed_messages_flag)) {
+            std::size_t offset{0};
+            helics::ActionMessage extracted;
+            while (helics::extractPackedMessage(cmd, offset, extracted)) {
+                if (isInterfaceRegistration(extracted)) {
+                    interfaces.push_back(extracted);
+                } else {
+                    remaining.push_back(extracted);
+                }
+            }
+        } else if (cmd.action() != helics::CMD_REG_BROKER) {
+            remaining.push_back(cmd);
+        }
+    }
+    // the core numbers handles in the order they are registered so registering in handle order
+    // reproduces the handles used in the trace
+    std::stable_sort(interfaces.begin(), interfaces.end(), [](const auto& a, const auto& b) {
+        return a.source_handle.baseValue() < b.source_handle.baseValue();
+    });
+    for (const auto& cmd : interfaces) {
+        registerTraceInterface(cmd, federates);
+    }
+    for (const auto& cmd : remaining) {
+        addActionMessage(cmd);
+    }
+}
+
+/** broker with comms that discard all outgoing messages*/
+class ReplayBroker: public helics::CoreBroker {
+  public:
+    explicit ReplayBroker(const std::string& brokerName): CoreBroker(brokerName) {}
+    ~ReplayBroker() override { joinAllThreads(); }
+
+  private:
+    bool brokerConnect() override { return true; }
+    void brokerDisconnect() override {}
+
+  protected:
+    void transmit(helics::route_id /*rid*/, const helics::ActionMessage& /*command*/) override {}
+    void transmit(helics::route_id /*rid*/, helics::ActionMessage&& /*command*/) override {}
+    void addRoute(helics::route_id /*rid*/,
+                  int /*interfaceId*/,
+                  const std::string& /*routeInfo*/) override
+    {
+    }
+    void removeRoute(helics::route_id /*rid*/) override {}
+    std::string generateLocalAddressString() const override { return identifier; }
+};
+
+static const std::string defaultBrokerTrace{"bm_replay_broker.trace"};
+static const std::string defaultCoreTrace{"bm_replay_core.trace"};
+
+/** run a small message exchange federation to capture a broker and core trace*/
+static void captureTraces()
+{
+    static bool captured{false};
+    if (captured) {
+        return;
+    }
+    captured = true;
+    const int fed_count = 2;
+    gmlc::concurrency::Barrier brr(static_cast<size_t>(fed_count + 1));
+    auto broker = helics::BrokerFactory::create(CoreType::TEST,
+                                                "tracebroker",
+                                                "--federates=2 --tracefile=" + defaultBrokerTrace);
+    broker->setLoggingLevel(HELICS_LOG_LEVEL_NO_PRINT);
+    std::vector<MessageExchangeFederate> feds(fed_count);
+    std::vector<std::shared_ptr<helics::Core>> cores(fed_count);
+    for (int ii = 0; ii < fed_count; ++ii) {
+        std::string coreInit = "-f 1 --log_level=no_print --broker=tracebroker";
+        if (ii == 0) {
+            coreInit += " --tracefile=" + defaultCoreTrace;
+        }
+        cores[ii] = helics::CoreFactory::create(CoreType::TEST, coreInit);
+        cores[ii]->connect();
+        feds[ii].initialize(cores[ii]->getIdentifier(),
+                            "--index=" + std::to_string(ii) + " --msg_size=100 --msg_count=200");
+    }
+    std::vector<std::thread> threadlist(static_cast<size_t>(fed_count));
+    for (int ii = 0; ii < fed_count; ++ii) {
+        threadlist[ii] = std::thread(
+            [&](MessageExchangeFederate& f) {
+                f.run(
+                    [&brr]() {
+                        brr.wait();
+                        brr.wait();
+                    },
+                    [&brr]() { brr.wait(); });
+            },
+            std::ref(feds[ii]));
+    }
+    brr.wait();
+    brr.wait();
+    brr.wait();
+    for (auto& thrd : threadlist) {
+        thrd.join();
+    }
+    broker->waitForDisconnect();
+    broker.reset();
+    cores.clear();
+    helics::cleanupHelicsLibrary();
+}
+
+static ReplayTrace loadReplay(const char* envName, const std::string& defaultTrace)
+{
+    const char* traceFile = std::getenv(envName);
+    if (traceFile == nullptr) {
+        captureTraces();
+    }
+    auto records = helics::loadMessageTrace((traceFile != nullptr) ? traceFile : defaultTrace);
+    ReplayTrace trace;
+    bool executing{false};
+    for (auto& rec : records) {
+        // ticks are generated by the replaying object and disconnects would stop it early
+        if (rec.command.action() == helics::CMD_TICK || isDisconnectCommand(rec.command)) {
+            continue;
+        }
+        switch (rec.command.action()) {
+            case helics::CMD_BROKER_ACK:
+            case helics::CMD_FED_ACK:
+                trace.acks.push_back(std::move(rec.command));
+                continue;
+            case helics::CMD_EXEC_REQUEST:
+                executing = true;
+                break;
+            default:
+                break;
+        }
+        if (executing) {
+            trace.timed.push_back(std::move(rec.command));
+        } else {
+            trace.setup.push_back(std::move(rec.command));
+        }
+    }
+    return trace;
+}
+
+static void BMreplayBroker(benchmark::State& state)
+{
+    auto trace = loadReplay("HELICS_BROKER_TRACE", defaultBrokerTrace);
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto brk = std::make_unique<ReplayBroker>("replaybroker");
+        brk->configure("--root --log_level=no_print");
+        brk->connect();
+        // the broker assigns the traced ids by processing the registrations in the traced order
+        for (const auto& cmd : trace.setup) {
+            brk->addActionMessage(cmd);
+        }
+        // a query to the broker is answered after everything before it has been processed
+        brk->query("broker", "current_state");
+        state.ResumeTiming();
+        for (const auto& cmd : trace.timed) {
+            brk->addActionMessage(cmd);
+        }
+        brk->query("broker", "current_state");
+        state.PauseTiming();
+        brk->disconnect();
+        brk.reset();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(trace.timed.size()));
+}
+BENCHMARK(BMreplayBroker)->Unit(benchmark::TimeUnit::kMillisecond)->UseRealTime();
+
+static void BMreplayCore(benchmark::State& state)
+{
+    auto trace = loadReplay("HELICS_CORE_TRACE", defaultCoreTrace);
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto core = std::make_unique<ReplayCore>("replaycore", trace.acks);
+        core->configure("--log_level=no_print");
+        core->connect();
+        core->replaySetup(trace.setup);
+        core->query("core", "current_state");
+        state.ResumeTiming();
+        for (const auto& cmd : trace.timed) {
+            core->addActionMessage(cmd);
+        }
+        core->query("core", "current_state");
+        state.PauseTiming();
+        core->disconnect();
+        core.reset();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(trace.timed.size()));
+}
+BENCHMARK(BMreplayCore)->Unit(benchmark::TimeUnit::kMillisecond)->UseRealTime();
+
+HELICS_BENCHMARK_MAIN(traceReplayBenchmark);
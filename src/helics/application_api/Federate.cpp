@@ -200,7 +200,7 @@ Federate::~Federate()
 {
     if (coreObject) {
         try {
-            finalize();
+            finalizeOperations();
         }
         // LCOV_EXCL_START
         catch (...)  // do not allow a throw inside the destructor
@@ -313,6 +313,7 @@ IterationResult Federate::enterExecutingMode(IterationRequest iterate)
             enterInitializingMode();
             [[fallthrough]];
         case Modes::INITIALIZING: {
+            preTimeRequestOperations(timeZero, iterate != IterationRequest::NO_ITERATIONS);
             res = coreObject->enterExecutingMode(fedID, iterate);
             switch (res) {
                 case IterationResult::NEXT_STEP:
@@ -372,6 +373,7 @@ void Federate::enterExecutingModeAsync(IterationRequest iterate)
             enterInitializingModeComplete();
             [[fallthrough]];
         case Modes::INITIALIZING: {
+            preTimeRequestOperations(timeZero, iterate != IterationRequest::NO_ITERATIONS);
             auto eExecFunc = [this, iterate]() {
                 return coreObject->enterExecutingMode(fedID, iterate);
             };
@@ -482,7 +484,15 @@ bool Federate::getFlagOption(int flag) const
     return coreObject->getFlagOption(fedID, flag);
 }
 void Federate::finalize()
-{  // since finalize is called in the destructor we can't allow any potential virtual function calls
+{
+    if (currentMode == Modes::EXECUTING || currentMode == Modes::INITIALIZING) {
+        preFinalizeOperations();
+    }
+    finalizeOperations();
+}
+
+void Federate::finalizeOperations()
+{  // since this is called in the destructor we can't allow any potential virtual function calls
     switch (currentMode) {
         case Modes::STARTUP:
             break;
@@ -551,6 +561,9 @@ void Federate::finalizeAsync()
         default:
             break;
     }
+    if (currentMode == Modes::EXECUTING || currentMode == Modes::INITIALIZING) {
+        preFinalizeOperations();
+    }
     auto finalizeFunc = [this]() { return coreObject->finalize(fedID); };
     auto asyncInfo = asyncCallInfo->lock();
     currentMode = Modes::PENDING_FINALIZE;
@@ -638,6 +651,7 @@ Time Federate::requestTime(Time nextInternalTimeStep)
     switch (currentMode) {
         case Modes::EXECUTING:
             try {
+                preTimeRequestOperations(nextInternalTimeStep, false);
                 auto newTime = coreObject->timeRequest(fedID, nextInternalTimeStep);
                 Time oldTime = currentTime;
                 currentTime = newTime;
@@ -665,6 +679,7 @@ Time Federate::requestTime(Time nextInternalTimeStep)
 iteration_time Federate::requestTimeIterative(Time nextInternalTimeStep, IterationRequest iterate)
 {
     if (currentMode == Modes::EXECUTING) {
+        preTimeRequestOperations(nextInternalTimeStep, iterate != IterationRequest::NO_ITERATIONS);
         auto iterativeTime = coreObject->requestTimeIterative(fedID, nextInternalTimeStep, iterate);
         Time oldTime = currentTime;
         switch (iterativeTime.state) {
@@ -697,6 +712,7 @@ void Federate::requestTimeAsync(Time nextInternalTimeStep)
 {
     auto exp = Modes::EXECUTING;
     if (currentMode.compare_exchange_strong(exp, Modes::PENDING_TIME)) {
+        preTimeRequestOperations(nextInternalTimeStep, false);
         auto asyncInfo = asyncCallInfo->lock();
         asyncInfo->timeRequestFuture =
             std::async(std::launch::async, [this, nextInternalTimeStep]() {
@@ -711,6 +727,7 @@ void Federate::requestTimeIterativeAsync(Time nextInternalTimeStep, IterationReq
 {
     auto exp = Modes::EXECUTING;
     if (currentMode.compare_exchange_strong(exp, Modes::PENDING_ITERATIVE_TIME)) {
+        preTimeRequestOperations(nextInternalTimeStep, iterate != IterationRequest::NO_ITERATIONS);
         auto asyncInfo = asyncCallInfo->lock();
         asyncInfo->timeRequestIterativeFuture =
             std::async(std::launch::async, [this, nextInternalTimeStep, iterate]() {
@@ -775,6 +792,16 @@ void Federate::updateTime(Time /*newTime*/, Time /*oldTime*/)
     // child classes would likely implement this
 }
 
+void Federate::preTimeRequestOperations(Time /*nextStep*/, bool /*iterating*/)
+{
+    // child classes would likely implement this
+}
+
+void Federate::preFinalizeOperations()
+{
+    // child classes may do something with this
+}
+
 void Federate::startupToInitializeStateTransition()
 {
     // child classes may do something with this
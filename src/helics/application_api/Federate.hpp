@@ -531,6 +531,12 @@ received
   protected:
     /** function to deal with any operations that need to occur on a time update*/
     virtual void updateTime(Time newTime, Time oldTime);
+    /** function to deal with any operations that need to occur before a time or mode request is
+    sent to the core*/
+    virtual void preTimeRequestOperations(Time nextStep, bool iterating);
+    /** function to deal with any operations that need to occur before a finalize is sent to the
+    core*/
+    virtual void preFinalizeOperations();
     /** function to deal with any operations that need to occur on the transition from startup to
      * initialize*/
     virtual void startupToInitializeStateTransition();
@@ -609,6 +615,9 @@ received
     void completeOperation();
 
   private:
+    /** finalize the federate without calling any virtual functions so it can be used in the
+     * destructor*/
+    void finalizeOperations();
     /** register filter interfaces defined in  file or string
   @details call is only valid in startup mode
   @param jsonString  the location of the file or config String to load to generate the interfaces
@@ -85,6 +85,10 @@ static const std::unordered_map<std::string, int> propStringsTranslations{
     {"timeoutputdelay", HELICS_PROPERTY_TIME_OUTPUT_DELAY},
     {"time_input_delay", HELICS_PROPERTY_TIME_INPUT_DELAY},
     {"time_output_delay", HELICS_PROPERTY_TIME_OUTPUT_DELAY},
+    {"quantum", HELICS_PROPERTY_TIME_QUANTUM},
+    {"timequantum", HELICS_PROPERTY_TIME_QUANTUM},
+    {"timeQuantum", HELICS_PROPERTY_TIME_QUANTUM},
+    {"time_quantum", HELICS_PROPERTY_TIME_QUANTUM},
     {"loglevel", HELICS_PROPERTY_INT_LOG_LEVEL},
     {"log_level", HELICS_PROPERTY_INT_LOG_LEVEL},
     {"logLevel", HELICS_PROPERTY_INT_LOG_LEVEL},
@@ -108,7 +112,13 @@ static const std::unordered_map<std::string, int> propStringsTranslations{
     {"maxIterations", HELICS_PROPERTY_INT_MAX_ITERATIONS},
     {"intmaxiterations", HELICS_PROPERTY_INT_MAX_ITERATIONS},
     {"intMaxIterations", HELICS_PROPERTY_INT_MAX_ITERATIONS},
-    {"int_max_iterations", HELICS_PROPERTY_INT_MAX_ITERATIONS}};
+    {"int_max_iterations", HELICS_PROPERTY_INT_MAX_ITERATIONS},
+    {"federategroup", HELICS_PROPERTY_INT_FEDERATE_GROUP},
+    {"federate_group", HELICS_PROPERTY_INT_FEDERATE_GROUP},
+    {"federateGroup", HELICS_PROPERTY_INT_FEDERATE_GROUP},
+    {"intfederategroup", HELICS_PROPERTY_INT_FEDERATE_GROUP},
+    {"intFederateGroup", HELICS_PROPERTY_INT_FEDERATE_GROUP},
+    {"int_federate_group", HELICS_PROPERTY_INT_FEDERATE_GROUP}};
 
 static const std::unordered_map<std::string, int> flagStringsTranslations{
     {"source_only", HELICS_FLAG_SOURCE_ONLY},
@@ -125,6 +135,9 @@ static const std::unordered_map<std::string, int> flagStringsTranslations{
     {"debugging", HELICS_FLAG_DEBUGGING},
     {"profiling", HELICS_FLAG_PROFILING},
     {"local_profiling_capture", HELICS_FLAG_LOCAL_PROFILING_CAPTURE},
+    {"ignore_time_quantum", HELICS_FLAG_IGNORE_TIME_QUANTUM},
+    {"ignoretimequantum", HELICS_FLAG_IGNORE_TIME_QUANTUM},
+    {"ignoreTimeQuantum", HELICS_FLAG_IGNORE_TIME_QUANTUM},
     {"only_update_on_change", HELICS_FLAG_ONLY_UPDATE_ON_CHANGE},
     {"onlyupdateonchange", HELICS_FLAG_ONLY_UPDATE_ON_CHANGE},
     {"onlyUpdateOnChange", HELICS_FLAG_ONLY_UPDATE_ON_CHANGE},
@@ -230,6 +243,9 @@ static const std::unordered_map<std::string, int> optionStringsTranslations{
     {"strictinputtypechecking", HELICS_HANDLE_OPTION_STRICT_TYPE_CHECKING},
     {"strictInputTypeChecking", HELICS_HANDLE_OPTION_STRICT_TYPE_CHECKING},
     {"connections", HELICS_HANDLE_OPTION_CONNECTIONS},
+    {"receive_capacity", HELICS_HANDLE_OPTION_RECEIVE_CAPACITY},
+    {"receivecapacity", HELICS_HANDLE_OPTION_RECEIVE_CAPACITY},
+    {"receiveCapacity", HELICS_HANDLE_OPTION_RECEIVE_CAPACITY},
     {"clear_priority_list", HELICS_HANDLE_OPTION_CLEAR_PRIORITY_LIST},
     {"clearPriorityList", HELICS_HANDLE_OPTION_CLEAR_PRIORITY_LIST},
     {"clearprioritylist", HELICS_HANDLE_OPTION_CLEAR_PRIORITY_LIST},
@@ -555,11 +571,22 @@ std::unique_ptr<helicsCLI11App> FederateInfo::makeCLIApp()
            [this](Time val) { setProperty(HELICS_PROPERTY_TIME_OUTPUT_DELAY, val); },
            "the output delay for outgoing communication of the federate (default in ms)")
         ->configurable(false);
+    app->add_option_function<Time>(
+           "--timequantum,--time_quantum",
+           [this](Time val) { setProperty(HELICS_PROPERTY_TIME_QUANTUM, val); },
+           "round the event times of the federate up to a multiple of the quantum so nearby "
+           "events are granted together (default in ms)")
+        ->configurable(false);
     app->add_option_function<int>(
            "--maxiterations",
            [this](int val) { setProperty(HELICS_PROPERTY_INT_MAX_ITERATIONS, val); },
            "the maximum number of iterations a federate is allowed to take")
         ->check(CLI::PositiveNumber);
+    app->add_option_function<int>(
+           "--federategroup",
+           [this](int val) { setProperty(HELICS_PROPERTY_INT_FEDERATE_GROUP, val); },
+           "the federate group of the federate, federates on the same core in the same group exchange values directly")
+        ->check(CLI::NonNegativeNumber);
     app->add_option_function<int>(
            "--loglevel",
            [this](int val) { setProperty(HELICS_PROPERTY_INT_LOG_LEVEL, val); },
@@ -30,7 +30,7 @@ DelayFilterOperation::DelayFilterOperation(Time delayTime): delay(delayTime)
         delay = timeZero;
     }
     td = std::make_shared<MessageTimeOperator>(
-        [this](Time messageTime) { return messageTime + delay; });
+        [this](Time messageTime) { return quantizeTime(messageTime + delay, quantum); });
 }
 
 void DelayFilterOperation::set(const std::string& property, double val)
@@ -39,6 +39,8 @@ void DelayFilterOperation::set(const std::string& property, double val)
         if (val >= timeZero) {
             delay = Time(val);
         }
+    } else if (property == "quantum") {
+        quantum = (val > 0.0) ? Time(val) : timeZero;
     }
 }
 
@@ -51,6 +53,13 @@ void DelayFilterOperation::setString(const std::string& property, const std::str
         catch (const std::invalid_argument&) {
             throw(helics::InvalidParameter(val + " is not a valid time string"));
         }
+    } else if (property == "quantum") {
+        try {
+            quantum = gmlc::utilities::loadTimeFromString<Time>(val);
+        }
+        catch (const std::invalid_argument&) {
+            throw(helics::InvalidParameter(val + " is not a valid time string"));
+        }
     }
 }
 
@@ -209,7 +218,9 @@ class randomDelayGenerator {
 
 RandomDelayFilterOperation::RandomDelayFilterOperation():
     td(std::make_shared<MessageTimeOperator>(
-        [this](Time messageTime) { return messageTime + rdelayGen->generate(); })),
+        [this](Time messageTime) {
+            return quantizeTime(messageTime + rdelayGen->generate(), quantum);
+        })),
     rdelayGen(std::make_unique<randomDelayGenerator>())
 {
 }
@@ -223,6 +234,8 @@ void RandomDelayFilterOperation::set(const std::string& property, double val)
     } else if ((property == "param2") || (property == "stddev") || (property == "max") ||
                (property == "beta")) {
         rdelayGen->param2.store(val);
+    } else if (property == "quantum") {
+        quantum = (val > 0.0) ? Time(val) : timeZero;
     }
 }
 void RandomDelayFilterOperation::setString(const std::string& property, const std::string& val)
@@ -240,6 +253,8 @@ void RandomDelayFilterOperation::setString(const std::string& property, const st
                (property == "beta")) {
         auto tm = gmlc::utilities::loadTimeFromString<Time>(val);
         rdelayGen->param2.store(static_cast<double>(tm));
+    } else if (property == "quantum") {
+        quantum = gmlc::utilities::loadTimeFromString<Time>(val);
     }
 }
 
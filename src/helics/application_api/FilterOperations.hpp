@@ -57,6 +57,7 @@ class FilterOperations {
 class DelayFilterOperation: public FilterOperations {
   private:
     std::atomic<Time> delay{timeZero};
+    std::atomic<Time> quantum{timeZero};  //!< the delayed times are rounded up to a multiple of this
     std::shared_ptr<MessageTimeOperator> td;
 
   public:
@@ -73,6 +74,7 @@ class RandomDelayFilterOperation: public FilterOperations {
   private:
     std::shared_ptr<MessageTimeOperator> td;  //!< pointer to the time operator
     std::unique_ptr<randomDelayGenerator> rdelayGen;  //!< pointer to the random number generator
+    std::atomic<Time> quantum{timeZero};  //!< the delayed times are rounded up to a multiple of this
 
   public:
     /** default constructor*/
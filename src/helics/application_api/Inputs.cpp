@@ -8,6 +8,7 @@ SPDX-License-Identifier: BSD-3-Clause
 #include "Inputs.hpp"
 
 #include "../common/JsonProcessingFunctions.hpp"
+#include "../core/Core.hpp"
 #include "../core/core-exceptions.hpp"
 #include "ValueFederate.hpp"
 #include "units/units/units.hpp"
@@ -546,6 +547,22 @@ bool Input::checkUpdate(bool assumeUpdate)
     return hasUpdate;
 }
 
+void Input::setMinimumChange(double deltaV)
+{
+    // this first check enables change detection if it was disabled via negative delta
+    if (delta < 0.0) {
+        changeDetectionEnabled = true;
+    }
+    delta = deltaV;
+    // the second checks if we should disable from negative delta
+    if (delta < 0.0) {
+        changeDetectionEnabled = false;
+    }
+    if (cr != nullptr) {
+        cr->setInputTolerance(handle, delta);
+    }
+}
+
 void Input::setOption(int32_t option, int32_t value)
 {
     if (option == HELICS_HANDLE_OPTION_MULTI_INPUT_HANDLING_METHOD) {
@@ -633,6 +650,22 @@ data_view Input::getBytes()
     return fed->getBytes(*this);
 }
 
+void Input::setHistory(int32_t valueCount, Time window)
+{
+    if (cr != nullptr) {
+        cr->setInputRetention(handle, valueCount, window);
+    }
+}
+
+data_view Input::getBytesAt(Time valueTime)
+{
+    if (cr == nullptr) {
+        return data_view{};
+    }
+    const auto& data = cr->getValueAt(handle, valueTime);
+    return (data) ? data_view(data) : data_view{};
+}
+
 size_t Input::getStringSize()
 {
     isUpdated();
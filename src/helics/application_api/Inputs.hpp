@@ -273,20 +273,11 @@ class HELICS_CXX_EXPORT Input: public Interface {
 
     void setDefaultBytes(data_view val);
     /** set the minimum delta for change detection
+    @details the delta is also used by the core as the convergence tolerance of the input, so
+    updates within the delta at the granted time do not trigger another iteration
     @param deltaV a double with the change in a value in order to register a different value
     */
-    void setMinimumChange(double deltaV) noexcept
-    {
-        // this first check enables change detection if it was disabled via negative delta
-        if (delta < 0.0) {
-            changeDetectionEnabled = true;
-        }
-        delta = deltaV;
-        // the second checks if we should disable from negative delta
-        if (delta < 0.0) {
-            changeDetectionEnabled = false;
-        }
-    }
+    void setMinimumChange(double deltaV);
     /** enable change detection
     @param enabled (optional) set to false to disable change detection true(default) to enable it
     */
@@ -382,6 +373,25 @@ class HELICS_CXX_EXPORT Input: public Interface {
 
     /** get the raw binary data*/
     data_view getBytes();
+
+    /** keep past values of the input in the core for reads at earlier times
+    @details values are stored once in the core and shared with the reads, a value is kept while it
+    is one of the most recent valueCount values of its source and while it is needed to answer reads
+    within window of the most recent value
+    @param valueCount the number of values to keep for each source, 0 for no count limit
+    @param window the span of time to keep values for, zero for no time limit, if both limits are
+    zero no history is kept
+    */
+    void setHistory(int32_t valueCount, Time window = timeZero);
+    /** get the raw binary data of the retained value in effect at a past time
+    @return an empty data_view if no value at or before the time is retained*/
+    data_view getBytesAt(Time valueTime);
+    /** get the retained value in effect at a past time
+    @details requires history to be enabled with setHistory, if no value at or before the time is
+    retained the invalid value of the type is returned
+    @param valueTime the time of interest, the most recent value at or before it is returned*/
+    template<class X>
+    X getValueAt(Time valueTime);
     /** get the size of the raw data*/
     size_t getByteCount();
     /** get the size of the data if it were a string*/
@@ -422,6 +432,8 @@ class HELICS_CXX_EXPORT Input: public Interface {
     }
     data_view checkAndGetFedUpdate();
     friend class ValueFederateManager;
+    template<class X>
+    friend class InputT;
 };
 
 /** convert a dataview to a double and do a unit conversion if appropriate*/
@@ -436,6 +448,28 @@ HELICS_CXX_EXPORT void
                              const std::shared_ptr<units::precise_unit>& inputUnits,
                              const std::shared_ptr<units::precise_unit>& outputUnits);
 
+template<class X>
+X Input::getValueAt(Time valueTime)
+{
+    static_assert(helicsType<X>() != DataType::HELICS_CUSTOM,
+                  "getValueAt requires a primary helics type");
+    auto out = invalidValue<X>();
+    auto dv = getBytesAt(valueTime);
+    if (dv.empty()) {
+        return out;
+    }
+    if (injectionType == DataType::HELICS_UNKNOWN) {
+        loadSourceInformation();
+    }
+    if (injectionType == DataType::HELICS_DOUBLE) {
+        defV val = doubleExtractAndConvert(dv, inputUnits, outputUnits);
+        valueExtract(val, out);
+    } else {
+        valueExtract(dv, injectionType, out);
+    }
+    return out;
+}
+
 template<class X>
 void Input::getValue_impl(std::integral_constant<int, primaryType> /*V*/, X& out)
 {
@@ -524,4 +558,121 @@ const X& Input::getValueRef()
 
     return getValueRefImpl<remove_cv_ref<X>>(lastValue);
 }
+
+/** an input with a type fixed at compile time
+@details the input is registered with the type of X and values are retrieved directly as X*/
+template<class X>
+class InputT: public Input {
+  public:
+    InputT() = default;
+    /** construct from an existing input*/
+    explicit InputT(const Input& inp): Input(inp) {}
+    /** register an input of type X
+    @param valueFed the ValueFederate to use
+    @param key the name of the input
+    @param units the units associated with the input*/
+    InputT(ValueFederate* valueFed,
+           const std::string& key,
+           const std::string& units = std::string{}):
+        Input(valueFed, key, ValueConverter<X>::type(), units)
+    {
+    }
+    /** register an input of type X
+    @param locality either GLOBAL or LOCAL
+    @param valueFed the ValueFederate to use
+    @param key the name of the input
+    @param units the units associated with the input*/
+    InputT(InterfaceVisibility locality,
+           ValueFederate* valueFed,
+           const std::string& key,
+           const std::string& units = std::string{}):
+        Input(locality, valueFed, key, ValueConverter<X>::type(), units)
+    {
+    }
+    /** get the most recent value*/
+    X getValue() { return Input::getValue<X>(); }
+    /** get the most recent value
+    @param[out] out the location to store the value*/
+    void getValue(X& out) { Input::getValue(out); }
+};
+
+/** a double input that reads double publications without any intermediate conversion
+@details when the connected publication is declared as a double and no unit conversion, change
+detection, or multi-input handling is in use, the value is loaded straight out of the data block.
+Otherwise the general Input conversion is used*/
+template<>
+class InputT<double>: public Input {
+  public:
+    InputT() = default;
+    /** construct from an existing input*/
+    explicit InputT(const Input& inp): Input(inp) { acceptRawEncoding(); }
+    /** register a double input
+    @param valueFed the ValueFederate to use
+    @param key the name of the input
+    @param units the units associated with the input*/
+    InputT(ValueFederate* valueFed,
+           const std::string& key,
+           const std::string& units = std::string{}):
+        Input(valueFed, key, DataType::HELICS_DOUBLE, units)
+    {
+        acceptRawEncoding();
+    }
+    /** register a double input
+    @param locality either GLOBAL or LOCAL
+    @param valueFed the ValueFederate to use
+    @param key the name of the input
+    @param units the units associated with the input*/
+    InputT(InterfaceVisibility locality,
+           ValueFederate* valueFed,
+           const std::string& key,
+           const std::string& units = std::string{}):
+        Input(locality, valueFed, key, DataType::HELICS_DOUBLE, units)
+    {
+        acceptRawEncoding();
+    }
+    /** get the most recent value*/
+    double getValue()
+    {
+        double out;
+        getValue(out);
+        return out;
+    }
+    /** get the most recent value
+    @param[out] out the location to store the value*/
+    void getValue(double& out)
+    {
+        if (injectionType == DataType::HELICS_UNKNOWN) {
+            loadSourceInformation();
+        }
+        if (!directExtraction()) {
+            Input::getValue(out);
+            return;
+        }
+        auto dv = checkAndGetFedUpdate();
+        if (!dv.empty()) {
+            ValueConverter<double>::interpret(dv, out);
+            lastValue = out;
+        } else {
+            valueExtract(lastValue, out);
+        }
+        hasUpdate = false;
+    }
+    /** check if values can be read without going through the general conversion*/
+    bool directExtraction() const
+    {
+        return injectionType == DataType::HELICS_DOUBLE && !changeDetectionEnabled &&
+            inputVectorOp == MultiInputHandlingMethod::NO_OP && !(inputUnits && outputUnits);
+    }
+
+  private:
+    /** tell the connected publications that the raw double encoding can be sent to this input
+    @details every read of a double publication goes through ValueConverter<double> which decodes
+    both forms*/
+    void acceptRawEncoding()
+    {
+        if (isValid()) {
+            setOption(detail::rawDoubleEncodingOption, 1);
+        }
+    }
+};
 }  // namespace helics
@@ -84,6 +84,11 @@ void Publication::publish(double val)
     }
 }
 
+void PublicationT<double>::publishRaw(data_view block)
+{
+    fed->publishBytes(*this, block);
+}
+
 void Publication::publishInt(int64_t val)
 {
     bool doPublish = true;
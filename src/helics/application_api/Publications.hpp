@@ -259,4 +259,89 @@ class HELICS_CXX_EXPORT Publication: public Interface {
     friend class ValueFederateManager;
 };
 
+/** a publication with a type fixed at compile time
+@details the publication is registered with the type of X*/
+template<class X>
+class PublicationT: public Publication {
+  public:
+    PublicationT() = default;
+    /** construct from an existing publication*/
+    explicit PublicationT(const Publication& pub): Publication(pub) {}
+    /** register a publication of type X
+    @param valueFed the ValueFederate to use
+    @param key the name of the publication
+    @param units the units associated with the publication*/
+    PublicationT(ValueFederate* valueFed,
+                 const std::string& key,
+                 const std::string& units = std::string()):
+        Publication(valueFed, key, ValueConverter<X>::type(), units)
+    {
+    }
+    /** register a publication of type X
+    @param locality either GLOBAL or LOCAL
+    @param valueFed the ValueFederate to use
+    @param key the name of the publication
+    @param units the units associated with the publication*/
+    PublicationT(InterfaceVisibility locality,
+                 ValueFederate* valueFed,
+                 const std::string& key,
+                 const std::string& units = std::string()):
+        Publication(locality, valueFed, key, ValueConverter<X>::type(), units)
+    {
+    }
+    /** publish a value*/
+    void publish(const X& val) { Publication::publish(val); }
+};
+
+/** a double publication that sends values in the fixed 8 byte raw double encoding
+@details the raw encoding is a single store with no type conversion.  It is used when the
+publication is declared as a double, so the inputs it connects to are told the publication type and
+decode the raw form.  If change detection is enabled the general conversion is used*/
+template<>
+class HELICS_CXX_EXPORT PublicationT<double>: public Publication {
+  public:
+    PublicationT() = default;
+    /** construct from an existing publication*/
+    explicit PublicationT(const Publication& pub): Publication(pub) {}
+    /** register a double publication
+    @param valueFed the ValueFederate to use
+    @param key the name of the publication
+    @param units the units associated with the publication*/
+    PublicationT(ValueFederate* valueFed,
+                 const std::string& key,
+                 const std::string& units = std::string()):
+        Publication(valueFed, key, DataType::HELICS_DOUBLE, units)
+    {
+    }
+    /** register a double publication
+    @param locality either GLOBAL or LOCAL
+    @param valueFed the ValueFederate to use
+    @param key the name of the publication
+    @param units the units associated with the publication*/
+    PublicationT(InterfaceVisibility locality,
+                 ValueFederate* valueFed,
+                 const std::string& key,
+                 const std::string& units = std::string()):
+        Publication(locality, valueFed, key, DataType::HELICS_DOUBLE, units)
+    {
+    }
+    /** publish a value
+    @details the raw encoding is only sent if every subscriber has accepted it, otherwise the
+    value is sent in the coded form*/
+    void publish(double val)
+    {
+        if (changeDetectionEnabled || pubType != DataType::HELICS_DOUBLE ||
+            getOption(detail::rawDoubleEncodingOption) == 0) {
+            Publication::publish(val);
+            return;
+        }
+        std::byte raw[detail::rawDoubleSize];
+        detail::convertToRawBinary(raw, val);
+        publishRaw(data_view(reinterpret_cast<const char*>(raw), detail::rawDoubleSize));
+    }
+
+  private:
+    void publishRaw(data_view block);
+};
+
 }  // namespace helics
@@ -16,73 +16,8 @@ SPDX-License-Identifier: BSD-3-Clause
 namespace helics {
 
 namespace detail {
-    namespace checks {
-        /*! This code in checks namespace exerpted from cereal portable binary archives
-        code is modified slightly to fit name conventions and make use of C++17
-
-          Copyright (c) 2014, Randolph Voorhies, Shane Grant
-          All rights reserved.
-
-          Redistribution and use in source and binary forms, with or without
-          modification, are permitted provided that the following conditions are met:
-              * Redistributions of source code must retain the above copyright
-                notice, this list of conditions and the following disclaimer.
-              * Redistributions in binary form must reproduce the above copyright
-                notice, this list of conditions and the following disclaimer in the
-                documentation and/or other materials provided with the distribution.
-              * Neither the name of cereal nor the
-                names of its contributors may be used to endorse or promote products
-                derived from this software without specific prior written permission.
-
-          THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
-          ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
-          WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
-          DISCLAIMED. IN NO EVENT SHALL RANDOLPH VOORHIES OR SHANE GRANT BE LIABLE FOR ANY
-          DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
-          (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
-          LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
-          ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
-          (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
-          SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
-        */
-        //! Returns true if the current machine is little endian
-        /*! @ingroup Internal */
-        inline bool isLittleEndian()
-        {
-            static constexpr std::int32_t test{1};
-            return *reinterpret_cast<const char*>(&test) == 1;
-        }
-
-        //! Swaps the order of bytes for some chunk of memory
-        /*! @param data The data as a uint8_t pointer
-            @tparam DataSize The true size of the data
-            @ingroup Internal */
-        template<std::size_t DataSize>
-        inline void swapBytes(std::byte* data)
-        {
-            for (std::size_t i = 0, end = DataSize / 2; i < end; ++i) {
-                std::swap(data[i], data[DataSize - i - 1]);
-            }
-        }
-    }  // namespace checks
-    static constexpr const std::byte doubleCode{0xB0};
-    static constexpr const std::byte intCode{0x50};
-    static constexpr const std::byte complexCode{0x12};
-    static constexpr const std::byte stringCode{0x0E};
-    static constexpr const std::byte vectorCode{0x6C};
-    static constexpr const std::byte npCode{0xAE};
-    static constexpr const std::byte cvCode{0x62};
-    static constexpr const std::byte customCode{0xF4};
-
-    static constexpr std::byte endianMask{0x01};
-    // static constexpr std::byte lowByteMask{0xFF};
-    // static constexpr std::byte codeMask{0xFE};
-
     static const std::byte endianCode = checks::isLittleEndian() ? std::byte{0} : std::byte{1};
 
-    static constexpr const std::byte littleEndianCode{0x0};
-    // static constexpr const std::byte bigEndianCode{0x01};
-
     static inline void addCodeAndSize(std::byte* data, std::byte code, size_t size)
     {
         std::memset(data, 0, 8);
@@ -175,6 +110,22 @@ namespace detail {
             std::to_integer<size_t>(data[7]);
     }
 
+    void convertToRawBinary(std::byte* data, double val)
+    {
+        std::memcpy(data, &val, rawDoubleSize);
+        if (!checks::isLittleEndian()) {
+            checks::swapBytes<rawDoubleSize>(data);
+        }
+    }
+
+    void convertFromRawBinary(const std::byte* data, double& val)
+    {
+        std::memcpy(&val, data, rawDoubleSize);
+        if (!checks::isLittleEndian()) {
+            checks::swapBytes<rawDoubleSize>(reinterpret_cast<std::byte*>(&val));
+        }
+    }
+
     static constexpr const frozen::unordered_map<std::int8_t, helics::DataType, 8> typeDetect{
         {std::to_integer<std::int8_t>(intCode), DataType::HELICS_INT},
         {std::to_integer<std::int8_t>(doubleCode), DataType::HELICS_DOUBLE},
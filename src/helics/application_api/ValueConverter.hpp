@@ -13,6 +13,7 @@ algorithms
 */
 
 #include "../core/SmallBuffer.hpp"
+#include "../core/ValueEncoding.hpp"
 #include "data_view.hpp"
 #include "helicsTypes.hpp"
 #include "helics_cxx_export.h"
@@ -91,6 +92,12 @@ namespace detail {
     @details this returns the number of elements of the specific data type  it is NOT in bytes
     */
     HELICS_CXX_EXPORT size_t getDataSize(const std::byte* data);
+
+    /** store a double in the raw encoding, data must hold rawDoubleSize bytes*/
+    HELICS_CXX_EXPORT void convertToRawBinary(std::byte* data, double val);
+
+    /** load a double from the raw encoding*/
+    HELICS_CXX_EXPORT void convertFromRawBinary(const std::byte* data, double& val);
 }  // namespace detail
 
 /** converter for a basic value*/
@@ -132,13 +139,21 @@ class ValueConverter {
     static X interpret(const data_view& block)
     {
         X val;
-        detail::convertFromBinary(block.bytes(), val);
+        interpret(block, val);
         return val;
     }
 
     /** interpret a view of the data block and store to the specified value*/
     static void interpret(const data_view& block, X& val)
     {
+        if constexpr (std::is_same_v<X, double>) {
+            // the raw encoding is only sent to inputs which negotiated it, a coded double is 16
+            // bytes so it cannot be mistaken for one
+            if (block.size() == detail::rawDoubleSize) {
+                detail::convertFromRawBinary(block.bytes(), val);
+                return;
+            }
+        }
         detail::convertFromBinary(block.bytes(), val);
     }
 
@@ -78,7 +78,19 @@ ValueFederate::ValueFederate(bool /*res*/)
 
 ValueFederate::ValueFederate(ValueFederate&&) noexcept = default;
 
-ValueFederate::~ValueFederate() = default;
+ValueFederate::~ValueFederate()
+{
+    if (vfManager && vfManager->isPublishBatchActive()) {
+        try {
+            vfManager->commitPublishBatch();
+        }
+        // LCOV_EXCL_START
+        catch (...)  // do not allow a throw inside the destructor
+        {
+        }
+        // LCOV_EXCL_STOP
+    }
+}
 
 void ValueFederate::disconnect()
 {
@@ -396,6 +408,21 @@ void ValueFederate::publishBytes(const Publication& pub, data_view block)  // NO
     }
 }
 
+void ValueFederate::beginPublishBatch()
+{
+    if ((currentMode == Modes::EXECUTING) || (currentMode == Modes::INITIALIZING)) {
+        vfManager->beginPublishBatch();
+    } else {
+        throw(InvalidFunctionCall(
+            "publications not allowed outside of execution and initialization state"));
+    }
+}
+
+void ValueFederate::commitPublishBatch()
+{
+    vfManager->commitPublishBatch();
+}
+
 using dvalue = std::variant<double, std::string>;
 
 static void generateData(std::vector<std::pair<std::string, dvalue>>& vpairs,
@@ -486,6 +513,22 @@ void ValueFederate::updateTime(Time newTime, Time oldTime)
     vfManager->updateTime(newTime, oldTime);
 }
 
+void ValueFederate::preTimeRequestOperations(Time /*nextStep*/, bool /*iterating*/)
+{
+    // a batch is scoped to a single time step
+    if (vfManager->isPublishBatchActive()) {
+        vfManager->commitPublishBatch();
+    }
+}
+
+void ValueFederate::preFinalizeOperations()
+{
+    // publications staged in an open batch are sent before the federate finalizes
+    if (vfManager->isPublishBatchActive()) {
+        vfManager->commitPublishBatch();
+    }
+}
+
 void ValueFederate::startupToInitializeStateTransition()
 {
     vfManager->startupToInitializeStateTransition();
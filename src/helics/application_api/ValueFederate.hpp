@@ -348,6 +348,14 @@ class HELICS_CXX_EXPORT ValueFederate:
         publishBytes(pub, data_view{data, data_size});
     }
 
+    /** start a batch of publications
+    @details publications made after this call are staged in the federate and sent to the core
+    together when commitPublishBatch is called or the next time or mode request is made*/
+    void beginPublishBatch();
+    /** send all the publications staged since beginPublishBatch to the core and end the batch
+    @details an open batch is also sent by finalize, finalizeAsync, and disconnect*/
+    void commitPublishBatch();
+
     /** register a set of publications based on a publication JSON
     @param jsonString a json string containing the data to publish and establish publications from
     */
@@ -421,6 +429,8 @@ class HELICS_CXX_EXPORT ValueFederate:
 
   protected:
     virtual void updateTime(Time newTime, Time oldTime) override;
+    virtual void preTimeRequestOperations(Time nextStep, bool iterating) override;
+    virtual void preFinalizeOperations() override;
     virtual void startupToInitializeStateTransition() override;
     virtual void initializeToExecuteStateTransition(IterationResult result) override;
     virtual std::string localQuery(const std::string& queryStr) const override;
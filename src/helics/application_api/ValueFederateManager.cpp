@@ -215,9 +215,42 @@ inline bool isBlockSizeValid(int size, const publication_info& pubI)
 
 void ValueFederateManager::publish(const Publication& pub, const data_view& block)
 {
+    if (batchActive.load()) {
+        auto batch = publishBatch.lock();
+        // check again under the lock in case the batch was committed in the meantime
+        if (batchActive.load()) {
+            batch->emplace_back(pub.handle, SmallBuffer(block.data(), block.size()));
+            return;
+        }
+    }
     coreObject->setValue(pub.handle, block.data(), block.size());
 }
 
+void ValueFederateManager::beginPublishBatch()
+{
+    batchActive.store(true);
+}
+
+void ValueFederateManager::commitPublishBatch()
+{
+    std::vector<std::pair<InterfaceHandle, SmallBuffer>> values;
+    {
+        auto batch = publishBatch.lock();
+        batchActive.store(false);
+        values.swap(*batch);
+    }
+    if (values.empty()) {
+        return;
+    }
+    coreObject->setValues(fedID, values);
+    // hand the storage back so the next batch does not need to reallocate
+    values.clear();
+    auto batch = publishBatch.lock();
+    if (batch->empty()) {
+        batch->swap(values);
+    }
+}
+
 bool ValueFederateManager::hasUpdate(const Input& inp)
 {
     auto* iData = static_cast<input_info*>(inp.dataReference);
@@ -239,30 +272,33 @@ Time ValueFederateManager::getLastUpdateTime(const Input& inp)
 void ValueFederateManager::updateTime(Time newTime, Time /*oldTime*/)
 {
     CurrentTime = newTime;
-    auto handles = coreObject->getValueUpdates(fedID);
-    if (handles.empty()) {
+    // the values were captured by the core at the grant so no further core calls are needed
+    const auto& updates = coreObject->getValueSnapshot(fedID);
+    if (updates.empty()) {
         return;
     }
     // lock the data updates
     auto inpHandle = inputs.lock();
     auto allCall = allCallback.load();
-    for (auto handle : handles) {
+    for (const auto& update : updates) {
         /** find the id*/
-        auto fid = inpHandle->find(handle);
+        auto fid = inpHandle->find(update.handle);
         if (fid != inpHandle->end()) {  // assign the data
             auto* iData = static_cast<input_info*>(fid->dataReference);
             iData->lastUpdate = CurrentTime;
 
             bool updated = false;
             if (fid->getMultiInputMode() == MultiInputHandlingMethod::NO_OP) {
-                const auto& data = coreObject->getValue(handle);
-                iData->lastData = data;
+                iData->lastData = update.data;
                 iData->hasUpdate = true;
                 updated = fid->checkUpdate(true);
             } else {
-                const auto& dataV = coreObject->getAllValues(handle);
                 iData->hasUpdate = false;
-                updated = fid->vectorDataProcess(dataV);
+                if (update.allData.empty()) {
+                    updated = fid->vectorDataProcess({update.data});
+                } else {
+                    updated = fid->vectorDataProcess(update.allData);
+                }
             }
 
             if (updated) {
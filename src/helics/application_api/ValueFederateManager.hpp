@@ -8,15 +8,18 @@ SPDX-License-Identifier: BSD-3-Clause
 
 #include "../common/GuardedTypes.hpp"
 #include "../core/LocalFederateId.hpp"
+#include "../core/SmallBuffer.hpp"
 #include "Inputs.hpp"
 #include "ValueFederate.hpp"
 #include "data_view.hpp"
 #include "gmlc/containers/DualMappedVector.hpp"
 #include "helicsTypes.hpp"
 
+#include <atomic>
 #include <map>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace helics {
@@ -127,6 +130,12 @@ class ValueFederateManager {
 
     /** publish a value*/
     void publish(const Publication& pub, const data_view& block);
+    /** start staging publications instead of sending them to the core*/
+    void beginPublishBatch();
+    /** send the staged publications to the core in a single operation and stop staging*/
+    void commitPublishBatch();
+    /** check if publications are currently being staged*/
+    bool isPublishBatchActive() const { return batchActive.load(); }
 
     /** check if a given subscription has and update*/
     static bool hasUpdate(const Input& inp);
@@ -218,6 +227,9 @@ class ValueFederateManager {
         publications;
     Time CurrentTime{-1.0};  //!< the current simulation time
     Core* coreObject;  //!< the pointer to the actual core
+    std::atomic<bool> batchActive{false};  //!< indicator that publications are being staged
+    /// the publications staged since beginPublishBatch
+    guarded<std::vector<std::pair<InterfaceHandle, SmallBuffer>>> publishBatch;
     /** pointer back to the value Federate for creation of the Publication/Inputs */
     ValueFederate* fed{nullptr};
     atomic_guarded<std::function<void(Input&, Time)>>
@@ -340,6 +340,13 @@ namespace apps {
             vStat[val.second].key = val.first;
         }
 
+        fed->setQueryCallback([bytes = capturedBytes](std::string_view query) -> std::string {
+            if (query != "memory") {
+                return std::string{};
+            }
+            // only the atomic byte count is safe to read from the core thread
+            return fmt::format(R"({{"recorder_bytes":{}}})", bytes->load());
+        });
         fed->enterInitializingMode();
         captureForCurrentTime(-1.0);
 
@@ -377,6 +384,12 @@ namespace apps {
         }
     }
 
+    static std::uint64_t messageBytes(const Message& mess)
+    {
+        return sizeof(Message) + mess.data.size() + mess.source.size() + mess.dest.size() +
+            mess.original_source.size() + mess.original_dest.size();
+    }
+
     void Recorder::captureForCurrentTime(Time currentTime, int iteration)
     {
         for (auto& sub : subscriptions) {
@@ -384,6 +397,7 @@ namespace apps {
                 auto val = sub.getValue<std::string>();
                 int ii = subids[sub.getHandle()];
                 points.emplace_back(currentTime, ii, val);
+                *capturedBytes += sizeof(ValueCapture) + val.size();
                 if (iteration > 0) {
                     points.back().iteration = iteration;
                 }
@@ -442,13 +456,16 @@ namespace apps {
                     }
                     spdlog::info(messstr);
                 }
+                *capturedBytes += messageBytes(*mess);
                 messages.push_back(std::move(mess));
             }
         }
         // get the clone endpoints
         if (cloneEndpoint) {
             while (cloneEndpoint->hasMessage()) {
-                messages.push_back(cloneEndpoint->getMessage());
+                auto mess = cloneEndpoint->getMessage();
+                *capturedBytes += messageBytes(*mess);
+                messages.push_back(std::move(mess));
             }
         }
     }
@@ -10,6 +10,8 @@ SPDX-License-Identifier: BSD-3-Clause
 #include "../application_api/Subscriptions.hpp"
 #include "helicsApp.hpp"
 
+#include <atomic>
+#include <cstdint>
 #include <map>
 #include <memory>
 #include <set>
@@ -84,6 +86,8 @@ namespace apps {
         auto pointCount() const { return points.size(); }
         /** get the number of captured messages*/
         auto messageCount() const { return messages.size(); }
+        /** get an estimate of the number of bytes held by the captured points and messages*/
+        std::uint64_t memoryUsage() const { return capturedBytes->load(); }
         /** get a string with the value of point index
     @param index the number of the point to retrieve
     @return a tuple with Time as the first element the tag as the 2nd element and the value as the
@@ -154,6 +158,9 @@ namespace apps {
         std::vector<Endpoint> endpoints;  //!< the actual endpoint objects
         std::unique_ptr<Endpoint> cloneEndpoint;  //!< the endpoint for cloned message delivery
         std::vector<std::unique_ptr<Message>> messages;  //!< list of messages
+        /// running estimate of the captured bytes, shared with the query callback
+        std::shared_ptr<std::atomic<std::uint64_t>> capturedBytes{
+            std::make_shared<std::atomic<std::uint64_t>>(0)};
         std::map<helics::InterfaceHandle, int> subids;  //!< map of the subscription ids
         std::map<std::string, int> subkeys;  //!< translate subscription names to an index
         std::map<helics::InterfaceHandle, int> eptids;  // translate subscription id to index
@@ -31,6 +31,7 @@ SPDX-License-Identifier: BSD-3-Clause
 
 #include <algorithm>
 #include <boost/asio/dispatch.hpp>
+#include <boost/asio/post.hpp>
 #include <boost/asio/strand.hpp>
 #include <boost/beast/core.hpp>
 #include <boost/beast/http.hpp>
@@ -42,6 +43,7 @@ SPDX-License-Identifier: BSD-3-Clause
 #include <boost/uuid/uuid_generators.hpp>  // generators
 #include <boost/uuid/uuid_io.hpp>  // streaming operators etc.
 #include <cstdlib>
+#include <deque>
 #include <fstream>
 #include <functional>
 #include <iostream>
@@ -458,15 +460,18 @@ static void fail(beast::error_code ec, char const* what)
 
 // LCOV_EXCL_STOP
 
-// Echoes back all received WebSocket messages
+// Processes requests received over a websocket and pushes graph subscription updates
 class WebSocketsession: public std::enable_shared_from_this<WebSocketsession> {
     websocket::stream<beast::tcp_stream> ws;
     beast::flat_buffer buffer;
+    std::deque<std::string> pendingWrites;  //!< responses and updates waiting to be written
+    /// the brokers and ids of the graph subscriptions made through the session
+    std::vector<std::pair<std::shared_ptr<helics::Broker>, std::int32_t>> subscriptions;
 
   public:
     // Take ownership of the socket
     explicit WebSocketsession(tcp::socket&& socket): ws(std::move(socket)) {}
-
+    ~WebSocketsession() { clearSubscriptions(); }
     // Get on the correct executor
     void run()
     {
@@ -516,30 +521,36 @@ class WebSocketsession: public std::enable_shared_from_this<WebSocketsession> {
 
         // This indicates that the session was closed
         if (ec == websocket::error::closed) {
+            clearSubscriptions();
             return;
         }
 
         if (ec) {
+            clearSubscriptions();
             return fail(ec, "helics web server read");
         }
 
         beast::string_view result{boost::asio::buffer_cast<const char*>(buffer.data()),
                                   buffer.size()};
-        // Echo the message
         auto reqpr = processRequestParameters("", result);
+        // Clear the buffer
+        buffer.consume(buffer.size());
+
+        auto cmdfield = reqpr.second.find("command");
+        if (cmdfield != reqpr.second.end() &&
+            (cmdfield->second == "subscribe" || cmdfield->second == "unsubscribe")) {
+            queueWrite(processSubscription(cmdfield->second, reqpr.second));
+            do_read();
+            return;
+        }
 
         cmd command{cmd::unknown};
 
         auto res = generateResults(command, {}, "", "", reqpr.second);
-        // Clear the buffer
-        buffer.consume(buffer.size());
 
-        ws.text(true);
         if (res.first == return_val::ok && !res.second.empty() && res.second.front() == '{') {
-            boost::beast::ostream(buffer) << res.second;  // NOLINT
-            ws.async_write(buffer.data(),
-                           beast::bind_front_handler(&WebSocketsession::on_write,
-                                                     shared_from_this()));
+            queueWrite(std::move(res.second));
+            do_read();
             return;
         }
         Json::Value response;
@@ -562,8 +573,23 @@ class WebSocketsession: public std::enable_shared_from_this<WebSocketsession> {
                 break;
         }
 
-        boost::beast::ostream(buffer) << helics::fileops::generateJsonString(response);  // NOLINT
-        ws.async_write(buffer.data(),
+        queueWrite(helics::fileops::generateJsonString(response));
+        do_read();
+    }
+
+    /** queue a message to write, must be called from the session strand*/
+    void queueWrite(std::string message)
+    {
+        pendingWrites.push_back(std::move(message));
+        if (pendingWrites.size() == 1) {
+            do_write();
+        }
+    }
+
+    void do_write()
+    {
+        ws.text(true);
+        ws.async_write(net::buffer(pendingWrites.front()),
                        beast::bind_front_handler(&WebSocketsession::on_write, shared_from_this()));
     }
 
@@ -574,12 +600,75 @@ class WebSocketsession: public std::enable_shared_from_this<WebSocketsession> {
         if (ec) {
             return fail(ec, "helics socket write");
         }
+        pendingWrites.pop_front();
+        if (!pendingWrites.empty()) {
+            do_write();
+        }
+    }
 
-        // Clear the buffer
-        buffer.consume(buffer.size());
+  private:
+    /** subscribe to or unsubscribe from the changes of a graph query
+    @details the updates are generated on the broker thread and posted to the session strand*/
+    std::string
+        processSubscription(const std::string& command,
+                            const boost::container::flat_map<std::string, std::string>& fields)
+    {
+        Json::Value response;
+        std::shared_ptr<helics::Broker> brkr;
+        auto brokerField = fields.find("broker");
+        if (brokerField != fields.end()) {
+            brkr = helics::BrokerFactory::findBroker(brokerField->second);
+        } else {
+            brkr = helics::BrokerFactory::getConnectedBroker();
+        }
+        if (command == "unsubscribe") {
+            auto idField = fields.find("subscription");
+            auto subId = (idField != fields.end()) ? std::atoi(idField->second.c_str()) : -1;
+            auto sub = subscriptions.begin();
+            while (sub != subscriptions.end()) {
+                if ((!brkr || sub->first == brkr) && (subId < 0 || sub->second == subId)) {
+                    sub->first->unsubscribeFromGraph(sub->second);
+                    sub = subscriptions.erase(sub);
+                } else {
+                    ++sub;
+                }
+            }
+            response["status"] = 0;
+            return helics::fileops::generateJsonString(response);
+        }
+        if (!brkr) {
+            response["status"] = static_cast<int>(http::status::not_found);
+            response["error"] = "unable to locate broker";
+            return helics::fileops::generateJsonString(response);
+        }
+        auto queryField = fields.find("query");
+        const std::string graph = (queryField != fields.end()) ? queryField->second : std::string{};
+        std::weak_ptr<WebSocketsession> session = weak_from_this();
+        auto executor = ws.get_executor();
+        auto subId = brkr->subscribeToGraph(graph, [session, executor](std::string_view update) {
+            net::post(executor, [session, message = std::string(update)]() mutable {
+                if (auto active = session.lock()) {
+                    active->queueWrite(std::move(message));
+                }
+            });
+        });
+        if (subId < 0) {
+            response["status"] = static_cast<int>(http::status::bad_request);
+            response["error"] = graph + " does not support subscriptions";
+            return helics::fileops::generateJsonString(response);
+        }
+        subscriptions.emplace_back(std::move(brkr), subId);
+        response["status"] = 0;
+        response["subscription"] = subId;
+        return helics::fileops::generateJsonString(response);
+    }
 
-        // Do another read
-        do_read();
+    void clearSubscriptions()
+    {
+        for (auto& sub : subscriptions) {
+            sub.first->unsubscribeFromGraph(sub.second);
+        }
+        subscriptions.clear();
     }
 };
 
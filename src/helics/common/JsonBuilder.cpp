@@ -87,6 +87,11 @@ std::string JsonMapBuilder::generate()
     return "{}";
 }
 
+std::string JsonMapBuilder::generateBinary()
+{
+    return generateBinaryJson((jMap) ? *jMap : Json::Value(Json::objectValue));
+}
+
 void JsonMapBuilder::reset()
 {
     jMap = nullptr;
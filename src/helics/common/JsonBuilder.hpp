@@ -50,6 +50,8 @@ class JsonMapBuilder {
     bool clearComponents();
     /** generate the JSON value*/
     std::string generate();
+    /** generate the value in the binary transport encoding for passing to another broker*/
+    std::string generateBinary();
     /** reset the builder*/
     void reset();
     /** set the counter code value*/
@@ -10,9 +10,13 @@ SPDX-License-Identifier: BSD-3-Clause
 #include "../core/helicsTime.hpp"
 #include "../utilities/timeStringOps.hpp"
 
+#include <cstdint>
+#include <cstring>
 #include <fstream>
+#include <limits>
 #include <memory>
 #include <sstream>
+#include <stdexcept>
 #include <string>
 
 namespace helics::fileops {
@@ -51,6 +55,9 @@ Json::Value loadJson(const std::string& jsonString)
 
 Json::Value loadJsonStr(std::string_view jsonString)
 {
+    if (isBinaryJson(jsonString)) {
+        return loadBinaryJson(jsonString);
+    }
     Json::Value doc;
     Json::CharReaderBuilder rbuilder;
     std::string errs;
@@ -108,4 +115,256 @@ std::string generateJsonString(const Json::Value& block)
     return ret;
 }
 
+// CBOR major types and simple values used in the binary encoding
+static constexpr std::uint8_t cborUnsigned{0U};
+static constexpr std::uint8_t cborNegative{1U};
+static constexpr std::uint8_t cborText{3U};
+static constexpr std::uint8_t cborArray{4U};
+static constexpr std::uint8_t cborMap{5U};
+static constexpr std::uint8_t cborFalse{0xF4U};
+static constexpr std::uint8_t cborTrue{0xF5U};
+static constexpr std::uint8_t cborNull{0xF6U};
+static constexpr std::uint8_t cborDouble{0xFBU};
+/// the CBOR self describe tag (55799) used as a marker for binary documents
+static constexpr char binaryJsonMarker[3] = {'\xD9', '\xD9', '\xF7'};
+/// limit on the nesting depth accepted by the decoder
+static constexpr int maxBinaryJsonDepth{256};
+
+static void appendBigEndian(std::string& out, std::uint64_t val, int bytes)
+{
+    for (int ii = bytes - 1; ii >= 0; --ii) {
+        out.push_back(static_cast<char>((val >> (8 * ii)) & 0xFFU));
+    }
+}
+
+static void appendHead(std::string& out, std::uint8_t major, std::uint64_t val)
+{
+    const auto mt = static_cast<std::uint8_t>(major << 5U);
+    if (val < 24U) {
+        out.push_back(static_cast<char>(mt | static_cast<std::uint8_t>(val)));
+    } else if (val <= 0xFFU) {
+        out.push_back(static_cast<char>(mt | 24U));
+        appendBigEndian(out, val, 1);
+    } else if (val <= 0xFFFFU) {
+        out.push_back(static_cast<char>(mt | 25U));
+        appendBigEndian(out, val, 2);
+    } else if (val <= 0xFFFFFFFFU) {
+        out.push_back(static_cast<char>(mt | 26U));
+        appendBigEndian(out, val, 4);
+    } else {
+        out.push_back(static_cast<char>(mt | 27U));
+        appendBigEndian(out, val, 8);
+    }
+}
+
+static void appendText(std::string& out, const char* str, std::size_t len)
+{
+    appendHead(out, cborText, len);
+    out.append(str, len);
+}
+
+static void encodeBinaryJson(std::string& out, const Json::Value& val)
+{
+    switch (val.type()) {
+        case Json::nullValue:
+        default:
+            out.push_back(static_cast<char>(cborNull));
+            break;
+        case Json::booleanValue:
+            out.push_back(static_cast<char>(val.asBool() ? cborTrue : cborFalse));
+            break;
+        case Json::intValue: {
+            auto ival = val.asInt64();
+            if (ival >= 0) {
+                appendHead(out, cborUnsigned, static_cast<std::uint64_t>(ival));
+            } else {
+                appendHead(out, cborNegative, static_cast<std::uint64_t>(-(ival + 1)));
+            }
+        } break;
+        case Json::uintValue:
+            appendHead(out, cborUnsigned, val.asUInt64());
+            break;
+        case Json::realValue: {
+            double dval = val.asDouble();
+            std::uint64_t bits{0};
+            std::memcpy(&bits, &dval, sizeof(double));
+            out.push_back(static_cast<char>(cborDouble));
+            appendBigEndian(out, bits, 8);
+        } break;
+        case Json::stringValue: {
+            const char* begin{nullptr};
+            const char* end{nullptr};
+            val.getString(&begin, &end);
+            appendText(out, begin, static_cast<std::size_t>(end - begin));
+        } break;
+        case Json::arrayValue:
+            appendHead(out, cborArray, val.size());
+            for (const auto& element : val) {
+                encodeBinaryJson(out, element);
+            }
+            break;
+        case Json::objectValue:
+            appendHead(out, cborMap, val.size());
+            for (auto it = val.begin(); it != val.end(); ++it) {
+                const char* end{nullptr};
+                const char* begin = it.memberName(&end);
+                appendText(out, begin, static_cast<std::size_t>(end - begin));
+                encodeBinaryJson(out, *it);
+            }
+            break;
+    }
+}
+
+std::string generateBinaryJson(const Json::Value& block)
+{
+    std::string out(binaryJsonMarker, sizeof(binaryJsonMarker));
+    encodeBinaryJson(out, block);
+    return out;
+}
+
+bool isBinaryJson(std::string_view data)
+{
+    return data.size() > sizeof(binaryJsonMarker) &&
+        data.compare(0, sizeof(binaryJsonMarker), binaryJsonMarker, sizeof(binaryJsonMarker)) == 0;
+}
+
+namespace {
+    /** helper class for decoding a binary json document*/
+    class BinaryJsonDecoder {
+      public:
+        explicit BinaryJsonDecoder(std::string_view data): mData(data) {}
+        Json::Value decode(int depth)
+        {
+            if (depth > maxBinaryJsonDepth) {
+                throw(std::invalid_argument("binary json nesting is too deep"));
+            }
+            auto initial = readByte();
+            const std::uint8_t major = initial >> 5U;
+            switch (initial) {
+                case cborFalse:
+                    return Json::Value(false);
+                case cborTrue:
+                    return Json::Value(true);
+                case cborNull:
+                    return Json::Value();
+                case cborDouble: {
+                    auto bits = readBigEndian(8);
+                    double dval{0.0};
+                    std::memcpy(&dval, &bits, sizeof(double));
+                    return Json::Value(dval);
+                }
+                default:
+                    break;
+            }
+            auto arg = readArgument(initial & 0x1FU);
+            switch (major) {
+                case cborUnsigned:
+                    if (arg <= static_cast<std::uint64_t>(std::numeric_limits<Json::Int64>::max())) {
+                        return Json::Value(static_cast<Json::Int64>(arg));
+                    }
+                    return Json::Value(static_cast<Json::UInt64>(arg));
+                case cborNegative:
+                    if (arg > static_cast<std::uint64_t>(std::numeric_limits<Json::Int64>::max())) {
+                        throw(std::invalid_argument("binary json integer out of range"));
+                    }
+                    return Json::Value(-static_cast<Json::Int64>(arg) - 1);
+                case cborText:
+                    return Json::Value(readText(arg));
+                case cborArray: {
+                    checkCount(arg);
+                    Json::Value arr(Json::arrayValue);
+                    for (std::uint64_t ii = 0; ii < arg; ++ii) {
+                        arr.append(decode(depth + 1));
+                    }
+                    return arr;
+                }
+                case cborMap: {
+                    checkCount(arg);
+                    Json::Value obj(Json::objectValue);
+                    for (std::uint64_t ii = 0; ii < arg; ++ii) {
+                        auto keyHead = readByte();
+                        if ((keyHead >> 5U) != cborText) {
+                            throw(std::invalid_argument("binary json map key is not a string"));
+                        }
+                        auto key = readText(readArgument(keyHead & 0x1FU));
+                        obj[key] = decode(depth + 1);
+                    }
+                    return obj;
+                }
+                default:
+                    throw(std::invalid_argument("unsupported binary json element"));
+            }
+        }
+        bool complete() const { return mLoc == mData.size(); }
+
+      private:
+        std::uint8_t readByte()
+        {
+            if (mLoc >= mData.size()) {
+                throw(std::invalid_argument("binary json document is truncated"));
+            }
+            return static_cast<std::uint8_t>(mData[mLoc++]);
+        }
+        std::uint64_t readBigEndian(int bytes)
+        {
+            std::uint64_t val{0};
+            for (int ii = 0; ii < bytes; ++ii) {
+                val = (val << 8U) | readByte();
+            }
+            return val;
+        }
+        std::uint64_t readArgument(std::uint8_t info)
+        {
+            if (info < 24U) {
+                return info;
+            }
+            switch (info) {
+                case 24U:
+                    return readBigEndian(1);
+                case 25U:
+                    return readBigEndian(2);
+                case 26U:
+                    return readBigEndian(4);
+                case 27U:
+                    return readBigEndian(8);
+                default:
+                    throw(std::invalid_argument("invalid binary json length code"));
+            }
+        }
+        std::string readText(std::uint64_t len)
+        {
+            if (len > mData.size() - mLoc) {
+                throw(std::invalid_argument("binary json string exceeds document size"));
+            }
+            std::string str(mData.substr(mLoc, static_cast<std::size_t>(len)));
+            mLoc += static_cast<std::size_t>(len);
+            return str;
+        }
+        /** every element takes at least one byte so counts larger than the remaining data are
+         * invalid*/
+        void checkCount(std::uint64_t count) const
+        {
+            if (count > mData.size() - mLoc) {
+                throw(std::invalid_argument("binary json element count exceeds document size"));
+            }
+        }
+        std::string_view mData;
+        std::size_t mLoc{0};
+    };
+}  // namespace
+
+Json::Value loadBinaryJson(std::string_view data)
+{
+    if (!isBinaryJson(data)) {
+        throw(std::invalid_argument("data is not a binary json document"));
+    }
+    data.remove_prefix(sizeof(binaryJsonMarker));
+    BinaryJsonDecoder decoder(data);
+    auto val = decoder.decode(0);
+    if (!decoder.complete()) {
+        throw(std::invalid_argument("unexpected data after binary json document"));
+    }
+    return val;
+}
+
 }  // namespace helics::fileops
@@ -27,6 +27,7 @@ JSON::Value to the root object
 Json::Value loadJson(const std::string& jsonString);
 
 /** load a JSON object in a string
+@details the string may also contain a binary encoded document generated by generateBinaryJson
  */
 Json::Value loadJsonStr(std::string_view jsonString);
 
@@ -40,6 +41,19 @@ std::string getName(const Json::Value& element);
 /** generate a Json String*/
 std::string generateJsonString(const Json::Value& block);
 
+/** generate a compact binary encoding of a Json value
+@details the encoding is a subset of CBOR (RFC 8949) prefixed with the CBOR self describe tag, it is
+intended for transport of query results between cores and brokers and is converted back to JSON text
+before being handed to a user*/
+std::string generateBinaryJson(const Json::Value& block);
+
+/** load a Json value from a binary encoded document
+@throw std::invalid_argument if the data is not a valid binary encoded document*/
+Json::Value loadBinaryJson(std::string_view data);
+
+/** check if a string contains a binary encoded JSON document*/
+bool isBinaryJson(std::string_view data);
+
 inline std::string JsonAsString(const Json::Value& element)
 {
     return (element.isString()) ? element.asString() : generateJsonString(element);
@@ -44,8 +44,8 @@ ActionMessage::ActionMessage(ActionMessage&& act) noexcept:
     messageAction(act.messageAction), messageID(act.messageID), source_id(act.source_id),
     source_handle(act.source_handle), dest_id(act.dest_id), dest_handle(act.dest_handle),
     counter(act.counter), flags(act.flags), sequenceID(act.sequenceID), actionTime(act.actionTime),
-    Te(act.Te), Tdemin(act.Tdemin), Tso(act.Tso), payload(std::move(act.payload)),
-    stringData(std::move(act.stringData))
+    Te(act.Te), Tdemin(act.Tdemin), Tso(act.Tso), enqueueTime(act.enqueueTime),
+    payload(std::move(act.payload)), stringData(std::move(act.stringData))
 {
 }
 
@@ -53,7 +53,8 @@ ActionMessage::ActionMessage(const ActionMessage& act):
     messageAction(act.messageAction), messageID(act.messageID), source_id(act.source_id),
     source_handle(act.source_handle), dest_id(act.dest_id), dest_handle(act.dest_handle),
     counter(act.counter), flags(act.flags), sequenceID(act.sequenceID), actionTime(act.actionTime),
-    Te(act.Te), Tdemin(act.Tdemin), Tso(act.Tso), payload(act.payload), stringData(act.stringData)
+    Te(act.Te), Tdemin(act.Tdemin), Tso(act.Tso), enqueueTime(act.enqueueTime), payload(act.payload),
+    stringData(act.stringData)
 
 {
 }
@@ -100,6 +101,7 @@ ActionMessage& ActionMessage::operator=(const ActionMessage& act)  // NOLINT
     Te = act.Te;
     Tdemin = act.Tdemin;
     Tso = act.Tso;
+    enqueueTime = act.enqueueTime;
     payload = act.payload;
     stringData = act.stringData;
     return *this;
@@ -120,6 +122,7 @@ ActionMessage& ActionMessage::operator=(ActionMessage&& act) noexcept
     Te = act.Te;
     Tdemin = act.Tdemin;
     Tso = act.Tso;
+    enqueueTime = act.enqueueTime;
     payload = std::move(act.payload);
     stringData = std::move(act.stringData);
     return *this;
@@ -694,10 +697,59 @@ std::unique_ptr<Message> createMessageFromCommand(ActionMessage&& cmd)
     return msg;
 }
 
+// compacted layouts are marked by an empty destination and identified by the number of strings
+// {dest, source, source} -> {"", source}
+// {dest, source, "", ""} -> {"", source, ""}
+// {dest, source, source, dest} -> {"", source, "", ""}
+bool compactEndpointNames(ActionMessage& cmd)
+{
+    auto& strings = cmd.stringData;
+    if (strings.size() < 3 || strings[targetStringLoc].empty()) {
+        return false;
+    }
+    if (strings.size() == 3 && strings[origSourceStringLoc] == strings[sourceStringLoc]) {
+        strings.resize(2);
+    } else if (strings.size() == 4 && strings[origSourceStringLoc].empty() &&
+               strings[origDestStringLoc].empty()) {
+        strings.resize(3);
+    } else if (strings.size() == 4 && strings[origSourceStringLoc] == strings[sourceStringLoc] &&
+               strings[origDestStringLoc] == strings[targetStringLoc]) {
+        strings[origSourceStringLoc].clear();
+        strings[origDestStringLoc].clear();
+    } else {
+        return false;
+    }
+    strings[targetStringLoc].clear();
+    return true;
+}
+
+void restoreEndpointNames(ActionMessage& cmd, std::string_view destName)
+{
+    auto& strings = cmd.stringData;
+    if (strings.size() < 2 || strings.size() > 4 || !strings[targetStringLoc].empty() ||
+        destName.empty()) {
+        return;
+    }
+    strings[targetStringLoc] = destName;
+    switch (strings.size()) {
+        case 2: {
+            std::string source = strings[sourceStringLoc];
+            strings.push_back(std::move(source));
+        } break;
+        case 3:
+            strings.emplace_back();
+            break;
+        default:
+            strings[origSourceStringLoc] = strings[sourceStringLoc];
+            strings[origDestStringLoc] = destName;
+            break;
+    }
+}
+
 static constexpr char unknownStr[] = "unknown";
 
 // Map to translate the action to a description
-static constexpr frozen::unordered_map<action_message_def::action_t, frozen::string, 93>
+static constexpr frozen::unordered_map<action_message_def::action_t, frozen::string, 97>
     actionStrings = {
         // priority commands
         {action_message_def::action_t::cmd_priority_disconnect, "priority_disconnect"},
@@ -780,6 +832,8 @@ static constexpr frozen::unordered_map<action_message_def::action_t, frozen::str
         {action_message_def::action_t::cmd_resend, "reg_resend"},
         {action_message_def::action_t::cmd_add_endpoint, "add_endpoint"},
         {action_message_def::action_t::cmd_remove_endpoint, "remove endpoint"},
+        {action_message_def::action_t::cmd_endpoint_credit, "endpoint_credit"},
+        {action_message_def::action_t::cmd_endpoint_resolved, "endpoint_resolved"},
         {action_message_def::action_t::cmd_add_named_endpoint, "add_named_endpoint"},
         {action_message_def::action_t::cmd_add_named_input, "add_named_input"},
         {action_message_def::action_t::cmd_add_named_publication, "add_named_publication"},
@@ -793,6 +847,8 @@ static constexpr frozen::unordered_map<action_message_def::action_t, frozen::str
         {action_message_def::action_t::cmd_remove_named_filter, "remove_named_filter"},
         {action_message_def::action_t::cmd_close_interface, "close_interface"},
         {action_message_def::action_t::cmd_multi_message, "multi message"},
+        {action_message_def::action_t::cmd_deduplicated_message, "deduplicated message"},
+        {action_message_def::action_t::cmd_compressed_message, "compressed message"},
         {action_message_def::action_t::cmd_broker_configure, "broker_configure"},
         {action_message_def::action_t::cmd_time_barrier_request, "request time barrier"},
         {action_message_def::action_t::cmd_time_barrier, "time barrier"},
@@ -918,7 +974,7 @@ std::ostream& operator<<(std::ostream& os, const ActionMessage& command)
 
 int appendMessage(ActionMessage& m, const ActionMessage& newMessage)
 {
-    if (m.action() == CMD_MULTI_MESSAGE) {
+    if (m.action() == CMD_MULTI_MESSAGE && !checkActionFlag(m, packed_messages_flag)) {
         if (m.counter < 255) {
             m.setString(m.counter++, newMessage.to_string());
             return m.counter;
@@ -927,6 +983,43 @@ int appendMessage(ActionMessage& m, const ActionMessage& newMessage)
     return (-1);
 }
 
+int appendPackedMessage(ActionMessage& m, const ActionMessage& newMessage)
+{
+    if (m.action() != CMD_MULTI_MESSAGE || m.counter >= 0xFFFFU) {
+        return (-1);
+    }
+    // a container already holding string form messages cannot be mixed with packed ones
+    if (m.counter > 0 && !checkActionFlag(m, packed_messages_flag)) {
+        return (-1);
+    }
+    auto msize = static_cast<std::size_t>(newMessage.serializedByteCount());
+    auto csize = m.payload.size();
+    if (csize + msize > 0x00FFFFFFUL) {
+        return (-1);
+    }
+    if (m.payload.capacity() < csize + msize) {
+        // grow geometrically since packing usually involves several appends
+        m.payload.reserve((std::max)(csize + msize, 2 * m.payload.capacity()));
+    }
+    m.payload.resize(csize + msize);
+    newMessage.toByteArray(m.payload.data() + csize, msize);
+    setActionFlag(m, packed_messages_flag);
+    return ++m.counter;
+}
+
+bool extractPackedMessage(const ActionMessage& m, std::size_t& offset, ActionMessage& extracted)
+{
+    if (offset >= m.payload.size()) {
+        return false;
+    }
+    auto used = extracted.fromByteArray(m.payload.data() + offset, m.payload.size() - offset);
+    if (used == 0) {
+        return false;
+    }
+    offset += used;
+    return true;
+}
+
 void setIterationFlags(ActionMessage& command, IterationRequest iterate)
 {
     switch (iterate) {
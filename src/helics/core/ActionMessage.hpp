@@ -45,6 +45,8 @@ class ActionMessage {
     Time Te{timeZero};  //!< 48 event time
     Time Tdemin{timeZero};  //!< 56 min dependent event time
     Time Tso{timeZero};  //!< 64 the second order dependent time
+    /// local time the message was placed in a queue for latency tracking, not serialized
+    int64_t enqueueTime{0};
     SmallBuffer payload;  //!< buffer to contain the data payload
   private:
     std::vector<std::string> stringData;  //!< container for extra string data
@@ -205,6 +207,8 @@ class ActionMessage {
 
     friend std::unique_ptr<Message> createMessageFromCommand(const ActionMessage& cmd);
     friend std::unique_ptr<Message> createMessageFromCommand(ActionMessage&& cmd);
+    friend bool compactEndpointNames(ActionMessage& cmd);
+    friend void restoreEndpointNames(ActionMessage& cmd, std::string_view destName);
 };
 
 inline bool operator<(const ActionMessage& cmd, const ActionMessage& cmd2)
@@ -222,6 +226,17 @@ std::unique_ptr<Message> createMessageFromCommand(const ActionMessage& cmd);
  */
 std::unique_ptr<Message> createMessageFromCommand(ActionMessage&& cmd);
 
+/** remove the destination names and duplicated source names from a message that is routed by handle
+@details only the common layouts of the endpoint names are compacted, the names are put back with
+/ref restoreEndpointNames
+@return true if the names were compacted*/
+bool compactEndpointNames(ActionMessage& cmd);
+
+/** restore the endpoint names removed by /ref compactEndpointNames
+@param cmd the message to restore
+@param destName the name of the destination endpoint the message was delivered to*/
+void restoreEndpointNames(ActionMessage& cmd, std::string_view destName);
+
 /** check if a command is a protocol command*/
 inline bool isProtocolCommand(const ActionMessage& command) noexcept
 {
@@ -313,6 +328,24 @@ inline bool isErrorCommand(const ActionMessage& command) noexcept
     }
 }
 
+/** check if a command is handled by the action queue processing loop itself
+@details these commands change the state of the loop so they are handled one at a time and are
+never held for bundling with other messages*/
+inline bool isQueueControlCommand(const ActionMessage& command) noexcept
+{
+    switch (command.action()) {
+        case CMD_TERMINATE_IMMEDIATELY:
+        case CMD_STOP:
+        case CMD_TICK:
+        case CMD_BASE_CONFIGURE:
+        case CMD_PING:
+        case CMD_ERROR_CHECK:
+            return true;
+        default:
+            return false;
+    }
+}
+
 /** check if a command is a valid command*/
 inline bool isValidCommand(const ActionMessage& command) noexcept
 {
@@ -334,6 +367,22 @@ std::ostream& operator<<(std::ostream& os, const ActionMessage& command);
 @return the integer location of the message in the stringData section*/
 int appendMessage(ActionMessage& m, const ActionMessage& newMessage);
 
+/** append a message to a multi message container by serializing it directly into the payload
+@details this avoids generating an intermediate string for each message, the messages are read back
+out with /ref extractPackedMessage
+@param m the message to add the extra message to
+@param newMessage the message to append
+@return the number of messages in the container or -1 if the message could not be added*/
+int appendPackedMessage(ActionMessage& m, const ActionMessage& newMessage);
+
+/** read a message from a multi message container constructed with /ref appendPackedMessage
+@param m the multi message container
+@param[in,out] offset the location in the payload to read from, updated to the start of the next
+message
+@param[out] extracted the message read from the container
+@return true if a message was extracted*/
+bool extractPackedMessage(const ActionMessage& m, std::size_t& offset, ActionMessage& extracted);
+
 /** generate a string representing an error from an ActionMessage
 @param command the command to generate the error string for
 @return a string describing the error, if the string is not an error the string is empty
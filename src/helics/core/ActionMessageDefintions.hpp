@@ -183,9 +183,14 @@ across different compilers*/
         cmd_remove_filter = 135,  //!< cmd to remove a filter from connection
         cmd_remove_publication = 136,  //!< cmd to remove a publication from connection
         cmd_remove_endpoint = 137,  //!< cmd to remove an endpoint
+        cmd_endpoint_credit = 139,  //!< return message credits to the sender of messages
+        cmd_endpoint_resolved = 138,  //!< the handle of a named endpoint for a sending core
 
         cmd_close_interface = 133,  //!< cmd to close all communications from an interface
         cmd_multi_message = 1037,  //!< cmd that encapsulates a bunch of messages in its payload
+        cmd_deduplicated_message = 1038,  //!< cmd encapsulating a message whose payload may be
+                                          //!< cached by the receiver
+        cmd_compressed_message = 1039,  //!< cmd encapsulating a compressed message
 
         cmd_connection_error = 2034,  //!< cmd indicating a connection error with a broker/federate
 
@@ -287,6 +292,8 @@ across different compilers*/
 #define CMD_REMOVE_NAMED_INPUT action_message_def::action_t::cmd_remove_named_input
 
 #define CMD_REMOVE_ENDPOINT action_message_def::action_t::cmd_remove_endpoint
+#define CMD_ENDPOINT_CREDIT action_message_def::action_t::cmd_endpoint_credit
+#define CMD_ENDPOINT_RESOLVED action_message_def::action_t::cmd_endpoint_resolved
 #define CMD_REMOVE_FILTER action_message_def::action_t::cmd_remove_filter
 #define CMD_REMOVE_PUBLICATION action_message_def::action_t::cmd_remove_publication
 #define CMD_REMOVE_SUBSCRIBER action_message_def::action_t::cmd_remove_subscriber
@@ -353,6 +360,8 @@ across different compilers*/
 #define CMD_COMMAND_RESPONSE_ORDERED action_message_def::action_t::cmd_command_response_ordered
 
 #define CMD_MULTI_MESSAGE action_message_def::action_t::cmd_multi_message
+#define CMD_DEDUPLICATED_MESSAGE action_message_def::action_t::cmd_deduplicated_message
+#define CMD_COMPRESSED_MESSAGE action_message_def::action_t::cmd_compressed_message
 
 // definitions for the protocol options
 #define PROTOCOL_PING 10
@@ -365,6 +374,7 @@ across different compilers*/
 // routing information
 #define NEW_ROUTE 233
 #define REMOVE_ROUTE 244
+#define ENABLE_PAYLOAD_FRAMES 251
 #define CONNECTION_INFORMATION 299
 #define CONNECTION_REQUEST 301
 #define CONNECTION_ACK 304
@@ -387,6 +397,7 @@ across different compilers*/
 #define UPDATE_FILTER_OPERATOR 572
 #define UPDATE_QUERY_CALLBACK 581
 #define UPDATE_LOGGING_CALLBACK 592
+#define UPDATE_GRAPH_SUBSCRIPTION 597
 #define REQUEST_TICK_FORWARDING 607
 
 /** return the name of the action
@@ -11,6 +11,7 @@ SPDX-License-Identifier: BSD-3-Clause
 #include <chrono>
 #include <functional>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace helics {
@@ -109,6 +110,22 @@ class Broker {
                              const std::string& commandStr,
                              HelicsSequencingModes mode = HELICS_SEQUENCING_MODE_FAST) = 0;
 
+    /** subscribe to the changes of a federation graph
+    @details the callback is called with the full graph as soon as it is available and afterwards
+    with a JSON delta listing the nodes added and removed and the fields changed each time the
+    graph changes.  Changes are detected from the federate, broker, and interface registrations and
+    states seen by the broker, so a federation in steady state generates no work.
+    @param graph the name of the graph query, "dependency_graph" or "data_flow_graph"
+    @param callback the function to call with the graph or the changes, it is called from the
+    broker processing thread
+    @return an identifier for the subscription or -1 if the graph is not recognized*/
+    virtual std::int32_t subscribeToGraph(std::string_view graph,
+                                          std::function<void(std::string_view)> callback) = 0;
+    /** remove a subscription created by subscribeToGraph
+    @details waits for a callback of the subscription that is in progress on another thread, no
+    callbacks of the subscription are made once the call returns*/
+    virtual void unsubscribeFromGraph(std::int32_t subscriptionId) = 0;
+
     /** load a file containing connection information
     @param file a JSON or TOML file containing connection information*/
     virtual void makeConnections(const std::string& file) = 0;
@@ -9,12 +9,15 @@ SPDX-License-Identifier: BSD-3-Clause
 
 #include "../common/fmt_format.h"
 #include "ForwardingTimeCoordinator.hpp"
+#include "MessageTrace.hpp"
+#include "PayloadCompression.hpp"
 #include "ProfilerBuffer.hpp"
 #include "flagOperations.hpp"
 #include "gmlc/libguarded/guarded.hpp"
 #include "gmlc/utilities/stringOps.h"
 #include "helics/core/helicsCLI11JsonConfig.hpp"
 #include "helicsCLI11.hpp"
+#include "json/json.h"
 #include "loggingHelper.hpp"
 #include "spdlog/sinks/basic_file_sink.h"
 #include "spdlog/sinks/stdout_color_sinks.h"
@@ -58,6 +61,9 @@ static inline std::string genId()
 }
 
 namespace helics {
+/// the maximum number of commands processed before messages held for coalescing are sent
+constexpr int maxMessagesPerPass{64};
+
 BrokerBase::BrokerBase(bool DisableQueue) noexcept: queueDisabled(DisableQueue) {}
 
 BrokerBase::BrokerBase(const std::string& broker_name, bool DisableQueue):
@@ -155,6 +161,12 @@ std::shared_ptr<helicsCLI11App> BrokerBase::generateBaseCLI()
         "--restrictive_time_policy",
         restrictive_time_policy,
         "specify that a broker should use a conservative time policy in the time coordinator");
+    hApp->add_option(
+        "--time_quantum,--timequantum",
+        timeQuantum,
+        "round the event times of the federates onto a grid of this size so events close together "
+        "are granted together, set on the root broker to apply to the whole federation, default "
+        "unit is in ms (can also be entered as a time like '1ms' or '10us')");
     hApp->add_flag(
         "--debugging",
         debugging,
@@ -162,7 +174,33 @@ std::shared_ptr<helicsCLI11App> BrokerBase::generateBaseCLI()
     hApp->add_flag("--json",
                    useJsonSerialization,
                    "use the JSON serialization mode for communications");
+    hApp->add_flag(
+        "--disable_coalescing",
+        disable_coalescing,
+        "turn off the packing of messages sent on the same route into multi-message bundles");
+    hApp->add_flag("--payload_dedup",
+                   enable_payload_dedup,
+                   "send repeated message payloads on a route as a reference to a copy cached by "
+                   "the receiver, not available on transports without in order delivery such as "
+                   "udp");
 
+    hApp->add_flag("--compression",
+                   enable_compression,
+                   "compress large message payloads on network routes to brokers and cores that "
+                   "also enable compression, statistics are available through the compression "
+                   "query");
+    hApp->add_option("--memory_limit",
+                     memoryLimit,
+                     "soft limit on the memory used for messages and queued commands, units can be "
+                     "given as KB, MB, or GB, federates sending data are slowed and a warning is "
+                     "logged while the limit is exceeded, usage is available through the memory "
+                     "query")
+        ->transform(CLI::AsSizeValue(false));
+    hApp->add_flag(
+        "--queue_latency",
+        trackQueueLatency,
+        "record the time commands spend in the action, federate, and transmit queues, the results "
+        "are available through the queue_latency query and in the profiling output");
     // add the profiling setup command
     hApp->add_option_function<std::string>(
             "--profiler",
@@ -232,6 +270,11 @@ std::shared_ptr<helicsCLI11App> BrokerBase::generateBaseCLI()
         "--dumplog",
         dumplog,
         "capture a record of all messages and dump a complete log to file or console on termination");
+    logging_group->add_option(
+        "--tracefile",
+        traceFile,
+        "record every command processed by the broker or core with the time it was taken from the "
+        "queue to a binary trace file for offline replay");
 
     auto* timeout_group =
         hApp->add_option_group("timeouts", "Options related to network and process timeouts");
@@ -260,6 +303,12 @@ std::shared_ptr<helicsCLI11App> BrokerBase::generateBaseCLI()
         queryTimeout,
         "time to wait for a query to be answered default unit is in  ms default 15s(can also be entered as a time "
         "like '10s' or '45ms') ");
+    timeout_group->add_option(
+        "--credittimeout,--credit_timeout",
+        creditTimeout,
+        "time a send waits for an endpoint with a receive capacity to consume messages before "
+        "sending anyway, default unit is in ms default 1s(can also be entered as a time like "
+        "'10s' or '45ms') ");
     timeout_group
         ->add_option("--errordelay,--errortimeout",
                      errorDelay,
@@ -354,6 +403,9 @@ void BrokerBase::configureBase()
     timeCoord->setMessageSender([this](const ActionMessage& msg) { addActionMessage(msg); });
     timeCoord->restrictive_time_policy = restrictive_time_policy;
 
+    if (enable_profiling) {
+        trackQueueLatency = true;
+    }
     generateLoggers();
 
     mainLoopIsRunning.store(true);
@@ -474,8 +526,82 @@ void BrokerBase::saveProfilingData(std::string_view message)
     }
 }
 
+void BrokerBase::generateQueueLatency(Json::Value& base) const
+{
+    actionQueueLatency.generateJson(base["action_queue"]);
+}
+
+std::uint64_t BrokerBase::queuedMemory() const
+{
+    auto payloadBytes = queuedPayloadBytes.load(std::memory_order_relaxed);
+    return ((payloadBytes > 0) ? static_cast<std::uint64_t>(payloadBytes) : 0U) +
+        actionQueue.size() * sizeof(ActionMessage);
+}
+
+std::uint64_t BrokerBase::trackedMemory() const
+{
+    return queuedMemory() + interfaceBytes.load(std::memory_order_relaxed);
+}
+
+bool BrokerBase::memoryLimitCleared()
+{
+    if (!memoryLimitExceeded.load()) {
+        return true;
+    }
+    if (trackedMemory() < memoryLimit - memoryLimit / 8) {
+        memoryLimitExceeded.store(false);
+        return true;
+    }
+    return false;
+}
+
+std::uint64_t BrokerBase::generateMemoryUsage(Json::Value& base) const
+{
+    const auto queueBytes = queuedMemory();
+    base["action_queue"] = static_cast<Json::UInt64>(queueBytes);
+    base["process_payloads"] = static_cast<Json::Int64>(SmallBuffer::allocatedHeapBytes());
+    base["limit"] = static_cast<Json::UInt64>(memoryLimit);
+    base["limit_exceeded"] = memoryLimitExceeded.load();
+    return queueBytes;
+}
+
+void BrokerBase::checkMemoryLimit()
+{
+    interfaceBytes.store(interfaceMemory(), std::memory_order_relaxed);
+    const auto usage = trackedMemory();
+    if (!memoryLimitExceeded.load(std::memory_order_relaxed)) {
+        if (usage > memoryLimit) {
+            memoryLimitExceeded.store(true);
+            sendToLogger(global_broker_id_local,
+                         LogLevels::WARNING,
+                         identifier,
+                         fmt::format("tracked memory {} bytes exceeds the limit of {} bytes",
+                                     usage,
+                                     memoryLimit));
+        }
+        // clear with some hysteresis so the state doesn't flip on every pass
+    } else if (usage < memoryLimit - memoryLimit / 8) {
+        memoryLimitExceeded.store(false);
+        sendToLogger(global_broker_id_local,
+                     LogLevels::SUMMARY,
+                     identifier,
+                     fmt::format("tracked memory {} bytes is back under the limit", usage));
+    }
+}
+
 void BrokerBase::writeProfilingData()
 {
+    if (trackQueueLatency) {
+        Json::Value base;
+        generateQueueLatency(base);
+        Json::StreamWriterBuilder builder;
+        builder["commentStyle"] = "None";
+        builder["indentation"] = "";
+        saveProfilingData(fmt::format("<PROFILING>{}[{}]QUEUE LATENCY<{}></PROFILING>",
+                                      identifier,
+                                      global_broker_id_local.baseValue(),
+                                      Json::writeString(builder, base)));
+    }
     if (prBuff) {
         try {
             prBuff->writeFile();
@@ -570,10 +696,11 @@ void BrokerBase::addActionMessage(const ActionMessage& m)
     //  }
     //}
     if (isPriorityCommand(m)) {
+        countQueuedPayload(m);
         actionQueue.pushPriority(m);
     } else {
         // just route to the general queue;
-        actionQueue.push(m);
+        pushAction(m);
     }
 }
 
@@ -586,10 +713,11 @@ void BrokerBase::addActionMessage(ActionMessage&& m)
     //    }
     //}
     if (isPriorityCommand(m)) {
+        countQueuedPayload(m);
         actionQueue.emplacePriority(std::move(m));
     } else {
         // just route to the general queue;
-        actionQueue.emplace(std::move(m));
+        pushAction(std::move(m));
     }
 }
 #ifndef HELICS_DISABLE_ASIO
@@ -697,7 +825,9 @@ void BrokerBase::queueProcessingLoop()
 #endif
 
     global_broker_id_local = global_id.load();
+    queueProcessingThreadId.store(std::this_thread::get_id());
     int messagesSinceLastTick = 0;
+    int messagesSinceLastFlush = 0;
     auto logDump = [&, this]() {
         if (!dumpMessages.empty()) {
             for (auto& act : dumpMessages) {
@@ -716,12 +846,52 @@ void BrokerBase::queueProcessingLoop()
         mainLoopIsRunning.store(false);
         return;
     }
+    if (!traceFile.empty()) {
+        traceWriter = std::make_unique<MessageTraceWriter>();
+        try {
+            traceWriter->open(traceFile);
+        }
+        catch (const std::ios_base::failure& e) {
+            sendToLogger(global_broker_id_local,
+                         LogLevels::WARNING,
+                         identifier,
+                         fmt::format("unable to open trace file {}: {}", traceFile, e.what()));
+            traceWriter.reset();
+        }
+    }
     while (true) {
-        auto command = actionQueue.pop();
-        ++messageCounter;
-        if (dumplog) {
-            dumpMessages.push_back(command);
+        // a processing pass ends when the queue runs dry or the pass gets too long
+        if (messagesSinceLastFlush > 0 && unpackedMessages.empty() &&
+            (messagesSinceLastFlush >= maxMessagesPerPass || actionQueue.empty())) {
+            completeProcessingPass();
+            flushCoalescedMessages();
+            messagesSinceLastFlush = 0;
+            if (memoryLimit > 0) {
+                checkMemoryLimit();
+            }
+        }
+        ActionMessage command;
+        if (unpackedMessages.empty()) {
+            command = actionQueue.pop();
+            queuedPayloadBytes.fetch_sub(static_cast<std::int64_t>(command.payload.size()),
+                                         std::memory_order_relaxed);
+            if (dumplog) {
+                dumpMessages.push_back(command);
+            }
+            if (trackQueueLatency) {
+                actionQueueLatency.record(command.enqueueTime);
+                command.enqueueTime = 0;
+            }
+            if (traceWriter) {
+                traceWriter->record(command);
+            }
+        } else {
+            // the rest of a packed bundle is processed before anything else from the queue
+            command = std::move(unpackedMessages.front());
+            unpackedMessages.pop_front();
         }
+        ++messageCounter;
+        ++messagesSinceLastFlush;
         if (command.action() == CMD_IGNORE) {
             continue;
         }
@@ -819,6 +989,8 @@ void BrokerBase::queueProcessingLoop()
                 timerStop();
                 mainLoopIsRunning.store(false);
                 logDump();
+                traceWriter.reset();
+                unpackedMessages.clear();
                 {
                     auto tcmd = actionQueue.try_pop();
                     while (tcmd) {
@@ -831,15 +1003,21 @@ void BrokerBase::queueProcessingLoop()
                         tcmd = actionQueue.try_pop();
                     }
                 }
+                queueProcessingThreadId.store(std::thread::id{});
                 return;  // immediate return
             case CMD_STOP:
                 timerStop();
+                receivedPayloads.clear();
                 if (!haltOperations) {
                     processCommand(std::move(command));
+                    flushCoalescedMessages();
                     mainLoopIsRunning.store(false);
                     logDump();
                     processDisconnect();
+                    flushCoalescedMessages();
                 }
+                traceWriter.reset();
+                unpackedMessages.clear();
                 auto tcmd = actionQueue.try_pop();
                 while (tcmd) {
                     if (!isDisconnectCommand(*tcmd)) {
@@ -850,6 +1028,7 @@ void BrokerBase::queueProcessingLoop()
                     }
                     tcmd = actionQueue.try_pop();
                 }
+                queueProcessingThreadId.store(std::thread::id{});
                 return;
         }
     }
@@ -908,6 +1087,16 @@ action_message_def::action_t BrokerBase::commandProcessor(ActionMessage& command
         case CMD_ERROR_CHECK:
             return command.action();
         case CMD_MULTI_MESSAGE:
+            if (checkActionFlag(command, packed_messages_flag)) {
+                // the processing loop takes the bundled messages before the next queued command
+                // so any loop control command in the bundle is handled in order
+                std::size_t offset{0};
+                ActionMessage NMess;
+                while (extractPackedMessage(command, offset, NMess)) {
+                    unpackedMessages.push_back(std::move(NMess));
+                }
+                break;
+            }
             for (int ii = 0; ii < command.counter; ++ii) {
                 ActionMessage NMess;
                 NMess.from_string(command.getString(ii));
@@ -922,7 +1111,49 @@ action_message_def::action_t BrokerBase::commandProcessor(ActionMessage& command
                 }
             }
             break;
+        case CMD_DEDUPLICATED_MESSAGE: {
+            ActionMessage NMess;
+            if (!receivedPayloads.decode(command, NMess)) {
+                sendToLogger(global_id.load(),
+                             HELICS_LOG_LEVEL_WARNING,
+                             identifier,
+                             "unable to restore the payload of a deduplicated message");
+                break;
+            }
+            auto V = commandProcessor(NMess);
+            if (V != CMD_IGNORE) {
+                command = std::move(NMess);
+                return V;
+            }
+        } break;
+        case CMD_COMPRESSED_MESSAGE: {
+            ActionMessage NMess;
+            if (!decompressMessage(command, NMess)) {
+                sendToLogger(global_id.load(),
+                             HELICS_LOG_LEVEL_WARNING,
+                             identifier,
+                             "unable to decompress a compressed message");
+                break;
+            }
+            auto V = commandProcessor(NMess);
+            if (V != CMD_IGNORE) {
+                command = std::move(NMess);
+                return V;
+            }
+        } break;
         default:
+            if (command.source_id.isBroker()) {
+                switch (command.action()) {
+                    case CMD_DISCONNECT:
+                    case CMD_DISCONNECT_CORE:
+                    case CMD_DISCONNECT_BROKER:
+                        // nothing more will arrive that refers to payloads cached from the source
+                        receivedPayloads.removeSource(command.source_id);
+                        break;
+                    default:
+                        break;
+                }
+            }
             if (!haltOperations) {
                 if (isPriorityCommand(command)) {
                     processPriorityCommand(std::move(command));
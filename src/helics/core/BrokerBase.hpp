@@ -13,9 +13,13 @@ and some common methods used cores and brokers
 
 #include "ActionMessage.hpp"
 #include "FederateIdExtra.hpp"
+#include "LatencyHistogram.hpp"
+#include "PayloadDedup.hpp"
 #include "gmlc/containers/BlockingPriorityQueue.hpp"
 
 #include <atomic>
+#include <cstdint>
+#include <deque>
 #include <limits>
 #include <memory>
 #include <string>
@@ -29,6 +33,7 @@ namespace helics {
 class ForwardingTimeCoordinator;
 class helicsCLI11App;
 class ProfilerBuffer;
+class MessageTraceWriter;
 /** base class for broker like objects
  */
 class BrokerBase {
@@ -58,6 +63,10 @@ class BrokerBase {
     Time queryTimeout{15.0};  //!< timeout for queries, if the query isn't answered within this time
                               //!< period respond with timeout error
     Time errorDelay{10.0};  //!< time to delay before terminating after error state
+    /// time a send waits for an endpoint with a limited receive capacity to consume messages
+    Time creditTimeout{1.0};
+    /// the federation time quantum, federate event times are rounded up to a multiple of it
+    Time timeQuantum{timeZero};
     std::string identifier;  //!< an identifier for the broker
     std::string brokerKey;  //!< a key that all joining federates must have to connect if empty no
                             //!< key is required
@@ -70,6 +79,8 @@ class BrokerBase {
     std::shared_ptr<spdlog::logger>
         fileLogger;  //!< default logging object to use if the logging callback is not specified
     std::thread queueProcessingThread;  //!< thread for running the broker
+    /// the id of the thread actively running the queue processing loop
+    std::atomic<std::thread::id> queueProcessingThreadId{};
     /** a logging function for logging or printing messages*/
     std::function<void(int, std::string_view, std::string_view)> loggerFunction;
 
@@ -84,6 +95,10 @@ class BrokerBase {
     std::atomic<bool> mainLoopIsRunning{
         false};  //!< flag indicating that the main processing loop is running
     bool dumplog{false};  //!< flag indicating the broker should capture a dump log
+    std::string traceFile;  //!< the file to record a binary trace of processed commands to
+    std::unique_ptr<MessageTraceWriter> traceWriter;  //!< the active command trace
+    /// messages extracted from a packed bundle, processed before the next queued command
+    std::deque<ActionMessage> unpackedMessages;
     std::atomic<bool> forceLoggingFlush{false};  //!< force the log to flush after every message
     bool queueDisabled{
         false};  //!< flag indicating that the message queue should not be used and all functions
@@ -130,6 +145,24 @@ class BrokerBase {
     /** specify that outgoing connection should use json serialization */
     bool useJsonSerialization{false};
     bool enable_profiling{false};  //!< indicator that profiling is enabled
+    /// turn off the packing of messages sent on the same route during a processing pass
+    bool disable_coalescing{false};
+    /// send repeated message payloads on a route as references to a receiver side cache
+    bool enable_payload_dedup{false};
+    /// compress large payloads on network routes where the other side also enables compression
+    bool enable_compression{false};
+    /// record the time commands spend waiting in the queues of the broker or core
+    bool trackQueueLatency{false};
+    /// soft limit on the tracked memory in bytes, 0 for no limit
+    std::uint64_t memoryLimit{0};
+    /// set while the tracked memory is over the soft limit
+    std::atomic<bool> memoryLimitExceeded{false};
+    /// payload bytes of the commands currently in the action queue
+    std::atomic<std::int64_t> queuedPayloadBytes{0};
+    /// interface buffer bytes found by the last memory limit check
+    std::atomic<std::uint64_t> interfaceBytes{0};
+    LatencyHistogram actionQueueLatency;  //!< time spent in the action queue
+    PayloadDedupDecoder receivedPayloads;  //!< payloads cached for deduplicated messages
     decltype(std::chrono::steady_clock::now())
         errorTimeStart;  //!< time when the error condition started related to the errorDelay
     std::atomic<int> lastErrorCode{0};  //!< storage for last error code
@@ -258,6 +291,72 @@ class BrokerBase {
     bool getFlagValue(int32_t flag) const;
     /** virtual function to return the current simulation time*/
     virtual double getSimulationTime() const { return mInvalidSimulationTime; }
+    /** check if the calling thread is the thread processing the action queue*/
+    bool isQueueProcessingThread() const
+    {
+        return std::this_thread::get_id() == queueProcessingThreadId.load();
+    }
+    /** complete any work batched over the current processing pass
+    @details called by the processing loop before held messages are flushed*/
+    virtual void completeProcessingPass() {}
+    /** send any messages held for coalescing during the current processing pass
+    @details called by the processing loop when the action queue is empty or a pass reaches its
+    message limit*/
+    virtual void flushCoalescedMessages() {}
+    /** count the payload of a command placed on the action queue toward the tracked memory*/
+    void countQueuedPayload(const ActionMessage& command)
+    {
+        queuedPayloadBytes.fetch_add(static_cast<std::int64_t>(command.payload.size()),
+                                     std::memory_order_relaxed);
+    }
+    /** place a command on the normal lane of the action queue without the priority check of
+    addActionMessage
+    @details every non-priority command enters the queue through here so the payload is counted
+    and the command is marked with the time it is queued if queue latency tracking is active*/
+    void pushAction(ActionMessage&& command)
+    {
+        countQueuedPayload(command);
+        if (trackQueueLatency) {
+            command.enqueueTime = LatencyHistogram::now();
+        }
+        actionQueue.emplace(std::move(command));
+    }
+    /** place a copy of a command on the normal lane of the action queue*/
+    void pushAction(const ActionMessage& command) { pushAction(ActionMessage(command)); }
+    /** load the queue latency histograms of the broker or core into a json object*/
+    virtual void generateQueueLatency(Json::Value& base) const;
+    /** turn compression of large payloads on or off for a route
+    @details called once both sides of a connection have agreed to use compression*/
+    virtual void setRouteCompression(route_id /*rid*/, bool /*active*/) {}
+    /** check if the comms can send large payloads in a frame separate from the command*/
+    virtual bool payloadFramesAvailable() const { return false; }
+    /** send large payloads on a route in a separate frame
+    @details called once the other side of the route has reported it can receive them*/
+    virtual void enableRoutePayloadFrames(route_id /*rid*/) {}
+    /** load the compression statistics of each compressed route into a json object*/
+    virtual void generateCompressionStats(Json::Value& /*base*/) const {}
+    /** check if the data waiting to be transmitted exceeds the transmit limit of the comms
+    @details threadsafe, used to hold data producing calls from outside the processing loop*/
+    virtual bool transmitBacklogged() const { return false; }
+    /** load the memory accounting of the broker or core into a json object
+    @return the total number of bytes accounted for*/
+    virtual std::uint64_t generateMemoryUsage(Json::Value& base) const;
+    /** get an estimate of the bytes held in the interface buffers of the broker or core
+    @details called from the processing loop when the memory limit is checked*/
+    virtual std::uint64_t interfaceMemory() const { return 0; }
+    /** get the bytes held by the action queue and the payloads of the commands in it*/
+    std::uint64_t queuedMemory() const;
+    /** get the memory checked against the soft limit
+    @details the action queue usage plus the interface buffer usage found by the last check*/
+    std::uint64_t trackedMemory() const;
+    /** re-check an exceeded memory limit from a thread waiting for it to clear
+    @details uses the current action queue usage with the interface usage from the last check
+    @return true if the limit is not exceeded*/
+    bool memoryLimitCleared();
+
+  private:
+    /** compare the tracked memory to the soft limit and warn when it is crossed*/
+    void checkMemoryLimit();
 
   public:
     /** generate a callback function for the logging purposes*/
@@ -146,6 +146,12 @@ bool CommonCore::connect()
                 if (useJsonSerialization) {
                     setActionFlag(m, use_json_serialization_flag);
                 }
+                if (enable_compression) {
+                    setActionFlag(m, compression_flag);
+                }
+                if (payloadFramesAvailable()) {
+                    setActionFlag(m, payload_frames_flag);
+                }
 
                 if (no_ping) {
                     setActionFlag(m, slow_responding_flag);
@@ -187,6 +193,7 @@ void CommonCore::processDisconnect(bool skipUnregister)
     if (cBrokerState > BrokerState::configured) {
         if (cBrokerState < BrokerState::terminating) {
             setBrokerState(BrokerState::terminating);
+            messageCredits.clear();
             sendDisconnect();
             if ((global_broker_id_local != parent_broker_id) &&
                 (global_broker_id_local.isValid())) {
@@ -324,6 +331,24 @@ const BasicHandleInfo* CommonCore::getLocalEndpoint(const std::string& name) con
     return handles.read([&name](auto& hand) { return hand.getEndpoint(name); });
 }
 
+FederateState* CommonCore::getGroupPeer(int32_t group, GlobalFederateId federateID) const
+{
+    auto* fed = localFederateIds.read([federateID](const auto& ids) -> FederateState* {
+        auto fnd = ids.find(federateID);
+        return (fnd != ids.end()) ? fnd->second : nullptr;
+    });
+    if (fed == nullptr || fed->getFederateGroup() != group) {
+        return nullptr;
+    }
+    auto state = fed->getState();
+    return (state == HELICS_INITIALIZING || state == HELICS_EXECUTING) ? fed : nullptr;
+}
+
+void CommonCore::removeLocalFederateId(GlobalFederateId federateID)
+{
+    localFederateIds.modify([federateID](auto& ids) { ids.erase(federateID); });
+}
+
 bool CommonCore::isLocal(GlobalFederateId global_fedid) const
 {
     return (loopFederates.find(global_fedid) != loopFederates.end());
@@ -331,8 +356,7 @@ bool CommonCore::isLocal(GlobalFederateId global_fedid) const
 
 route_id CommonCore::getRoute(GlobalFederateId global_fedid) const
 {
-    auto fnd = routing_table.find(global_fedid);
-    return (fnd != routing_table.end()) ? fnd->second : parent_route_id;
+    return routing_table.getRoute(global_fedid, parent_route_id);
 }
 
 bool CommonCore::isConfigured() const
@@ -424,6 +448,8 @@ void CommonCore::finalize(LocalFederateId federateID)
     if (fed == nullptr) {
         throw(InvalidIdentifier("federateID not valid finalize"));
     }
+    flushStagedRegistrations(fed);
+    removeLocalFederateId(fed->global_id.load());
     ActionMessage bye(CMD_DISCONNECT);
     bye.source_id = fed->global_id.load();
     bye.dest_id = bye.source_id;
@@ -529,6 +555,8 @@ void CommonCore::enterInitializingMode(LocalFederateId federateID)
     bool exp = false;
     if (fed->init_requested.compare_exchange_strong(
             exp, true)) {  // only enter this loop once per federate
+        // the staged registrations must reach the core before the init request
+        flushStagedRegistrations(fed);
         ActionMessage m(CMD_INIT);
         m.source_id = fed->global_id.load();
         addActionMessage(m);
@@ -623,6 +651,8 @@ LocalFederateId CommonCore::registerFederate(const std::string& name, const Core
     if (enable_profiling) {
         fed->setOptionFlag(defs::PROFILING, true);
     }
+    fed->setQueueLatencyTracking(trackQueueLatency);
+    fed->setMemoryTracking(memoryLimit > 0);
     ActionMessage m(CMD_REG_FED);
     m.name(name);
     addActionMessage(m);
@@ -936,6 +966,73 @@ const BasicHandleInfo& CommonCore::createBasicHandle(GlobalFederateId global_fed
     });
 }
 
+const BasicHandleInfo* CommonCore::createUniqueHandle(const FederateState& fed,
+                                                     InterfaceType HandleType,
+                                                     const std::string& key,
+                                                     const std::string& type,
+                                                     const std::string& units,
+                                                     uint16_t flags)
+{
+    // the name check and the insertion share one lock so parallel registrations take it once
+    return handles.modify([&](auto& hand) -> const BasicHandleInfo* {
+        const BasicHandleInfo* existing{nullptr};
+        switch (HandleType) {
+            case InterfaceType::INPUT:
+                existing = hand.getInput(key);
+                break;
+            case InterfaceType::PUBLICATION:
+                existing = hand.getPublication(key);
+                break;
+            case InterfaceType::ENDPOINT:
+                existing = hand.getEndpoint(key);
+                break;
+            default:
+                break;
+        }
+        if (existing != nullptr) {
+            return nullptr;
+        }
+        auto& hndl = hand.addHandle(fed.global_id.load(), HandleType, key, type, units);
+        hndl.local_fed_id = fed.local_id;
+        hndl.flags = flags;
+        return &hndl;
+    });
+}
+
+void CommonCore::queueRegistration(FederateState* fed, ActionMessage&& registration)
+{
+    if (fed->stageRegistration(registration)) {
+        return;
+    }
+    pushAction(std::move(registration));
+}
+
+void CommonCore::flushStagedRegistrations(FederateState* fed)
+{
+    if (fed == nullptr) {
+        return;
+    }
+    auto staged = fed->takeStagedRegistrations();
+    if (staged.empty()) {
+        return;
+    }
+    if (staged.size() == 1) {
+        pushAction(std::move(staged.front()));
+        return;
+    }
+    ActionMessage package(CMD_MULTI_MESSAGE);
+    package.source_id = fed->global_id.load();
+    for (const auto& registration : staged) {
+        if (appendPackedMessage(package, registration) < 0) {
+            pushAction(std::move(package));
+            package = ActionMessage(CMD_MULTI_MESSAGE);
+            package.source_id = fed->global_id.load();
+            appendPackedMessage(package, registration);
+        }
+    }
+    pushAction(std::move(package));
+}
+
 static const std::string emptyString;
 
 InterfaceHandle CommonCore::registerInput(LocalFederateId federateID,
@@ -947,19 +1044,13 @@ InterfaceHandle CommonCore::registerInput(LocalFederateId federateID,
     if (fed == nullptr) {
         throw(InvalidIdentifier("federateID not valid (registerNamedInput)"));
     }
-    const auto* ci = handles.read([&key](auto& hand) { return hand.getInput(key); });
-    if (ci != nullptr) {  // this key is already found
+    const auto* handle = createUniqueHandle(
+        *fed, InterfaceType::INPUT, key, type, units, fed->getInterfaceFlags());
+    if (handle == nullptr) {  // this key is already found
         throw(RegistrationFailure("named Input already exists"));
     }
-    const auto& handle = createBasicHandle(fed->global_id,
-                                           fed->local_id,
-                                           InterfaceType::INPUT,
-                                           key,
-                                           type,
-                                           units,
-                                           fed->getInterfaceFlags());
 
-    auto id = handle.getInterfaceHandle();
+    auto id = handle->getInterfaceHandle();
     fed->createInterface(InterfaceType::INPUT, id, key, type, units);
 
     LOG_INTERFACES(parent_broker_id,
@@ -968,11 +1059,11 @@ InterfaceHandle CommonCore::registerInput(LocalFederateId federateID,
     ActionMessage m(CMD_REG_INPUT);
     m.source_id = fed->global_id.load();
     m.source_handle = id;
-    m.flags = handle.flags;
+    m.flags = handle->flags;
     m.name(key);
     m.setStringData(type, units);
 
-    actionQueue.push(std::move(m));
+    queueRegistration(fed, std::move(m));
     return id;
 }
 
@@ -995,30 +1086,24 @@ InterfaceHandle CommonCore::registerPublication(LocalFederateId federateID,
         throw(InvalidIdentifier("federateID not valid (registerPublication)"));
     }
     LOG_INTERFACES(parent_broker_id, fed->getIdentifier(), fmt::format("registering PUB {}", key));
-    const auto* pub = handles.read([&key](auto& hand) { return hand.getPublication(key); });
-    if (pub != nullptr)  // this key is already found
+    const auto* handle = createUniqueHandle(
+        *fed, InterfaceType::PUBLICATION, key, type, units, fed->getInterfaceFlags());
+    if (handle == nullptr)  // this key is already found
     {
         throw(RegistrationFailure("Publication key already exists"));
     }
-    const auto& handle = createBasicHandle(fed->global_id,
-                                           fed->local_id,
-                                           InterfaceType::PUBLICATION,
-                                           key,
-                                           type,
-                                           units,
-                                           fed->getInterfaceFlags());
 
-    auto id = handle.handle.handle;
+    auto id = handle->handle.handle;
     fed->createInterface(InterfaceType::PUBLICATION, id, key, type, units);
 
     ActionMessage m(CMD_REG_PUB);
     m.source_id = fed->global_id.load();
     m.source_handle = id;
     m.name(key);
-    m.flags = handle.flags;
+    m.flags = handle->flags;
     m.setStringData(type, units);
 
-    actionQueue.push(std::move(m));
+    queueRegistration(fed, std::move(m));
     return id;
 }
 
@@ -1150,6 +1235,45 @@ void CommonCore::setHandleOption(InterfaceHandle handle, int32_t option, int32_t
     }
 }
 
+void CommonCore::setInputTolerance(InterfaceHandle handle, double tolerance)
+{
+    const auto* handleInfo = getHandleInfo(handle);
+    if (handleInfo == nullptr || handleInfo->handleType != InterfaceType::INPUT) {
+        return;
+    }
+    auto* fed = getHandleFederate(handle);
+    if (fed == nullptr) {
+        return;
+    }
+    ActionMessage fcn(CMD_INTERFACE_CONFIGURE);
+    fcn.dest_id = fed->global_id;
+    fcn.dest_handle = handle;
+    fcn.messageID = inputConvergenceToleranceOption;
+    fcn.counter = static_cast<uint16_t>(handleInfo->handleType);
+    fcn.payload.assign(&tolerance, sizeof(double));
+    fed->setProperties(fcn);
+}
+
+void CommonCore::setInputRetention(InterfaceHandle handle, int32_t valueCount, Time window)
+{
+    const auto* handleInfo = getHandleInfo(handle);
+    if (handleInfo == nullptr || handleInfo->handleType != InterfaceType::INPUT) {
+        return;
+    }
+    auto* fed = getHandleFederate(handle);
+    if (fed == nullptr) {
+        return;
+    }
+    ActionMessage fcn(CMD_INTERFACE_CONFIGURE);
+    fcn.dest_id = fed->global_id;
+    fcn.dest_handle = handle;
+    fcn.messageID = inputHistoryRetentionOption;
+    fcn.counter = static_cast<uint16_t>(handleInfo->handleType);
+    fcn.setExtraDestData(valueCount);
+    fcn.actionTime = window;
+    fed->setProperties(fcn);
+}
+
 int32_t CommonCore::getHandleOption(InterfaceHandle handle, int32_t option) const
 {
     const auto* handleInfo = getHandleInfo(handle);
@@ -1184,6 +1308,7 @@ void CommonCore::closeHandle(InterfaceHandle handle)
     if (checkActionFlag(*handleInfo, disconnected_flag)) {
         return;
     }
+    flushStagedRegistrations(getFederateAt(handleInfo->local_fed_id));
     ActionMessage cmd(CMD_CLOSE_INTERFACE);
     cmd.setSource(handleInfo->handle);
     cmd.messageID = static_cast<int32_t>(handleInfo->handleType);
@@ -1204,6 +1329,7 @@ void CommonCore::removeTarget(InterfaceHandle handle, std::string_view targetToR
     cmd.name(targetToRemove);
     auto* fed = getFederateAt(handleInfo->local_fed_id);
     if (fed != nullptr) {
+        flushStagedRegistrations(fed);
         cmd.actionTime = fed->grantedTime();
     }
     switch (handleInfo->handleType) {
@@ -1234,6 +1360,8 @@ void CommonCore::addDestinationTarget(InterfaceHandle handle,
     if (handleInfo == nullptr) {
         throw(InvalidIdentifier("invalid handle"));
     }
+    // the target refers to the handle so its registration has to be processed first
+    flushStagedRegistrations(getFederateAt(handleInfo->local_fed_id));
     ActionMessage cmd;
     cmd.setSource(handleInfo->handle);
     cmd.flags = handleInfo->flags;
@@ -1284,6 +1412,8 @@ void CommonCore::addSourceTarget(InterfaceHandle handle,
     if (handleInfo == nullptr) {
         throw(InvalidIdentifier("invalid handle"));
     }
+    // the target refers to the handle so its registration has to be processed first
+    flushStagedRegistrations(getFederateAt(handleInfo->local_fed_id));
     ActionMessage cmd;
     cmd.setSource(handleInfo->handle);
     cmd.flags = handleInfo->flags;
@@ -1399,6 +1529,7 @@ void CommonCore::setValue(InterfaceHandle handle, const char* data, uint64_t len
         return;  // if the value is not required do nothing
     }
     auto* fed = getFederateAt(handleInfo->local_fed_id);
+    applyMemoryBackpressure(fed);
     if (fed->checkAndSetValue(handle, data, len)) {
         if (fed->loggingLevel() >= HELICS_LOG_LEVEL_DATA) {
             fed->logMessage(HELICS_LOG_LEVEL_DATA,
@@ -1409,6 +1540,9 @@ void CommonCore::setValue(InterfaceHandle handle, const char* data, uint64_t len
         if (subs.empty()) {
             return;
         }
+        // values between members of a federate group skip the core queue and go straight to the
+        // receiving federate
+        const auto group = fed->getFederateGroup();
         if (subs.size() == 1) {
             ActionMessage mv(CMD_PUB);
             mv.source_id = handleInfo->getFederateId();
@@ -1417,7 +1551,13 @@ void CommonCore::setValue(InterfaceHandle handle, const char* data, uint64_t len
             mv.counter = static_cast<uint16_t>(fed->getCurrentIteration());
             mv.payload.assign(data, len);
             mv.actionTime = fed->nextAllowedSendTime();
-            actionQueue.push(std::move(mv));
+            auto* peer = (group != 0) ? getGroupPeer(group, subs[0].fed_id) : nullptr;
+            if (peer != nullptr) {
+                peer->addAction(std::move(mv));
+                ++groupDeliveries;
+            } else {
+                pushAction(std::move(mv));
+            }
             return;
         }
         ActionMessage package(CMD_MULTI_MESSAGE);
@@ -1433,17 +1573,104 @@ void CommonCore::setValue(InterfaceHandle handle, const char* data, uint64_t len
 
         for (auto& target : subs) {
             mv.setDestination(target);
+            if (group != 0) {
+                auto* peer = getGroupPeer(group, target.fed_id);
+                if (peer != nullptr) {
+                    peer->addAction(mv);
+                    ++groupDeliveries;
+                    continue;
+                }
+            }
             auto res = appendMessage(package, mv);
             if (res < 0)  // deal with max package size if there are a lot of subscribers
             {
-                actionQueue.push(std::move(package));
+                pushAction(std::move(package));
                 package = ActionMessage(CMD_MULTI_MESSAGE);
                 package.source_id = handleInfo->getFederateId();
                 package.source_handle = handle;
                 appendMessage(package, mv);
             }
         }
-        actionQueue.push(std::move(package));
+        if (package.counter > 0) {
+            pushAction(std::move(package));
+        }
+    }
+}
+
+void CommonCore::setValues(LocalFederateId federateID,
+                           const std::vector<std::pair<InterfaceHandle, SmallBuffer>>& values)
+{
+    auto* fed = getFederateAt(federateID);
+    if (fed == nullptr) {
+        throw(InvalidIdentifier("federateID not valid (setValues)"));
+    }
+    if (values.empty()) {
+        return;
+    }
+    std::vector<const BasicHandleInfo*> infos(values.size(), nullptr);
+    handles.read([&values, &infos](auto& hand) {
+        for (std::size_t ii = 0; ii < values.size(); ++ii) {
+            infos[ii] = hand.getHandleInfo(values[ii].first.baseValue());
+        }
+    });
+    std::vector<bool> active(values.size(), false);
+    for (std::size_t ii = 0; ii < values.size(); ++ii) {
+        if (infos[ii] == nullptr) {
+            throw(InvalidIdentifier("Handle not valid (setValues)"));
+        }
+        if (infos[ii]->local_fed_id != federateID) {
+            throw(InvalidIdentifier("handle does not belong to the federate (setValues)"));
+        }
+        if (infos[ii]->handleType != InterfaceType::PUBLICATION) {
+            throw(InvalidIdentifier("handle does not point to a publication"));
+        }
+        active[ii] = infos[ii]->used && !checkActionFlag(*infos[ii], disconnected_flag);
+    }
+    applyMemoryBackpressure(fed);
+    auto subscribers = fed->checkAndGetSubscribers(values, active);
+    if (fed->loggingLevel() >= HELICS_LOG_LEVEL_DATA) {
+        fed->logMessage(HELICS_LOG_LEVEL_DATA,
+                        fed->getIdentifier(),
+                        fmt::format("setting batch of {} values", values.size()));
+    }
+    const auto group = fed->getFederateGroup();
+    const auto iteration = static_cast<uint16_t>(fed->getCurrentIteration());
+    const auto sendTime = fed->nextAllowedSendTime();
+    // one package per destination federate so each destination is handled in a single pass
+    std::map<GlobalFederateId, ActionMessage> packages;
+    for (std::size_t ii = 0; ii < values.size(); ++ii) {
+        if (subscribers[ii].empty()) {
+            continue;
+        }
+        ActionMessage mv(CMD_PUB);
+        mv.source_id = infos[ii]->getFederateId();
+        mv.source_handle = values[ii].first;
+        mv.counter = iteration;
+        mv.payload = values[ii].second;
+        mv.actionTime = sendTime;
+        for (auto& target : subscribers[ii]) {
+            mv.setDestination(target);
+            auto* peer = (group != 0) ? getGroupPeer(group, target.fed_id) : nullptr;
+            if (peer != nullptr) {
+                peer->addAction(mv);
+                ++groupDeliveries;
+                continue;
+            }
+            auto pkg = packages.find(target.fed_id);
+            if (pkg == packages.end()) {
+                pkg = packages.emplace(target.fed_id, ActionMessage(CMD_MULTI_MESSAGE)).first;
+                pkg->second.source_id = mv.source_id;
+            }
+            if (appendPackedMessage(pkg->second, mv) < 0) {
+                pushAction(std::move(pkg->second));
+                pkg->second = ActionMessage(CMD_MULTI_MESSAGE);
+                pkg->second.source_id = mv.source_id;
+                appendPackedMessage(pkg->second, mv);
+            }
+        }
+    }
+    for (auto& pkg : packages) {
+        pushAction(std::move(pkg.second));
     }
 }
 
@@ -1463,6 +1690,22 @@ const std::shared_ptr<const SmallBuffer>& CommonCore::getValue(InterfaceHandle h
     return fed.getValue(handle, inputIndex);
 }
 
+const std::shared_ptr<const SmallBuffer>&
+    CommonCore::getValueAt(InterfaceHandle handle, Time valueTime, uint32_t* inputIndex)
+{
+    const auto* handleInfo = getHandleInfo(handle);
+    if (handleInfo == nullptr) {
+        throw(InvalidIdentifier("Handle is invalid (getValueAt)"));
+    }
+
+    if (handleInfo->handleType != InterfaceType::INPUT) {
+        throw(InvalidIdentifier("Handle does not identify an input"));
+    }
+    auto& fed = *getFederateAt(handleInfo->local_fed_id);
+    std::lock_guard<FederateState> lk(fed);
+    return fed.getValueAt(handle, valueTime, inputIndex);
+}
+
 const std::vector<std::shared_ptr<const SmallBuffer>>&
     CommonCore::getAllValues(InterfaceHandle handle)
 {
@@ -1488,6 +1731,15 @@ const std::vector<InterfaceHandle>& CommonCore::getValueUpdates(LocalFederateId
     return fed->getEvents();
 }
 
+const std::vector<ValueUpdate>& CommonCore::getValueSnapshot(LocalFederateId federateID)
+{
+    auto* fed = getFederateAt(federateID);
+    if (fed == nullptr) {
+        throw(InvalidIdentifier("federateID not valid (getValueSnapshot)"));
+    }
+    return fed->getValueSnapshot();
+}
+
 InterfaceHandle CommonCore::registerEndpoint(LocalFederateId federateID,
                                              const std::string& name,
                                              const std::string& type)
@@ -1496,27 +1748,21 @@ InterfaceHandle CommonCore::registerEndpoint(LocalFederateId federateID,
     if (fed == nullptr) {
         throw(InvalidIdentifier("federateID not valid (registerEndpoint)"));
     }
-    const auto* ept = handles.read([&name](auto& hand) { return hand.getEndpoint(name); });
-    if (ept != nullptr) {
+    const auto* handle = createUniqueHandle(
+        *fed, InterfaceType::ENDPOINT, name, type, std::string{}, fed->getInterfaceFlags());
+    if (handle == nullptr) {
         throw(RegistrationFailure("endpoint name is already used"));
     }
-    const auto& handle = createBasicHandle(fed->global_id,
-                                           fed->local_id,
-                                           InterfaceType::ENDPOINT,
-                                           name,
-                                           type,
-                                           std::string{},
-                                           fed->getInterfaceFlags());
 
-    auto id = handle.getInterfaceHandle();
+    auto id = handle->getInterfaceHandle();
     fed->createInterface(InterfaceType::ENDPOINT, id, name, type, emptyStr);
     ActionMessage m(CMD_REG_ENDPOINT);
     m.source_id = fed->global_id.load();
     m.source_handle = id;
     m.name(name);
     m.setStringData(type);
-    m.flags = handle.flags;
-    actionQueue.push(std::move(m));
+    m.flags = handle->flags;
+    queueRegistration(fed, std::move(m));
 
     return id;
 }
@@ -1529,24 +1775,23 @@ InterfaceHandle CommonCore::registerTargetedEndpoint(LocalFederateId federateID,
     if (fed == nullptr) {
         throw(InvalidIdentifier("federateID not valid (registerEndpoint)"));
     }
-    const auto* ept = handles.read([&name](auto& hand) { return hand.getEndpoint(name); });
-    if (ept != nullptr) {
-        throw(RegistrationFailure("endpoint name is already used"));
-    }
     auto flags = fed->getInterfaceFlags();
     flags |= (1U << targetted_flag);
-    const auto& handle = createBasicHandle(
-        fed->global_id, fed->local_id, InterfaceType::ENDPOINT, name, type, std::string{}, flags);
+    const auto* handle =
+        createUniqueHandle(*fed, InterfaceType::ENDPOINT, name, type, std::string{}, flags);
+    if (handle == nullptr) {
+        throw(RegistrationFailure("endpoint name is already used"));
+    }
 
-    auto id = handle.getInterfaceHandle();
+    auto id = handle->getInterfaceHandle();
     fed->createInterface(InterfaceType::ENDPOINT, id, name, type, emptyStr);
     ActionMessage m(CMD_REG_ENDPOINT);
     m.source_id = fed->global_id.load();
     m.source_handle = id;
     m.name(name);
     m.setStringData(type);
-    m.flags = handle.flags;
-    actionQueue.push(std::move(m));
+    m.flags = handle->flags;
+    queueRegistration(fed, std::move(m));
 
     return id;
 }
@@ -1592,7 +1837,7 @@ InterfaceHandle CommonCore::registerFilter(const std::string& filterName,
     if ((!type_in.empty()) || (!type_out.empty())) {
         m.setStringData(type_in, type_out);
     }
-    actionQueue.push(std::move(m));
+    pushAction(std::move(m));
     return id;
 }
 
@@ -1635,7 +1880,7 @@ InterfaceHandle CommonCore::registerCloningFilter(const std::string& filterName,
     if ((!type_in.empty()) || (!type_out.empty())) {
         m.setStringData(type_in, type_out);
     }
-    actionQueue.push(std::move(m));
+    pushAction(std::move(m));
     return id;
 }
 
@@ -1720,6 +1965,8 @@ void CommonCore::sendTo(InterfaceHandle sourceHandle,
         throw(InvalidFunctionCall("targeted endpoints may not specify a destination"));
     }
     auto* fed = getFederateAt(hndl->local_fed_id);
+    applyMemoryBackpressure(fed);
+    acquireMessageCredit(fed, GlobalHandle{}, destination);
     ActionMessage m(CMD_SEND_MESSAGE);
 
     m.messageID = ++messageCounter;
@@ -1750,6 +1997,8 @@ void CommonCore::sendToAt(InterfaceHandle sourceHandle,
         throw(InvalidFunctionCall("targeted endpoints may not specify a destination"));
     }
     auto* fed = getFederateAt(hndl->local_fed_id);
+    applyMemoryBackpressure(fed);
+    acquireMessageCredit(fed, GlobalHandle{}, destination);
     ActionMessage m(CMD_SEND_MESSAGE);
 
     m.messageID = ++messageCounter;
@@ -1773,7 +2022,7 @@ void CommonCore::generateMessages(
     if (targets.size() == 1) {
         message.setDestination(targets.front().first);
         message.setString(0, targets.front().second);
-        actionQueue.push(std::move(message));
+        pushAction(std::move(message));
         return;
     }
     /** now generate a multimessage*/
@@ -1787,14 +2036,14 @@ void CommonCore::generateMessages(
         auto res = appendMessage(package, message);
         if (res < 0)  // deal with max package size if there are a lot of subscribers
         {
-            actionQueue.push(std::move(package));
+            pushAction(std::move(package));
             package = ActionMessage(CMD_MULTI_MESSAGE);
             package.source_id = message.source_id;
             package.source_handle = message.source_handle;
             appendMessage(package, message);
         }
     }
-    actionQueue.push(std::move(package));
+    pushAction(std::move(package));
 }
 
 void CommonCore::send(InterfaceHandle sourceHandle, const void* data, uint64_t length)
@@ -1811,6 +2060,12 @@ void CommonCore::send(InterfaceHandle sourceHandle, const void* data, uint64_t l
     if (targets.empty()) {
         return;
     }
+    applyMemoryBackpressure(fed);
+    if (!messageCredits.empty()) {
+        for (const auto& target : targets) {
+            acquireMessageCredit(fed, target.first, target.second);
+        }
+    }
 
     ActionMessage m(CMD_SEND_MESSAGE);
     m.source_handle = sourceHandle;
@@ -1836,6 +2091,12 @@ void CommonCore::sendAt(InterfaceHandle sourceHandle, const void* data, uint64_t
     if (targets.empty()) {
         return;
     }
+    applyMemoryBackpressure(fed);
+    if (!messageCredits.empty()) {
+        for (const auto& target : targets) {
+            acquireMessageCredit(fed, target.first, target.second);
+        }
+    }
 
     ActionMessage m(CMD_SEND_MESSAGE);
     m.source_handle = sourceHandle;
@@ -1877,6 +2138,7 @@ void CommonCore::sendMessage(InterfaceHandle sourceHandle, std::unique_ptr<Messa
         m.messageID = ++messageCounter;
     }
     auto* fed = getFederateAt(hndl->local_fed_id);
+    acquireMessageCredit(fed, m.getDest(), m.getString(targetStringLoc));
     auto minTime = fed->nextAllowedSendTime();
     if (m.actionTime < minTime) {
         m.actionTime = minTime;
@@ -1890,6 +2152,72 @@ void CommonCore::sendMessage(InterfaceHandle sourceHandle, std::unique_ptr<Messa
     addActionMessage(std::move(m));
 }
 
+void CommonCore::acquireMessageCredit(FederateState* fed,
+                                      GlobalHandle destination,
+                                      std::string_view name)
+{
+    if (messageCredits.empty() || fed == nullptr) {
+        return;
+    }
+    if (!destination.isValid()) {
+        destination = messageCredits.findEndpoint(name);
+        if (!destination.isValid()) {
+            return;
+        }
+    }
+    if (!messageCredits.acquire(fed->global_id.load(), destination, creditTimeout.to_ms())) {
+        fed->logMessage(HELICS_LOG_LEVEL_WARNING,
+                        "",
+                        fmt::format("endpoint {} has not consumed messages within {}ms, sending "
+                                    "messages beyond its receive capacity until it does",
+                                    name,
+                                    creditTimeout.to_ms().count()));
+    }
+}
+
+void CommonCore::applyMemoryBackpressure(FederateState* fed)
+{
+    if ((!memoryLimitExceeded.load() && !transmitBacklogged()) || isQueueProcessingThread()) {
+        return;
+    }
+    // give the processing loop and transmitter a bounded window to drain before accepting more
+    // data
+    constexpr int maxWaitPeriods{50};
+    int waitPeriods{0};
+    while ((!memoryLimitCleared() || transmitBacklogged()) && waitPeriods < maxWaitPeriods) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        ++waitPeriods;
+    }
+    if (waitPeriods < maxWaitPeriods || fed == nullptr) {
+        return;
+    }
+    // warn once per interval instead of on every held call
+    constexpr std::chrono::seconds warningInterval{10};
+    const auto now = std::chrono::steady_clock::now().time_since_epoch().count();
+    auto lastWarning = lastMemoryWarning.load();
+    if ((lastWarning == 0 ||
+         std::chrono::steady_clock::duration(now - lastWarning) >= warningInterval) &&
+        lastMemoryWarning.compare_exchange_strong(lastWarning, now)) {
+        fed->logMessage(HELICS_LOG_LEVEL_WARNING,
+                        "",
+                        (transmitBacklogged()) ?
+                            std::string("transmit queue above its data limit, continuing to "
+                                        "queue data") :
+                            fmt::format("core memory above the limit of {} bytes, continuing to "
+                                        "queue data",
+                                        memoryLimit));
+    }
+}
+
+std::uint64_t CommonCore::interfaceMemory() const
+{
+    std::uint64_t bytes{0};
+    for (const auto& fed : loopFederates) {
+        bytes += fed->bufferedMemory();
+    }
+    return bytes;
+}
+
 void CommonCore::deliverMessage(ActionMessage& message)
 {
     switch (message.action()) {
@@ -1899,15 +2227,31 @@ void CommonCore::deliverMessage(ActionMessage& message)
                 loopHandles.getEndpoint(message.getString(targetStringLoc)) :
                 loopHandles.findHandle(message.getDest());
             if (localP == nullptr) {
-                auto kfnd = knownExternalEndpoints.find(message.getString(targetStringLoc));
-                if (kfnd != knownExternalEndpoints.end()) {  // destination is known
-                    transmit(kfnd->second, message);
-                } else {
-                    transmit(parent_route_id, message);
+                if (message.dest_id == parent_broker_id) {
+                    auto kfnd = knownExternalEndpoints.find(message.getString(targetStringLoc));
+                    if (kfnd == knownExternalEndpoints.end()) {
+                        // the broker resolves the name and sends back the handle
+                        transmit(parent_route_id, message);
+                        return;
+                    }
+                    message.setDestination(kfnd->second);
                 }
+                compactEndpointNames(message);
+                transmit(getRoute(message.dest_id), message);
                 return;
             }
             // now we deal with local processing
+            if (message.dest_id != parent_broker_id && checkActionFlag(*localP, disconnected_flag) &&
+                !isLocal(message.source_id)) {
+                // the sending core has a stale handle so tell it to go back to the name
+                ActionMessage stale(CMD_ENDPOINT_RESOLVED);
+                setActionFlag(stale, disconnected_flag);
+                stale.setSource(localP->handle);
+                stale.dest_id = message.source_id;
+                stale.payload = localP->key;
+                transmit(getRoute(stale.dest_id), stale);
+            }
+            restoreEndpointNames(message, localP->key);
             if (checkActionFlag(*localP, has_dest_filter_flag)) {
                 if (!filterFed->destinationProcessMessage(message, localP)) {
                     return;
@@ -2004,7 +2348,7 @@ void CommonCore::logMessage(LocalFederateId federateID,
     m.dest_id = gid;
     m.messageID = logLevel;
     m.payload = messageToLog;
-    actionQueue.push(m);
+    pushAction(m);
 }
 
 void CommonCore::setLoggingLevel(int logLevel)
@@ -2056,7 +2400,7 @@ void CommonCore::setLoggingCallback(
             setActionFlag(loggerUpdate, empty_flag);
         }
 
-        actionQueue.push(loggerUpdate);
+        pushAction(loggerUpdate);
     } else {
         auto* fed = getFederateAt(federateID);
         if (fed == nullptr) {
@@ -2106,7 +2450,7 @@ void CommonCore::setFilterOperator(InterfaceHandle filter, std::shared_ptr<Filte
     filtOpUpdate.counter = ii;
     filtOpUpdate.source_id = hndl->getFederateId();
     filtOpUpdate.source_handle = filter;
-    actionQueue.push(filtOpUpdate);
+    pushAction(filtOpUpdate);
 }
 
 void CommonCore::setIdentifier(const std::string& name)
@@ -2202,7 +2546,7 @@ std::string CommonCore::quickCoreQueries(const std::string& queryStr) const
 {
     if ((queryStr == "queries") || (queryStr == "available_queries")) {
         return "[\"isinit\",\"isconnected\",\"exists\",\"name\",\"identifier\",\"address\",\"queries\",\"address\",\"federates\",\"inputs\",\"endpoints\",\"filtered_endpoints\","
-               "\"publications\",\"filters\",\"tags\",\"version\",\"version_all\",\"federate_map\",\"dependency_graph\",\"data_flow_graph\",\"dependencies\",\"dependson\",\"dependents\",\"current_time\",\"global_time\",\"global_state\",\"global_flush\",\"current_state\"]";
+               "\"publications\",\"filters\",\"tags\",\"version\",\"version_all\",\"federate_map\",\"dependency_graph\",\"data_flow_graph\",\"dependencies\",\"dependson\",\"dependents\",\"current_time\",\"global_time\",\"global_state\",\"global_flush\",\"current_state\",\"federate_groups\",\"queues\",\"queue_latency\",\"compression\",\"memory\"]";
     }
     if (queryStr == "isconnected") {
         return (isConnected()) ? "true" : "false";
@@ -2239,6 +2583,14 @@ void CommonCore::loadBasicJsonInfo(
     }
 }
 
+void CommonCore::generateQueueLatency(Json::Value& base) const
+{
+    loadBasicJsonInfo(base, [](Json::Value& val, const FedInfo& fed) {
+        fed->getQueueLatency().generateJson(val["federate_queue"]);
+    });
+    BrokerBase::generateQueueLatency(base);
+}
+
 void CommonCore::initializeMapBuilder(const std::string& request,
                                       std::uint16_t index,
                                       bool reset,
@@ -2433,6 +2785,45 @@ std::string CommonCore::coreQuery(const std::string& queryStr, bool force_orderi
         }
         return timeCoord->printTimeStatus();
     }
+    if (queryStr == "federate_groups") {
+        Json::Value base;
+        loadBasicJsonInfo(base, [](Json::Value& val, const FedInfo& fed) {
+            val["group"] = fed.fed->getFederateGroup();
+        });
+        base["direct_deliveries"] = static_cast<Json::UInt64>(groupDeliveries.load());
+        return fileops::generateJsonString(base);
+    }
+    if (queryStr == "queues") {
+        Json::Value base;
+        loadBasicJsonInfo(base,
+                          [](Json::Value& val, const FedInfo& fed) { fed->generateQueueInfo(val); });
+        base["action_queue"] = static_cast<Json::UInt64>(actionQueue.size());
+        return fileops::generateJsonString(base);
+    }
+    if (queryStr == "memory") {
+        Json::Value base;
+        std::uint64_t total{0};
+        loadBasicJsonInfo(base, [&total](Json::Value& val, const FedInfo& fed) {
+            total += fed->generateMemoryInfo(val);
+        });
+        total += generateMemoryUsage(base);
+        const auto handleBytes = handles.lock_shared()->memoryUsage();
+        base["handles"] = static_cast<Json::UInt64>(handleBytes);
+        total += handleBytes;
+        base["total"] = static_cast<Json::UInt64>(total);
+        return fileops::generateJsonString(base);
+    }
+    if (queryStr == "queue_latency") {
+        Json::Value base;
+        generateQueueLatency(base);
+        return fileops::generateJsonString(base);
+    }
+    if (queryStr == "compression") {
+        Json::Value base;
+        base["name"] = getIdentifier();
+        generateCompressionStats(base);
+        return fileops::generateJsonString(base);
+    }
     if (queryStr == "version_all") {
         Json::Value base;
         loadBasicJsonInfo(base, [](Json::Value& /*val*/, const FedInfo& /*fed*/) {});
@@ -2730,6 +3121,12 @@ void CommonCore::processPriorityCommand(ActionMessage&& command)
                 if (checkActionFlag(command, slow_responding_flag)) {
                     timeoutMon->disableParentPing();
                 }
+                if (enable_compression && checkActionFlag(command, compression_flag)) {
+                    setRouteCompression(parent_route_id, true);
+                }
+                if (checkActionFlag(command, payload_frames_flag)) {
+                    enableRoutePayloadFrames(parent_route_id);
+                }
                 timeoutMon->reset();
                 if (delayInitCounter < 0 && minFederateCount == 0 && minChildCount == 0) {
                     if (allInitReady()) {
@@ -2759,9 +3156,15 @@ void CommonCore::processPriorityCommand(ActionMessage&& command)
                 } else {
                     fed->global_id = command.dest_id;
                     loopFederates.addSearchTerm(command.dest_id, std::string(command.name()));
+                    localFederateIds.modify(
+                        [fed, id = command.dest_id](auto& ids) { ids.emplace(id, fed); });
                     if (!keyFed.isValid()) {
                         keyFed = fed->global_id;
                     }
+                    // a quantum from higher in the hierarchy takes precedence
+                    if (command.actionTime <= timeZero) {
+                        command.actionTime = timeQuantum;
+                    }
                 }
 
                 // push the command to the local queue
@@ -3347,8 +3750,28 @@ void CommonCore::processCommand(ActionMessage&& command)
             }
             break;
         case CMD_SET_PROFILER_FLAG:
+        case CMD_INTERFACE_CONFIGURE:
             routeMessage(command);
             break;
+        case CMD_ENDPOINT_RESOLVED:
+            // brokers route these to the core of the sender so they stop here
+            if (checkActionFlag(command, disconnected_flag)) {
+                removeKnownExternalEndpoints(command.getSource());
+            } else {
+                knownExternalEndpoints[command.payload.to_string()] = command.getSource();
+            }
+            break;
+        case CMD_ENDPOINT_CREDIT:
+            if (isLocal(command.dest_id)) {
+                messageCredits.updateCredits(command.dest_id,
+                                             command.getSource(),
+                                             command.payload.to_string(),
+                                             static_cast<int32_t>(command.sequenceID),
+                                             command.messageID);
+            } else {
+                routeMessage(command);
+            }
+            break;
         default:
             if (isPriorityCommand(command)) {
                 // this is a backup if somehow one of these message got here
@@ -3672,8 +4095,25 @@ void CommonCore::removeNamedTarget(ActionMessage& command)
     }
 }
 
+void CommonCore::removeKnownExternalEndpoints(GlobalHandle endpoint)
+{
+    const bool allEndpoints = !endpoint.handle.isValid();
+    for (auto it = knownExternalEndpoints.begin(); it != knownExternalEndpoints.end();) {
+        if (it->second.fed_id == endpoint.fed_id &&
+            (allEndpoints || it->second.handle == endpoint.handle)) {
+            it = knownExternalEndpoints.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
 void CommonCore::disconnectInterface(ActionMessage& command)
 {
+    if (command.source_id != filterFedID.load() && !isLocal(command.source_id)) {
+        removeKnownExternalEndpoints(command.getSource());
+        return;
+    }
     auto* handleInfo = loopHandles.getHandleInfo(command.source_handle);
     if (handleInfo == nullptr) {
         return;
@@ -3785,24 +4225,24 @@ void CommonCore::processQueryResponse(const ActionMessage& m)
         auto& builder = std::get<0>(mapBuilders[m.counter]);
         auto& requestors = std::get<1>(mapBuilders[m.counter]);
         if (builder.addComponent(std::string(m.payload.to_string()), m.messageID)) {
-            auto str = builder.generate();
+            MapBuilderResult result(builder, !useJsonSerialization);
             if (m.counter == GLOBAL_FLUSH) {
-                str = "{\"status\":true}";
+                result.setJson("{\"status\":true}");
             }
             for (int ii = 0; ii < static_cast<int>(requestors.size()) - 1; ++ii) {
                 if (requestors[ii].dest_id == global_broker_id_local) {
-                    activeQueries.setDelayedValue(requestors[ii].messageID, str);
+                    activeQueries.setDelayedValue(requestors[ii].messageID, result.json());
                 } else {
-                    requestors[ii].payload = str;
+                    requestors[ii].payload = result.forRequestor(requestors[ii]);
                     routeMessage(std::move(requestors[ii]));
                 }
             }
             if (requestors.back().dest_id == global_broker_id_local ||
                 requestors.back().dest_id == direct_core_id) {
                 // TODO(PT) make setDelayedValue have move set function
-                activeQueries.setDelayedValue(requestors.back().messageID, str);
+                activeQueries.setDelayedValue(requestors.back().messageID, result.json());
             } else {
-                requestors.back().payload = std::move(str);
+                requestors.back().payload = result.forRequestor(requestors.back());
                 routeMessage(std::move(requestors.back()));
             }
 
@@ -3977,6 +4417,9 @@ void CommonCore::processDisconnectCommand(ActionMessage& cmd)
             break;
         case CMD_DISCONNECT:
         case CMD_DISCONNECT_FED:
+            if (!isLocal(cmd.source_id)) {
+                removeKnownExternalEndpoints(GlobalHandle{cmd.source_id, InterfaceHandle{}});
+            }
             if (cmd.dest_id == parent_broker_id) {
                 if (getBrokerState() < BrokerState::terminating) {
                     auto fed = loopFederates.find(cmd.source_id);
@@ -3984,6 +4427,7 @@ void CommonCore::processDisconnectCommand(ActionMessage& cmd)
                         return;
                     }
                     fed->state = operation_state::disconnected;
+                    removeLocalFederateId(cmd.source_id);
                     auto cstate = getBrokerState();
                     if ((!checkAndProcessDisconnect()) || (cstate < BrokerState::operating)) {
                         cmd.setAction(CMD_DISCONNECT_FED);
@@ -4388,20 +4832,20 @@ void CommonCore::checkInFlightQueriesForDisconnect()
             return;
         }
         if (builder.clearComponents()) {
-            auto str = builder.generate();
+            MapBuilderResult result(builder, !useJsonSerialization);
             for (int ii = 0; ii < static_cast<int>(requestors.size()) - 1; ++ii) {
                 if (requestors[ii].dest_id == global_broker_id_local) {
-                    activeQueries.setDelayedValue(requestors[ii].messageID, str);
+                    activeQueries.setDelayedValue(requestors[ii].messageID, result.json());
                 } else {
-                    requestors[ii].payload = str;
+                    requestors[ii].payload = result.forRequestor(requestors[ii]);
                     routeMessage(std::move(requestors[ii]));
                 }
             }
             if (requestors.back().dest_id == global_broker_id_local) {
                 // TODO(PT) add rvalue reference method
-                activeQueries.setDelayedValue(requestors.back().messageID, str);
+                activeQueries.setDelayedValue(requestors.back().messageID, result.json());
             } else {
-                requestors.back().payload = std::move(str);
+                requestors.back().payload = result.forRequestor(requestors.back());
                 routeMessage(std::move(requestors.back()));
             }
 
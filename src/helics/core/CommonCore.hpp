@@ -11,7 +11,9 @@ SPDX-License-Identifier: BSD-3-Clause
 #include "ActionMessage.hpp"
 #include "BrokerBase.hpp"
 #include "Core.hpp"
+#include "DenseRoutingTable.hpp"
 #include "HandleManager.hpp"
+#include "MessageCreditTable.hpp"
 #include "gmlc/concurrency/DelayedObjects.hpp"
 #include "gmlc/concurrency/TriggerVariable.hpp"
 #include "gmlc/containers/AirLock.hpp"
@@ -146,6 +148,9 @@ class CommonCore: public Core, public BrokerBase {
                                  int32_t option_value) override final;
 
     virtual int32_t getHandleOption(InterfaceHandle handle, int32_t option) const override final;
+    virtual void setInputTolerance(InterfaceHandle handle, double tolerance) override final;
+    virtual void
+        setInputRetention(InterfaceHandle handle, int32_t valueCount, Time window) override final;
     virtual void closeHandle(InterfaceHandle handle) override final;
     virtual void removeTarget(InterfaceHandle handle,
                               std::string_view targetToRemove) override final;
@@ -163,12 +168,19 @@ class CommonCore: public Core, public BrokerBase {
     virtual const std::string& getInjectionType(InterfaceHandle handle) const override final;
     virtual const std::string& getExtractionType(InterfaceHandle handle) const override final;
     virtual void setValue(InterfaceHandle handle, const char* data, uint64_t len) override final;
+    virtual void
+        setValues(LocalFederateId federateID,
+                  const std::vector<std::pair<InterfaceHandle, SmallBuffer>>& values) override final;
     virtual const std::shared_ptr<const SmallBuffer>& getValue(InterfaceHandle handle,
                                                                uint32_t* inputIndex) override final;
+    virtual const std::shared_ptr<const SmallBuffer>&
+        getValueAt(InterfaceHandle handle, Time valueTime, uint32_t* inputIndex) override final;
     virtual const std::vector<std::shared_ptr<const SmallBuffer>>&
         getAllValues(InterfaceHandle handle) override final;
     virtual const std::vector<InterfaceHandle>&
         getValueUpdates(LocalFederateId federateID) override final;
+    virtual const std::vector<ValueUpdate>&
+        getValueSnapshot(LocalFederateId federateID) override final;
     virtual InterfaceHandle registerEndpoint(LocalFederateId federateID,
                                              const std::string& name,
                                              const std::string& type) override final;
@@ -336,6 +348,8 @@ class CommonCore: public Core, public BrokerBase {
     operation_state minFederateState() const;
 
     virtual double getSimulationTime() const override;
+    virtual void generateQueueLatency(Json::Value& base) const override;
+    virtual std::uint64_t interfaceMemory() const override;
 
   private:
     /** get the federate Information from the federateID*/
@@ -346,19 +360,24 @@ class CommonCore: public Core, public BrokerBase {
     @param handle an identifier as generated by the one of the functions
     @return the federateState pointer object*/
     FederateState* getHandleFederateCore(InterfaceHandle handle);
+    /** get a local federate in the same federate group that can accept values directly
+    @details threadsafe, returns nullptr if the federate is not local, not part of the group, or is
+    not in a state to accept direct delivery.  Groups only change how values are delivered, the
+    members keep their own time coordinators*/
+    FederateState* getGroupPeer(int32_t group, GlobalFederateId federateID) const;
+    /** remove a federate from the direct delivery lookup once it finalizes or disconnects*/
+    void removeLocalFederateId(GlobalFederateId federateID);
 
   private:
     std::atomic<double> simTime{BrokerBase::mInvalidSimulationTime};
     GlobalFederateId keyFed{};
     std::string prevIdentifier;  //!< storage for the case of requiring a renaming
-    std::map<GlobalFederateId, route_id>
-        routing_table;  //!< map for external routes  <global federate id, route id>
+    DenseRoutingTable routing_table;  //!< table for external routes  <global federate id, route id>
     gmlc::containers::SimpleQueue<ActionMessage>
         delayTransmitQueue;  //!< FIFO queue for transmissions to the root that need to be delayed
                              //!< for a certain time
-    std::unordered_map<std::string, route_id>
-        knownExternalEndpoints;  //!< external map for all known external endpoints with names and
-                                 //!< route
+    /// handles of external endpoints resolved by a broker for messages sent by name
+    std::unordered_map<std::string, GlobalHandle> knownExternalEndpoints;
     std::vector<std::pair<std::string, std::string>> tags;  //!< storage for user defined tags
     std::unique_ptr<TimeoutMonitor>
         timeoutMon;  //!< class to handle timeouts and disconnection notices
@@ -437,10 +456,18 @@ class CommonCore: public Core, public BrokerBase {
     shared_guarded<gmlc::containers::MappedPointerVector<FederateState, std::string>> federates;
     /** federate pointers stored for the core loop */
     gmlc::containers::DualMappedVector<FedInfo, std::string, GlobalFederateId> loopFederates;
+    /** threadsafe lookup of local federates by global id, used for direct group delivery*/
+    ordered_guarded<std::unordered_map<GlobalFederateId, FederateState*>> localFederateIds;
+    /// the number of values delivered directly between members of a federate group
+    std::atomic<std::uint64_t> groupDeliveries{0};
+    /// the time of the last warning about data held by the memory limit
+    std::atomic<std::chrono::steady_clock::rep> lastMemoryWarning{0};
 
     /** counter for the number of messages that have been sent, nothing magical about 54 just a
      * number bigger than 1 to prevent confusion */
     std::atomic<int32_t> messageCounter{54};
+    /// windows advertised by endpoints with a limited receive capacity
+    MessageCreditTable messageCredits;
     ordered_guarded<HandleManager> handles;  //!< local handle information;
     HandleManager loopHandles;  //!< copy of handles to use in the primary processing loop without
                                 //!< thread protection
@@ -481,6 +508,14 @@ class CommonCore: public Core, public BrokerBase {
                           const std::vector<std::pair<GlobalHandle, std::string_view>>& targets);
     /** deliver a message to the appropriate location*/
     void deliverMessage(ActionMessage& message);
+    /** wait for a credit to send a message from a federate to a destination endpoint
+    @param fed the sending federate
+    @param destination the handle of the destination if known
+    @param name the name of the destination used if the handle is not known*/
+    void acquireMessageCredit(FederateState* fed, GlobalHandle destination, std::string_view name);
+    /** hold a data producing call for a bounded time while the core is above its memory limit or
+    the comms have more data waiting than the transmit limit*/
+    void applyMemoryBackpressure(FederateState* fed);
     /** function to deal with a source filters*/
     ActionMessage& processMessage(ActionMessage& message);
     /** add a new handle to the generic structure
@@ -494,6 +529,19 @@ class CommonCore: public Core, public BrokerBase {
                                              const std::string& units,
                                              uint16_t flags = 0);
 
+    /** check for an existing interface with the same name and add the handle under a single lock
+    @return nullptr if an interface of the same type and name already exists*/
+    const BasicHandleInfo* createUniqueHandle(const FederateState& fed,
+                                              InterfaceType HandleType,
+                                              const std::string& key,
+                                              const std::string& type,
+                                              const std::string& units,
+                                              uint16_t flags);
+    /** stage a registration command with its federate or send it to the core queue*/
+    void queueRegistration(FederateState* fed, ActionMessage&& registration);
+    /** send the registration commands staged by a federate as a single packed message*/
+    void flushStagedRegistrations(FederateState* fed);
+
     /** check if a global id represents a local federate
     @param global_fedid the identifier for the federate
     @return true if it is a local federate*/
@@ -517,6 +565,10 @@ class CommonCore: public Core, public BrokerBase {
     void removeTargetFromInterface(ActionMessage& command);
     /** function disconnect a single interface*/
     void disconnectInterface(ActionMessage& command);
+    /** remove resolved external endpoints so later messages to them are routed by name
+    @param endpoint the handle of the endpoint to remove, if the interface handle is not valid all
+    the endpoints of the federate are removed*/
+    void removeKnownExternalEndpoints(GlobalHandle endpoint);
     /** manage any timeblock messages*/
     void manageTimeBlocks(const ActionMessage& command);
 
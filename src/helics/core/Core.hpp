@@ -411,6 +411,27 @@ class Core {
     */
     virtual int32_t getHandleOption(InterfaceHandle handle, int32_t option) const = 0;
 
+    /** set the convergence tolerance of an input
+    @details during iterative time requests, value updates at the granted time which differ from the
+    previous value of the same source by no more than the tolerance are stored but do not trigger
+    another iteration
+    @param handle the handle of the input
+    @param tolerance the maximum difference of numeric values considered unchanged, a negative value
+    disables the check
+    */
+    virtual void setInputTolerance(InterfaceHandle handle, double tolerance) = 0;
+
+    /** set the retention policy for past values of an input
+    @details past values are kept in the core so they can be read with getValueAt, a value is kept
+    while it is one of the most recent valueCount values of its source and while it is needed to
+    answer reads within window of the most recent value
+    @param handle the handle of the input
+    @param valueCount the number of values to keep for each source, 0 for no count limit
+    @param window the span of time to keep values for, zero for no time limit, if both limits are
+    zero no history is kept
+    */
+    virtual void setInputRetention(InterfaceHandle handle, int32_t valueCount, Time window) = 0;
+
     /** close a handle from further connections
     @param handle the handle from the publication, input, endpoint or filter
     */
@@ -424,6 +445,18 @@ class Core {
      */
     virtual void setValue(InterfaceHandle handle, const char* data, uint64_t len) = 0;
 
+    /**
+     * Publish a set of values from a federate in a single operation.
+     * @details the values are checked under a single federate lock and the resulting messages
+     are grouped by destination before being handed to the core.  All the handles are checked
+     before any value is published.
+     @throws InvalidIdentifier if a handle is not a publication of the federate
+     @param federateID the federate publishing the values
+     @param values the publication handles and the data to publish for each
+     */
+    virtual void setValues(LocalFederateId federateID,
+                           const std::vector<std::pair<InterfaceHandle, SmallBuffer>>& values) = 0;
+
     /**
      * Return the data for the specified handle or the latest input
      * @param handle the input handle from which to get the data
@@ -433,6 +466,18 @@ class Core {
     virtual const std::shared_ptr<const SmallBuffer>& getValue(InterfaceHandle handle,
                                                                uint32_t* inputIndex = nullptr) = 0;
 
+    /**
+     * Return the retained data for the specified input in effect at a past time
+     * @details requires a retention policy set with setInputRetention, the data is shared with the
+     * core and not copied
+     * @param handle the input handle from which to get the data
+     * @param valueTime the time of interest, the most recent value at or before it is returned
+     * @param[out] inputIndex return the index of the source the value came from
+     * @return a null pointer if no value at or before valueTime is retained
+     */
+    virtual const std::shared_ptr<const SmallBuffer>&
+        getValueAt(InterfaceHandle handle, Time valueTime, uint32_t* inputIndex = nullptr) = 0;
+
     /**
      * Return all the available data for the specified handle or the latest input
      *
@@ -450,6 +495,16 @@ class Core {
      */
     virtual const std::vector<InterfaceHandle>& getValueUpdates(LocalFederateId federateID) = 0;
 
+    /**
+     * Returns the values of the inputs that received an update during the last time request.
+     * @details the snapshot is assembled by the core before the grant is returned so reading it
+     requires no further calls into the core.  The data remains valid until the next time or mode
+     request for the given federateID
+     *@param federateID the identification code of the federate to get the updated values for
+     @return a reference to the vector of updated input values
+     */
+    virtual const std::vector<ValueUpdate>& getValueSnapshot(LocalFederateId federateID) = 0;
+
     /**
      * Message interface.
      * Designed for point-to-point communication patterns.
@@ -20,6 +20,7 @@ SPDX-License-Identifier: BSD-3-Clause
 #include "loggingHelper.hpp"
 #include "queryHelpers.hpp"
 
+#include <algorithm>
 #include <iostream>
 #include <limits>
 #include <string>
@@ -81,9 +82,7 @@ route_id CoreBroker::getRoute(GlobalFederateId fedid) const
     if ((fedid == parent_broker_id) || (fedid == higher_broker_id)) {
         return parent_route_id;
     }
-    auto fnd = routing_table.find(fedid);
-    return (fnd != routing_table.end()) ? fnd->second :
-                                          parent_route_id;  // zero is the default route
+    return routing_table.getRoute(fedid, parent_route_id);  // zero is the default route
 }
 
 BasicBrokerInfo* CoreBroker::getBrokerById(GlobalBrokerId brokerid)
@@ -122,7 +121,7 @@ void CoreBroker::setLoggingCallback(
         setActionFlag(loggerUpdate, empty_flag);
     }
 
-    actionQueue.push(loggerUpdate);
+    pushAction(loggerUpdate);
 }
 
 uint16_t CoreBroker::getNextAirlockIndex()
@@ -217,8 +216,64 @@ bool CoreBroker::isOpenToNewFederates() const
              getCountableFederates() < maxFederateCount));
 }
 
+/** check if a command adds, removes, or changes the state of a federate, broker, handle, or
+dependency in the federation graphs*/
+static bool changesFederationGraph(action_message_def::action_t action)
+{
+    switch (action) {
+        case CMD_REG_FED:
+        case CMD_REG_BROKER:
+        case CMD_FED_ACK:
+        case CMD_BROKER_ACK:
+        case CMD_REG_PUB:
+        case CMD_REG_INPUT:
+        case CMD_REG_ENDPOINT:
+        case CMD_REG_FILTER:
+        case CMD_ADD_PUBLISHER:
+        case CMD_ADD_SUBSCRIBER:
+        case CMD_ADD_ENDPOINT:
+        case CMD_ADD_FILTER:
+        case CMD_ADD_NAMED_PUBLICATION:
+        case CMD_ADD_NAMED_INPUT:
+        case CMD_ADD_NAMED_ENDPOINT:
+        case CMD_ADD_NAMED_FILTER:
+        case CMD_REMOVE_NAMED_PUBLICATION:
+        case CMD_REMOVE_NAMED_INPUT:
+        case CMD_REMOVE_NAMED_ENDPOINT:
+        case CMD_REMOVE_NAMED_FILTER:
+        case CMD_REMOVE_PUBLICATION:
+        case CMD_REMOVE_SUBSCRIBER:
+        case CMD_REMOVE_ENDPOINT:
+        case CMD_REMOVE_FILTER:
+        case CMD_CLOSE_INTERFACE:
+        case CMD_ADD_DEPENDENCY:
+        case CMD_REMOVE_DEPENDENCY:
+        case CMD_ADD_DEPENDENT:
+        case CMD_REMOVE_DEPENDENT:
+        case CMD_ADD_INTERDEPENDENCY:
+        case CMD_REMOVE_INTERDEPENDENCY:
+        case CMD_INIT:
+        case CMD_INIT_NOT_READY:
+        case CMD_INIT_GRANT:
+        case CMD_EXEC_GRANT:
+        case CMD_DISCONNECT:
+        case CMD_DISCONNECT_FED:
+        case CMD_DISCONNECT_CORE:
+        case CMD_DISCONNECT_BROKER:
+        case CMD_CONNECTION_ERROR:
+        case CMD_LOCAL_ERROR:
+        case CMD_GLOBAL_ERROR:
+            return true;
+        default:
+            return false;
+    }
+}
+
 void CoreBroker::processPriorityCommand(ActionMessage&& command)
 {
+    if (changesFederationGraph(command.action())) {
+        ++federationGraphVersion;
+    }
     // deal with a few types of message immediately
     LOG_TRACE(global_broker_id_local,
               getIdentifier(),
@@ -332,6 +387,7 @@ void CoreBroker::processPriorityCommand(ActionMessage&& command)
                 fedReply.source_id = global_broker_id_local;
                 fedReply.dest_id = global_fedid;
                 fedReply.name(command.name());
+                fedReply.actionTime = timeQuantum;
                 if (checkActionFlag(command, child_flag)) {
                     setActionFlag(fedReply, child_flag);
                 }
@@ -357,6 +413,9 @@ void CoreBroker::processPriorityCommand(ActionMessage&& command)
                 break;
             }
             bool jsonReply = checkActionFlag(command, use_json_serialization_flag);
+            bool compressRoute = enable_compression && checkActionFlag(command, compression_flag);
+            bool framesRoute =
+                payloadFramesAvailable() && checkActionFlag(command, payload_frames_flag);
             if (command.counter > 0) {  // this indicates it is a resend
                 auto brk = _brokers.find(std::string(command.name()));
                 if (brk != _brokers.end()) {
@@ -365,7 +424,15 @@ void CoreBroker::processPriorityCommand(ActionMessage&& command)
                     addRoute(brk->route,
                              command.getExtraData(),
                              command.getString(targetStringLoc));
-                    routing_table[brk->global_id] = brk->route;
+                    routing_table.setRoute(brk->global_id, brk->route);
+                    brk->_compression = compressRoute;
+                    if (compressRoute) {
+                        setRouteCompression(brk->route, true);
+                    }
+                    brk->_payload_frames = framesRoute;
+                    if (framesRoute) {
+                        enableRoutePayloadFrames(brk->route);
+                    }
 
                     // sending the response message
                     ActionMessage brokerReply(CMD_BROKER_ACK);
@@ -375,6 +442,12 @@ void CoreBroker::processPriorityCommand(ActionMessage&& command)
                     if (no_ping) {
                         setActionFlag(brokerReply, slow_responding_flag);
                     }
+                    if (compressRoute) {
+                        setActionFlag(brokerReply, compression_flag);
+                    }
+                    if (framesRoute) {
+                        setActionFlag(brokerReply, payload_frames_flag);
+                    }
                     transmit(brk->route, brokerReply);
                     return;
                 }
@@ -485,6 +558,14 @@ void CoreBroker::processPriorityCommand(ActionMessage&& command)
                 _brokers.back().parent = global_broker_id_local;
                 _brokers.back()._nonLocal = false;
                 _brokers.back()._route_key = true;
+                _brokers.back()._compression = compressRoute;
+                if (compressRoute) {
+                    setRouteCompression(_brokers.back().route, true);
+                }
+                _brokers.back()._payload_frames = framesRoute;
+                if (framesRoute) {
+                    enableRoutePayloadFrames(_brokers.back().route);
+                }
             } else {
                 _brokers.back().route = getRoute(command.source_id);
                 if (_brokers.back().route == parent_route_id) {
@@ -524,6 +605,12 @@ void CoreBroker::processPriorityCommand(ActionMessage&& command)
                 if (no_ping) {
                     setActionFlag(brokerReply, slow_responding_flag);
                 }
+                if (_brokers.back()._compression) {
+                    setActionFlag(brokerReply, compression_flag);
+                }
+                if (_brokers.back()._payload_frames) {
+                    setActionFlag(brokerReply, payload_frames_flag);
+                }
                 transmit(route, brokerReply);
                 LOG_CONNECTIONS(global_broker_id_local,
                                 getIdentifier(),
@@ -541,6 +628,9 @@ void CoreBroker::processPriorityCommand(ActionMessage&& command)
                     fed->global_id = command.dest_id;
                     _federates.addSearchTerm(command.dest_id, fed->name);
                 }
+                if (command.actionTime <= timeZero) {
+                    command.actionTime = timeQuantum;
+                }
                 transmit(route, command);
                 routing_table.emplace(fed->global_id, route);
                 if (enable_profiling) {
@@ -588,6 +678,12 @@ void CoreBroker::processPriorityCommand(ActionMessage&& command)
                 if (checkActionFlag(command, slow_responding_flag)) {
                     timeoutMon->disableParentPing();
                 }
+                if (enable_compression && checkActionFlag(command, compression_flag)) {
+                    setRouteCompression(parent_route_id, true);
+                }
+                if (checkActionFlag(command, payload_frames_flag)) {
+                    enableRoutePayloadFrames(parent_route_id);
+                }
                 timeoutMon->reset();
                 return;
             }
@@ -604,6 +700,17 @@ void CoreBroker::processPriorityCommand(ActionMessage&& command)
                 routing_table.emplace(broker->global_id, route);
                 command.source_id = global_broker_id_local;  // we want the intermediate broker to
                                                              // change the source_id
+                // the compression and payload frame agreements are made separately for each link
+                if (broker->_compression) {
+                    setActionFlag(command, compression_flag);
+                } else {
+                    clearActionFlag(command, compression_flag);
+                }
+                if (broker->_payload_frames) {
+                    setActionFlag(command, payload_frames_flag);
+                } else {
+                    clearActionFlag(command, payload_frames_flag);
+                }
                 transmit(route, command);
             } else {
                 _brokers.insert(std::string(command.name()),
@@ -779,6 +886,9 @@ void CoreBroker::processCommand(ActionMessage&& command)
                           prettyPrintString(command),
                           command.source_id.baseValue(),
                           command.dest_id.baseValue()));
+    if (changesFederationGraph(command.action())) {
+        ++federationGraphVersion;
+    }
     switch (command.action()) {
         case CMD_IGNORE:
         case CMD_PROTOCOL:
@@ -1144,6 +1254,16 @@ void CoreBroker::processCommand(ActionMessage&& command)
                     }
 
                 } else {
+                    if (command.action() == CMD_SEND_MESSAGE &&
+                        command.dest_id != parent_broker_id && command.source_id.isFederate()) {
+                        // let the sending core address later messages by handle
+                        ActionMessage resolved(CMD_ENDPOINT_RESOLVED);
+                        resolved.setSource(command.getDest());
+                        resolved.dest_id = command.source_id;
+                        resolved.payload = command.getString(targetStringLoc);
+                        transmit(getRoute(resolved.dest_id), resolved);
+                        compactEndpointNames(command);
+                    }
                     transmit(route, command);
                 }
             } else {
@@ -1314,6 +1434,9 @@ void CoreBroker::processBrokerConfigureCommands(ActionMessage& cmd)
                 setTickForwarding(TickForwardingReasons::PING_RESPONSE, true);
             }
             break;
+        case UPDATE_GRAPH_SUBSCRIPTION:
+            processGraphSubscription(cmd);
+            break;
         default:
             break;
     }
@@ -1823,6 +1946,12 @@ bool CoreBroker::connect()
                     if (useJsonSerialization) {
                         setActionFlag(m, use_json_serialization_flag);
                     }
+                    if (enable_compression) {
+                        setActionFlag(m, compression_flag);
+                    }
+                    if (payloadFramesAvailable()) {
+                        setActionFlag(m, payload_frames_flag);
+                    }
                     if (!brokerKey.empty() && brokerKey != universalKey) {
                         m.setStringData(getAddress(), brokerKey);
                     } else {
@@ -2472,31 +2601,39 @@ void CoreBroker::processDisconnect(ActionMessage& command)
 
 void CoreBroker::checkInFlightQueries(GlobalBrokerId brkid)
 {
-    for (auto& mb : mapBuilders) {
+    for (std::uint16_t index = 0; index < static_cast<std::uint16_t>(mapBuilders.size());
+         ++index) {
+        auto& mb = mapBuilders[index];
         auto& builder = std::get<0>(mb);
         auto& requestors = std::get<1>(mb);
-        if (builder.isCompleted()) {
-            return;
+        if (builder.isCompleted() || !builder.isActive()) {
+            continue;
         }
         if (builder.clearComponents(brkid.baseValue())) {
-            auto str = builder.generate();
+            MapBuilderResult result(builder, !useJsonSerialization);
             for (int ii = 0; ii < static_cast<int>(requestors.size()) - 1; ++ii) {
                 if (requestors[ii].dest_id == global_broker_id_local) {
-                    activeQueries.setDelayedValue(requestors[ii].messageID, str);
+                    activeQueries.setDelayedValue(requestors[ii].messageID, result.json());
                 } else {
-                    requestors[ii].payload = str;
+                    requestors[ii].payload = result.forRequestor(requestors[ii]);
                     routeMessage(std::move(requestors[ii]));
                 }
             }
-            if (requestors.back().dest_id == global_broker_id_local) {
-                // TODO(PT) add rvalue reference method
-                activeQueries.setDelayedValue(requestors.back().messageID, str);
-            } else {
-                requestors.back().payload = std::move(str);
-                routeMessage(std::move(requestors.back()));
+            if (!requestors.empty()) {
+                if (requestors.back().dest_id == global_broker_id_local) {
+                    // TODO(PT) add rvalue reference method
+                    activeQueries.setDelayedValue(requestors.back().messageID, result.json());
+                } else {
+                    requestors.back().payload = result.forRequestor(requestors.back());
+                    routeMessage(std::move(requestors.back()));
+                }
             }
 
             requestors.clear();
+            if ((index == DEPENDENCY_GRAPH || index == DATA_FLOW_GRAPH) &&
+                !graphSubscriptions.empty()) {
+                publishGraphUpdate(index, &builder.getJValue());
+            }
             if (std::get<2>(mb)) {
                 builder.reset();
             }
@@ -2666,6 +2803,154 @@ static const std::map<std::string, std::pair<std::uint16_t, bool>> mapIndex{
     {"global_status", {GLOBAL_STATUS, true}},
     {"global_flush", {GLOBAL_FLUSH, true}}};
 
+static const char* graphQueryName(std::uint16_t index)
+{
+    return (index == DEPENDENCY_GRAPH) ? "dependency_graph" : "data_flow_graph";
+}
+
+std::int32_t CoreBroker::subscribeToGraph(std::string_view graph,
+                                          std::function<void(std::string_view)> callback)
+{
+    if ((graph != "dependency_graph" && graph != "data_flow_graph") || !callback) {
+        return -1;
+    }
+    auto subscriptionId = nextGraphSubscription++;
+    ActionMessage subscribe(CMD_BROKER_CONFIGURE);
+    subscribe.messageID = UPDATE_GRAPH_SUBSCRIPTION;
+    subscribe.source_id = global_id.load();
+    subscribe.setExtraData(subscriptionId);
+    subscribe.payload = graph;
+    auto ii = getNextAirlockIndex();
+    dataAirlocks[ii].load(std::move(callback));
+    subscribe.counter = ii;
+    addActionMessage(std::move(subscribe));
+    return subscriptionId;
+}
+
+void CoreBroker::unsubscribeFromGraph(std::int32_t subscriptionId)
+{
+    {
+        // waits for a callback in progress, later callbacks check the cancelled set
+        std::lock_guard<std::recursive_mutex> lock(graphCallbackLock);
+        cancelledGraphSubscriptions.insert(subscriptionId);
+    }
+    ActionMessage unsubscribe(CMD_BROKER_CONFIGURE);
+    unsubscribe.messageID = UPDATE_GRAPH_SUBSCRIPTION;
+    unsubscribe.source_id = global_id.load();
+    unsubscribe.setExtraData(subscriptionId);
+    setActionFlag(unsubscribe, empty_flag);
+    addActionMessage(std::move(unsubscribe));
+}
+
+void CoreBroker::processGraphSubscription(ActionMessage& cmd)
+{
+    if (checkActionFlag(cmd, empty_flag)) {
+        {
+            std::lock_guard<std::recursive_mutex> lock(graphCallbackLock);
+            cancelledGraphSubscriptions.erase(cmd.getExtraData());
+        }
+        graphSubscriptions.erase(std::remove_if(graphSubscriptions.begin(),
+                                                graphSubscriptions.end(),
+                                                [id = cmd.getExtraData()](const auto& sub) {
+                                                    return sub.id == id;
+                                                }),
+                                 graphSubscriptions.end());
+        return;
+    }
+    auto op = dataAirlocks[cmd.counter].try_unload();
+    if (!op) {
+        return;
+    }
+    const std::uint16_t index = mapIndex.at(std::string(cmd.payload.to_string())).first;
+    try {
+        auto callback = std::any_cast<std::function<void(std::string_view)>>(std::move(*op));
+        graphSubscriptions.push_back({cmd.getExtraData(), index, std::move(callback), false});
+    }
+    catch (const std::bad_any_cast&) {
+        return;
+    }
+    auto snapshot = graphSnapshots.find(index);
+    if (snapshot != graphSnapshots.end() &&
+        snapshot->second.graphVersion == federationGraphVersion) {
+        publishGraphUpdate(index, nullptr);
+    } else {
+        refreshGraphSubscriptions();
+    }
+}
+
+void CoreBroker::refreshGraphSubscriptions()
+{
+    for (std::uint16_t index : {DEPENDENCY_GRAPH, DATA_FLOW_GRAPH}) {
+        if (std::none_of(graphSubscriptions.begin(),
+                         graphSubscriptions.end(),
+                         [index](const auto& sub) { return sub.graph == index; })) {
+            continue;
+        }
+        auto& snapshot = graphSnapshots[index];
+        if (snapshot.graphVersion == federationGraphVersion) {
+            continue;
+        }
+        if (isValidIndex(index, mapBuilders)) {
+            const auto& builder = std::get<0>(mapBuilders[index]);
+            if (builder.isActive() && !builder.isCompleted()) {
+                // a build is in progress, the version is checked again after it completes
+                continue;
+            }
+        }
+        snapshot.graphVersion = federationGraphVersion;
+        initializeMapBuilder(graphQueryName(index), index, false, false);
+        auto& builder = std::get<0>(mapBuilders[index]);
+        if (builder.isCompleted()) {
+            builder.setCounterCode(generateMapObjectCounter());
+            publishGraphUpdate(index, &builder.getJValue());
+        }
+    }
+}
+
+void CoreBroker::publishGraphUpdate(std::uint16_t index, const Json::Value* graph)
+{
+    auto& snapshot = graphSnapshots[index];
+    if (graph != nullptr) {
+        auto delta = generateGraphDelta(snapshot.graph.getJValue(), *graph);
+        if (!isEmptyGraphDelta(delta)) {
+            ++snapshot.version;
+            delta["graph"] = graphQueryName(index);
+            delta["type"] = "delta";
+            delta["version"] = static_cast<Json::Int64>(snapshot.version);
+            const auto deltaString = fileops::generateJsonString(delta);
+            for (auto& sub : graphSubscriptions) {
+                if (sub.graph == index && sub.initialized) {
+                    callGraphSubscriber(sub, deltaString);
+                }
+            }
+        }
+        snapshot.graph.getJValue() = *graph;
+    }
+    std::string fullGraph;
+    for (auto& sub : graphSubscriptions) {
+        if (sub.graph == index && !sub.initialized) {
+            if (fullGraph.empty()) {
+                Json::Value full;
+                full["graph"] = graphQueryName(index);
+                full["type"] = "full";
+                full["version"] = static_cast<Json::Int64>(snapshot.version);
+                full["value"] = snapshot.graph.getJValue();
+                fullGraph = fileops::generateJsonString(full);
+            }
+            callGraphSubscriber(sub, fullGraph);
+            sub.initialized = true;
+        }
+    }
+}
+
+void CoreBroker::callGraphSubscriber(const GraphSubscription& sub, std::string_view update)
+{
+    std::lock_guard<std::recursive_mutex> lock(graphCallbackLock);
+    if (cancelledGraphSubscriptions.find(sub.id) == cancelledGraphSubscriptions.end()) {
+        sub.callback(update);
+    }
+}
+
 std::string CoreBroker::generateQueryAnswer(const std::string& request, bool force_ordering)
 {
     if (request == "isinit") {
@@ -2684,7 +2969,7 @@ std::string CoreBroker::generateQueryAnswer(const std::string& request, bool for
     if ((request == "queries") || (request == "available_queries")) {
         return "[\"isinit\",\"isconnected\",\"name\",\"identifier\",\"address\",\"queries\",\"address\",\"counts\",\"summary\",\"federates\",\"brokers\",\"inputs\",\"endpoints\","
                "\"publications\",\"filters\",\"federate_map\",\"dependency_graph\",\"data_flow_graph\",\"dependencies\",\"dependson\",\"dependents\","
-               "\"current_time\",\"current_state\",\"global_state\",\"status\",\"global_time\",\"global_status\",\"version\",\"version_all\",\"exists\",\"global_flush\"]";
+               "\"current_time\",\"current_state\",\"global_state\",\"status\",\"global_time\",\"global_status\",\"version\",\"version_all\",\"exists\",\"global_flush\",\"queue_latency\",\"compression\",\"memory\"]";
     }
     if (request == "address") {
         return std::string{"\""} + getAddress() + '"';
@@ -2705,6 +2990,31 @@ std::string CoreBroker::generateQueryAnswer(const std::string& request, bool for
         base["status"] = isConnected();
         return fileops::generateJsonString(base);
     }
+    if (request == "queue_latency") {
+        Json::Value base;
+        base["name"] = getIdentifier();
+        base["id"] = global_broker_id_local.baseValue();
+        generateQueueLatency(base);
+        return fileops::generateJsonString(base);
+    }
+    if (request == "compression") {
+        Json::Value base;
+        base["name"] = getIdentifier();
+        base["id"] = global_broker_id_local.baseValue();
+        generateCompressionStats(base);
+        return fileops::generateJsonString(base);
+    }
+    if (request == "memory") {
+        Json::Value base;
+        base["name"] = getIdentifier();
+        base["id"] = global_broker_id_local.baseValue();
+        auto total = generateMemoryUsage(base);
+        const auto handleBytes = handles.memoryUsage();
+        base["handles"] = static_cast<Json::UInt64>(handleBytes);
+        total += handleBytes;
+        base["total"] = static_cast<Json::UInt64>(total);
+        return fileops::generateJsonString(base);
+    }
     if (request == "counts") {
         Json::Value base;
         base["name"] = getIdentifier();
@@ -3343,36 +3653,42 @@ void CoreBroker::processQueryResponse(const ActionMessage& m)
         auto& builder = std::get<0>(mapBuilders[m.counter]);
         auto& requestors = std::get<1>(mapBuilders[m.counter]);
         if (builder.addComponent(std::string(m.payload.to_string()), m.messageID)) {
-            std::string str;
+            MapBuilderResult result(builder, !useJsonSerialization);
             switch (m.counter) {
                 case GLOBAL_STATUS:
-                    str = generateGlobalStatus(builder);
+                    result.setJson(generateGlobalStatus(builder));
                     break;
                 case GLOBAL_FLUSH:
-                    str = "{\"status\":true}";
+                    result.setJson("{\"status\":true}");
                     break;
                 default:
-                    str = builder.generate();
                     break;
             }
 
             for (int ii = 0; ii < static_cast<int>(requestors.size()) - 1; ++ii) {
                 if (requestors[ii].dest_id == global_broker_id_local) {
-                    activeQueries.setDelayedValue(requestors[ii].messageID, str);
+                    activeQueries.setDelayedValue(requestors[ii].messageID, result.json());
                 } else {
-                    requestors[ii].payload = str;
+                    requestors[ii].payload = result.forRequestor(requestors[ii]);
                     routeMessage(std::move(requestors[ii]));
                 }
             }
-            if (requestors.back().dest_id == global_broker_id_local) {
-                // TODO(PT) add rvalue reference method
-                activeQueries.setDelayedValue(requestors.back().messageID, str);
-            } else {
-                requestors.back().payload = std::move(str);
-                routeMessage(std::move(requestors.back()));
+            // graph subscriptions rebuild the maps without a requestor
+            if (!requestors.empty()) {
+                if (requestors.back().dest_id == global_broker_id_local) {
+                    // TODO(PT) add rvalue reference method
+                    activeQueries.setDelayedValue(requestors.back().messageID, result.json());
+                } else {
+                    requestors.back().payload = result.forRequestor(requestors.back());
+                    routeMessage(std::move(requestors.back()));
+                }
             }
 
             requestors.clear();
+            if ((m.counter == DEPENDENCY_GRAPH || m.counter == DATA_FLOW_GRAPH) &&
+                !graphSubscriptions.empty()) {
+                publishGraphUpdate(m.counter, &builder.getJValue());
+            }
             if (std::get<2>(mapBuilders[m.counter])) {
                 builder.reset();
             } else {
@@ -3584,6 +3900,13 @@ int CoreBroker::getCountableFederates() const
     return cnt;
 }
 
+void CoreBroker::completeProcessingPass()
+{
+    if (!graphSubscriptions.empty()) {
+        refreshGraphSubscriptions();
+    }
+}
+
 bool CoreBroker::allInitReady() const
 {
     // the federate count must be greater than the min size
@@ -11,6 +11,7 @@ SPDX-License-Identifier: BSD-3-Clause
 #include "BasicHandleInfo.hpp"
 #include "Broker.hpp"
 #include "BrokerBase.hpp"
+#include "DenseRoutingTable.hpp"
 #include "FederateIdExtra.hpp"
 #include "HandleManager.hpp"
 #include "TimeDependencies.hpp"
@@ -28,7 +29,10 @@ SPDX-License-Identifier: BSD-3-Clause
 #include <functional>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <set>
 #include <string>
+#include <string_view>
 #include <thread>
 #include <tuple>
 #include <unordered_map>
@@ -78,7 +82,8 @@ class BasicBrokerInfo {
     bool _route_key{false};  //!< indicator that the broker has a unique route id
     bool _sent_disconnect_ack{false};  //!< indicator that the disconnect ack has been sent
     bool _disable_ping{false};  //!< indicator that the broker doesn't respond to pings
-    // 1 byte gap
+    bool _compression{false};  //!< indicator that the route to the broker uses compression
+    bool _payload_frames{false};  //!< indicator that the broker receives separate payload frames
     std::string routeInfo;  //!< string describing the connection information for the route
     explicit BasicBrokerInfo(std::string_view brokerName): name(brokerName) {}
 };
@@ -112,8 +117,7 @@ class CoreBroker: public Broker, public BrokerBase {
         delayedDependencies;  //!< set of dependencies that need to be created on init
     std::unordered_map<GlobalFederateId, LocalFederateId>
         global_id_translation;  //!< map to translate global ids to local ones
-    std::unordered_map<GlobalFederateId, route_id>
-        routing_table;  //!< map for external routes  <global federate id, route id>
+    DenseRoutingTable routing_table;  //!< table for external routes  <global federate id, route id>
     std::unordered_map<std::string, route_id>
         knownExternalEndpoints;  //!< external map for all known external endpoints with names and
                                  //!< route
@@ -127,6 +131,30 @@ class CoreBroker: public Broker, public BrokerBase {
     std::deque<std::pair<int32_t, decltype(std::chrono::steady_clock::now())>> queryTimeouts;
 
     std::vector<ActionMessage> earlyMessages;  //!< list of messages that came before connection
+    /** a subscription to the changes of a federation graph*/
+    struct GraphSubscription {
+        std::int32_t id{0};
+        std::uint16_t graph{0};  //!< the map builder index of the graph
+        std::function<void(std::string_view)> callback;
+        bool initialized{false};  //!< true once the full graph has been sent
+    };
+    /** the last version of a graph sent to the subscribers*/
+    struct GraphSnapshot {
+        fileops::JsonBuilder graph;
+        /// the federation graph version the graph was generated for
+        std::uint64_t graphVersion{0};
+        std::int64_t version{0};  //!< incremented for each change sent
+    };
+    std::vector<GraphSubscription> graphSubscriptions;
+    /// incremented for each command that changes a federate, broker, handle, or dependency
+    std::uint64_t federationGraphVersion{1};
+    std::map<std::uint16_t, GraphSnapshot> graphSnapshots;
+    std::atomic<std::int32_t> nextGraphSubscription{1};
+    /// held while subscription callbacks run so unsubscribeFromGraph can wait for them to finish
+    std::recursive_mutex graphCallbackLock;
+    /// subscriptions removed by unsubscribeFromGraph and not yet erased, guarded by
+    /// graphCallbackLock
+    std::set<std::int32_t> cancelledGraphSubscriptions;
     gmlc::concurrency::TriggerVariable disconnection;  //!< controller for the disconnection process
     std::unique_ptr<TimeoutMonitor>
         timeoutMon;  //!< class to handle timeouts and disconnection notices
@@ -147,6 +175,17 @@ class CoreBroker: public Broker, public BrokerBase {
 
     /** process configure commands for the broker*/
     void processBrokerConfigureCommands(ActionMessage& cmd);
+    virtual void completeProcessingPass() override;
+    /** add or remove a graph subscription*/
+    void processGraphSubscription(ActionMessage& cmd);
+    /** start regenerating the subscribed graphs if the federation objects have changed*/
+    void refreshGraphSubscriptions();
+    /** call the callback of a graph subscription unless it has been unsubscribed*/
+    void callGraphSubscriber(const GraphSubscription& sub, std::string_view update);
+    /** send a graph to new subscribers and the changes from the last version to the others
+    @param index the map builder index of the graph
+    @param graph the new graph, nullptr to only update new subscribers*/
+    void publishGraphUpdate(std::uint16_t index, const Json::Value* graph);
 
     gmlc::containers::SimpleQueue<ActionMessage>
         delayTransmitQueue;  //!< FIFO queue for transmissions to the root that need to be delayed
@@ -296,6 +335,9 @@ class CoreBroker: public Broker, public BrokerBase {
     virtual void sendCommand(const std::string& target,
                              const std::string& commandStr,
                              HelicsSequencingModes mode) override final;
+    virtual std::int32_t subscribeToGraph(std::string_view graph,
+                                          std::function<void(std::string_view)> callback) override;
+    virtual void unsubscribeFromGraph(std::int32_t subscriptionId) override;
     virtual void makeConnections(const std::string& file) override final;
     virtual void dataLink(const std::string& publication, const std::string& input) override final;
 
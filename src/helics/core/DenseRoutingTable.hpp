@@ -0,0 +1,127 @@
+/*
+Copyright (c) 2017-2021,
+Battelle Memorial Institute; Lawrence Livermore National Security, LLC; Alliance for Sustainable
+Energy, LLC.  See the top-level NOTICE for additional details. All rights reserved.
+SPDX-License-Identifier: BSD-3-Clause
+*/
+#pragma once
+
+#include "GlobalFederateId.hpp"
+
+#include <cstddef>
+#include <map>
+#include <vector>
+
+namespace helics {
+/** table mapping global federate and broker ids to the route used to reach them
+@details global ids are assigned sequentially by the root broker starting from an offset for
+federates and for brokers, so the routes are stored in two arrays indexed directly by the offset
+from the start of each range.  Ids outside of the dense ranges are kept in a small overflow map.
+*/
+class DenseRoutingTable {
+  public:
+    /// ids further than this from the start of their range are stored in the overflow map
+    static constexpr std::size_t maximumDenseIndex{1U << 20U};
+
+    /** get the route for an id
+    @param id the global id of the federate or broker
+    @param defaultRoute the route to return if the id is not in the table*/
+    route_id getRoute(GlobalFederateId id, route_id defaultRoute) const
+    {
+        const auto* slot = find(id);
+        return (slot != nullptr && slot->isValid()) ? *slot : defaultRoute;
+    }
+    /** check if the table contains a route for an id*/
+    bool contains(GlobalFederateId id) const
+    {
+        const auto* slot = find(id);
+        return (slot != nullptr && slot->isValid());
+    }
+    /** add a route for an id if the id does not already have one
+    @return true if the route was added*/
+    bool emplace(GlobalFederateId id, route_id route)
+    {
+        auto& slot = locate(id);
+        if (slot.isValid()) {
+            return false;
+        }
+        slot = route;
+        ++count;
+        return true;
+    }
+    /** set the route for an id replacing any existing route*/
+    void setRoute(GlobalFederateId id, route_id route)
+    {
+        auto& slot = locate(id);
+        if (!slot.isValid()) {
+            ++count;
+        }
+        slot = route;
+    }
+    /** remove the route for an id*/
+    void erase(GlobalFederateId id)
+    {
+        auto* slot = const_cast<route_id*>(find(id));
+        if (slot != nullptr && slot->isValid()) {
+            *slot = route_id{};
+            --count;
+        }
+    }
+    /** get the number of ids with a route*/
+    std::size_t size() const { return count; }
+    /** check if the table has no routes*/
+    bool empty() const { return count == 0; }
+    /** remove all the routes*/
+    void clear()
+    {
+        federateRoutes.clear();
+        brokerRoutes.clear();
+        overflow.clear();
+        count = 0;
+    }
+
+  private:
+    /** get the dense array and index for an id, nullptr if the id is not in a dense range*/
+    const std::vector<route_id>* denseRange(GlobalFederateId id, std::size_t& index) const
+    {
+        const auto gid = id.baseValue();
+        if (gid >= gGlobalBrokerIdShift) {
+            index = static_cast<std::size_t>(gid - gGlobalBrokerIdShift);
+            return (index < maximumDenseIndex) ? &brokerRoutes : nullptr;
+        }
+        if (gid >= gGlobalFederateIdShift) {
+            index = static_cast<std::size_t>(gid - gGlobalFederateIdShift);
+            return (index < maximumDenseIndex) ? &federateRoutes : nullptr;
+        }
+        return nullptr;
+    }
+    const route_id* find(GlobalFederateId id) const
+    {
+        std::size_t index{0};
+        const auto* range = denseRange(id, index);
+        if (range != nullptr) {
+            return (index < range->size()) ? &(*range)[index] : nullptr;
+        }
+        auto fnd = overflow.find(id);
+        return (fnd != overflow.end()) ? &fnd->second : nullptr;
+    }
+    route_id& locate(GlobalFederateId id)
+    {
+        std::size_t index{0};
+        auto* range = const_cast<std::vector<route_id>*>(denseRange(id, index));
+        if (range == nullptr) {
+            return overflow[id];
+        }
+        if (index >= range->size()) {
+            range->resize(index + 1);
+        }
+        return (*range)[index];
+    }
+
+    std::vector<route_id> federateRoutes;  //!< routes indexed by the federate offset
+    std::vector<route_id> brokerRoutes;  //!< routes indexed by the broker offset
+    std::map<GlobalFederateId, route_id> overflow;  //!< routes for ids outside the dense ranges
+    std::size_t count{0};  //!< the number of valid routes
+};
+
+}  // namespace helics
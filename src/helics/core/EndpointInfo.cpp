@@ -31,7 +31,7 @@ bool EndpointInfo::updateTimeUpTo(Time newTime)
         ++cv;
     }
     if (index != mAvailableMessages.load()) {
-        mAvailableMessages.store(index);
+        setAvailable(index);
         return true;
     }
     return false;
@@ -52,7 +52,7 @@ bool EndpointInfo::updateTimeNextIteration(Time newTime)
         ++cv;
     }
     if (index != mAvailableMessages.load()) {
-        mAvailableMessages.store(index);
+        setAvailable(index);
         return true;
     }
     return false;
@@ -73,7 +73,7 @@ bool EndpointInfo::updateTimeInclusive(Time newTime)
         ++cv;
     }
     if (index != mAvailableMessages.load()) {
-        mAvailableMessages.store(index);
+        setAvailable(index);
         return true;
     }
     return false;
@@ -88,10 +88,18 @@ std::unique_ptr<Message> EndpointInfo::getMessage(Time maxTime)
         }
         if (handle->front()->time <= maxTime) {
             if (mAvailableMessages > 0) {
-                --mAvailableMessages;
+                setAvailable(mAvailableMessages.load() - 1);
             }
             auto msg = std::move(handle->front());
             handle->pop_front();
+            updateHead(*handle);
+            if (!messageSources.empty()) {
+                auto src = messageSources.find(msg.get());
+                if (src != messageSources.end()) {
+                    addConsumedCredit(src->second);
+                    messageSources.erase(src);
+                }
+            }
             return msg;
         }
     }
@@ -116,12 +124,108 @@ void EndpointInfo::addMessage(std::unique_ptr<Message> message)
     auto handle = message_queue.lock();
     handle->push_back(std::move(message));
     std::stable_sort(handle->begin(), handle->end(), msgSorter);
+    updateHead(*handle);
+}
+
+bool EndpointInfo::addMessage(std::unique_ptr<Message> message, GlobalFederateId source)
+{
+    if (receiveCapacity <= 0) {
+        addMessage(std::move(message));
+        return false;
+    }
+    auto handle = message_queue.lock();
+    messageSources.emplace(message.get(), source);
+    handle->push_back(std::move(message));
+    std::stable_sort(handle->begin(), handle->end(), msgSorter);
+    updateHead(*handle);
+    if (std::find(creditSources.begin(), creditSources.end(), source) != creditSources.end()) {
+        return false;
+    }
+    creditSources.push_back(source);
+    return true;
+}
+
+void EndpointInfo::updateHead(const std::deque<std::unique_ptr<Message>>& queue)
+{
+    if (headIndex == nullptr) {
+        return;
+    }
+    auto head = queue.empty() ? Time::maxVal() : queue.front()->time;
+    if (head != indexedHead) {
+        headIndex->moveHead(this, id.handle, indexedHead, head);
+        indexedHead = head;
+    }
+}
+
+void EndpointInfo::setAvailable(int32_t count)
+{
+    auto previous = mAvailableMessages.exchange(count);
+    if (headIndex != nullptr && previous != count) {
+        headIndex->addAvailable(count - previous);
+    }
+}
+
+void EndpointInfo::addConsumedCredit(GlobalFederateId source)
+{
+    for (auto& credit : consumedCredits) {
+        if (credit.first == source) {
+            ++credit.second;
+            return;
+        }
+    }
+    consumedCredits.emplace_back(source, 1);
+}
+
+std::vector<std::pair<GlobalFederateId, int32_t>> EndpointInfo::takeCredits(bool all)
+{
+    std::vector<std::pair<GlobalFederateId, int32_t>> credits;
+    auto handle = message_queue.lock();
+    if (consumedCredits.empty()) {
+        return credits;
+    }
+    if (all || handle->empty()) {
+        credits.swap(consumedCredits);
+        return credits;
+    }
+    const int32_t batch = std::max(receiveCapacity / 4, 1);
+    auto split = std::stable_partition(consumedCredits.begin(),
+                                       consumedCredits.end(),
+                                       [batch](const auto& credit) { return credit.second < batch; });
+    credits.assign(split, consumedCredits.end());
+    consumedCredits.erase(split, consumedCredits.end());
+    return credits;
 }
 
 void EndpointInfo::clearQueue()
 {
-    mAvailableMessages.store(0);
-    message_queue.lock()->clear();
+    setAvailable(0);
+    auto handle = message_queue.lock();
+    // discarded messages still return their credits
+    for (const auto& src : messageSources) {
+        addConsumedCredit(src.second);
+    }
+    messageSources.clear();
+    handle->clear();
+    updateHead(*handle);
+}
+
+int32_t EndpointInfo::totalQueueSize() const
+{
+    return static_cast<int32_t>(message_queue.lock_shared()->size());
+}
+
+std::uint64_t EndpointInfo::memoryUsage() const
+{
+    std::uint64_t bytes{0};
+    auto handle = message_queue.lock_shared();
+    for (const auto& msg : *handle) {
+        bytes += sizeof(Message) + msg->dest.size() + msg->source.size() +
+            msg->original_source.size() + msg->original_dest.size();
+        if (msg->data.ownsHeapMemory()) {
+            bytes += msg->data.capacity();
+        }
+    }
+    return bytes;
 }
 
 int32_t EndpointInfo::availableMessages() const
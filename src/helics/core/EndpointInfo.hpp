@@ -11,8 +11,11 @@ SPDX-License-Identifier: BSD-3-Clause
 
 #include <atomic>
 #include <deque>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -28,12 +31,67 @@ struct EndpointInformation {
     {
     }
 };
+class EndpointInfo;
+
+/** federate wide index of the first queued message of each endpoint and of the number of
+available messages
+@details the endpoints keep the index up to date as messages are added and removed so the earliest
+message over all endpoints can be found without scanning each endpoint*/
+class MessageHeadIndex {
+  public:
+    /** get the endpoint with the earliest queued message
+    @param[out] time the time of the first message
+    @return the endpoint or nullptr if no endpoint has a queued message*/
+    EndpointInfo* first(Time& time) const
+    {
+        std::lock_guard<std::mutex> lock(indexLock);
+        if (heads.empty()) {
+            time = Time::maxVal();
+            return nullptr;
+        }
+        time = heads.begin()->first.first;
+        return heads.begin()->second;
+    }
+    /** get the time of the earliest queued message*/
+    Time firstTime() const
+    {
+        std::lock_guard<std::mutex> lock(indexLock);
+        return heads.empty() ? Time::maxVal() : heads.begin()->first.first;
+    }
+    /** get the number of available messages over all the endpoints*/
+    int64_t available() const { return availableCount.load(); }
+
+  private:
+    /** move the entry of an endpoint from one head time to another*/
+    void moveHead(EndpointInfo* ept, InterfaceHandle handle, Time oldHead, Time newHead)
+    {
+        std::lock_guard<std::mutex> lock(indexLock);
+        if (oldHead < Time::maxVal()) {
+            heads.erase({oldHead, handle});
+        }
+        if (newHead < Time::maxVal()) {
+            heads.emplace(std::make_pair(newHead, handle), ept);
+        }
+    }
+    void addAvailable(int32_t change) { availableCount += change; }
+
+    mutable std::mutex indexLock;
+    /// endpoints ordered by the time of their first message then by handle
+    std::map<std::pair<Time, InterfaceHandle>, EndpointInfo*> heads;
+    std::atomic<int64_t> availableCount{0};
+    friend class EndpointInfo;
+};
+
 /** data class containing the information about an endpoint*/
 class EndpointInfo {
   public:
     /** constructor from all data*/
-    EndpointInfo(GlobalHandle handle, const std::string& key_, const std::string& type_):
-        id(handle), key(key_), type(type_)
+    EndpointInfo(GlobalHandle handle,
+                 const std::string& key_,
+                 const std::string& type_,
+                 MessageHeadIndex* index = nullptr):
+        id(handle),
+        key(key_), type(type_), headIndex(index)
     {
     }
 
@@ -44,17 +102,35 @@ class EndpointInfo {
     shared_guarded<std::deque<std::unique_ptr<Message>>>
         message_queue;  //!< storage for the messages
     std::atomic<int32_t> mAvailableMessages{0};  //!< indicator of how many message are available
+    /// the federates that sent the queued messages, only tracked with a receive capacity
+    std::unordered_map<const Message*, GlobalFederateId> messageSources;
+    /// consumed messages that have not been returned as credits to each source
+    std::vector<std::pair<GlobalFederateId, int32_t>> consumedCredits;
+    /// sources which have been told the receive capacity of the endpoint
+    std::vector<GlobalFederateId> creditSources;
+    /// the federate message index kept up to date with this endpoint
+    MessageHeadIndex* headIndex{nullptr};
+    /// the time of the first message as recorded in the index
+    Time indexedHead{Time::maxVal()};
 
     std::vector<EndpointInformation> sourceInformation;
     std::vector<EndpointInformation> targetInformation;
     std::vector<std::pair<GlobalHandle, std::string_view>> targets;
     mutable std::string sourceTargets;
     mutable std::string destinationTargets;
+    /** record a consumed message from a source, must be called with the queue locked*/
+    void addConsumedCredit(GlobalFederateId source);
+    /** update the index with the first message, must be called with the queue locked*/
+    void updateHead(const std::deque<std::unique_ptr<Message>>& queue);
+    /** set the number of available messages and update the index count*/
+    void setAvailable(int32_t count);
 
   public:
     bool hasFilter{false};  //!< indicator that the message has a filter
     bool required{false};
     bool targettedEndpoint{false};  //!< indicator that the endpoint is a targeted endpoint only
+    /// the number of messages the endpoint queues before holding senders, 0 for unlimited
+    int32_t receiveCapacity{0};
     /** get the next message up to the specified time*/
     std::unique_ptr<Message> getMessage(Time maxTime);
     /** get the number of messages in the queue up to the specified time*/
@@ -65,6 +141,20 @@ class EndpointInfo {
     int32_t queueSizeUpTo(Time maxTime) const;
     /** add a message to the queue*/
     void addMessage(std::unique_ptr<Message> message);
+    /** add a message to the queue and record its source for returning credits
+    @details the credit is held until the message is read or discarded
+    @param message the message to add
+    @param source the federate that sent the message
+    @return true if the source has not been sent the receive capacity of the endpoint*/
+    bool addMessage(std::unique_ptr<Message> message, GlobalFederateId source);
+    /** get the credits for released messages that should be returned to their sources
+    @param all true to take all the credits, otherwise credits are released in batches of a
+    quarter of the capacity or when the queue empties*/
+    std::vector<std::pair<GlobalFederateId, int32_t>> takeCredits(bool all = false);
+    /** get the total number of messages in the queue*/
+    int32_t totalQueueSize() const;
+    /** get the approximate memory held by the queued messages in bytes*/
+    std::uint64_t memoryUsage() const;
     /** update current data not including data at the specified time
     @param newTime the time to move the subscription to
     @return true if the value has changed
@@ -16,12 +16,14 @@ SPDX-License-Identifier: BSD-3-Clause
 #include "TimeCoordinator.hpp"
 #include "TimeCoordinatorProcessing.hpp"
 #include "TimeDependencies.hpp"
+#include "ValueEncoding.hpp"
 #include "helics/helics-config.h"
 #include "helics_definitions.hpp"
 #include "queryHelpers.hpp"
 
 #include <algorithm>
 #include <chrono>
+#include <cstring>
 #include <memory>
 #include <mutex>
 #include <optional>
@@ -186,6 +188,29 @@ bool FederateState::checkAndSetValue(InterfaceHandle pub_id, const char* data, u
     return res;
 }
 
+std::vector<std::vector<GlobalHandle>> FederateState::checkAndGetSubscribers(
+    const std::vector<std::pair<InterfaceHandle, SmallBuffer>>& values,
+    const std::vector<bool>& active)
+{
+    std::vector<std::vector<GlobalHandle>> subscribers(values.size());
+    std::lock_guard<FederateState> plock(*this);
+    for (std::size_t ii = 0; ii < values.size(); ++ii) {
+        if (!active[ii]) {
+            continue;
+        }
+        auto* pub = interfaceInformation.getPublication(values[ii].first);
+        if (pub == nullptr) {
+            continue;
+        }
+        const auto& data = values[ii].second;
+        if (only_transmit_on_change && !pub->CheckSetValue(data.char_data(), data.size())) {
+            continue;
+        }
+        subscribers[ii] = pub->subscribers;
+    }
+    return subscribers;
+}
+
 void FederateState::generateConfig(Json::Value& base) const
 {
     base["only_transmit_on_change"] = only_transmit_on_change;
@@ -202,6 +227,62 @@ void FederateState::generateConfig(Json::Value& base) const
     }
 }
 
+void FederateState::generateQueueInfo(Json::Value& base) const
+{
+    base["action_queue"] = static_cast<Json::UInt64>(queue.size());
+    base["endpoints"] = Json::arrayValue;
+    for (const auto& ept : interfaceInformation.getEndpoints()) {
+        Json::Value eptInfo;
+        eptInfo["name"] = ept->key;
+        eptInfo["queued"] = ept->totalQueueSize();
+        eptInfo["available"] = ept->availableMessages();
+        eptInfo["capacity"] = ept->receiveCapacity;
+        base["endpoints"].append(std::move(eptInfo));
+    }
+}
+
+std::uint64_t FederateState::generateMemoryInfo(Json::Value& base) const
+{
+    const std::uint64_t queueBytes = queue.size() * sizeof(ActionMessage);
+    std::uint64_t inputBytes{0};
+    for (const auto& ipt : interfaceInformation.getInputs()) {
+        inputBytes += ipt->memoryUsage();
+    }
+    std::uint64_t endpointBytes{0};
+    for (const auto& ept : interfaceInformation.getEndpoints()) {
+        endpointBytes += ept->memoryUsage();
+    }
+    base["action_queue"] = static_cast<Json::UInt64>(queueBytes);
+    base["inputs"] = static_cast<Json::UInt64>(inputBytes);
+    base["endpoints"] = static_cast<Json::UInt64>(endpointBytes);
+    const auto total = queueBytes + inputBytes + endpointBytes;
+    base["total"] = static_cast<Json::UInt64>(total);
+    return total;
+}
+
+std::uint64_t FederateState::bufferedMemory() const
+{
+    std::uint64_t bytes = queue.size() * sizeof(ActionMessage);
+    for (const auto& ept : interfaceInformation.getEndpoints()) {
+        bytes += ept->memoryUsage();
+    }
+    // the input values are modified by the federate so only the counter it maintains is read here
+    bytes += inputMemory.load();
+    return bytes;
+}
+
+void FederateState::updateInputMemory()
+{
+    if (!mTrackMemory) {
+        return;
+    }
+    std::uint64_t bytes{0};
+    for (const auto& ipt : interfaceInformation.getInputs()) {
+        bytes += ipt->memoryUsage();
+    }
+    inputMemory.store(bytes);
+}
+
 uint64_t FederateState::getQueueSize(InterfaceHandle id) const
 {
     const auto* epI = interfaceInformation.getEndpoint(id);
@@ -210,35 +291,50 @@ uint64_t FederateState::getQueueSize(InterfaceHandle id) const
 
 uint64_t FederateState::getQueueSize() const
 {
-    uint64_t cnt = 0;
-    for (const auto& end_point : interfaceInformation.getEndpoints()) {
-        cnt += end_point->availableMessages();
-    }
-    return cnt;
+    auto cnt = interfaceInformation.getMessageIndex().available();
+    return (cnt > 0) ? static_cast<uint64_t>(cnt) : 0U;
 }
 
 std::unique_ptr<Message> FederateState::receive(InterfaceHandle id)
 {
     auto* epI = interfaceInformation.getEndpoint(id);
     if (epI != nullptr) {
-        return epI->getMessage(time_granted);
+        auto msg = epI->getMessage(time_granted);
+        if (msg && epI->receiveCapacity > 0) {
+            returnMessageCredits(*epI);
+        }
+        return msg;
     }
     return nullptr;
 }
 
+void FederateState::returnMessageCredits(EndpointInfo& ept, bool all)
+{
+    for (const auto& credit : ept.takeCredits(all)) {
+        sendMessageCredits(ept, credit.first, credit.second);
+    }
+}
+
+void FederateState::sendMessageCredits(const EndpointInfo& ept,
+                                       GlobalFederateId source,
+                                       int32_t credits)
+{
+    if (parent_ == nullptr || !source.isValid()) {
+        return;
+    }
+    ActionMessage credit(CMD_ENDPOINT_CREDIT, global_id.load(), source);
+    credit.source_handle = ept.id.handle;
+    credit.messageID = credits;
+    credit.sequenceID = static_cast<uint32_t>(ept.receiveCapacity);
+    credit.payload = ept.key;
+    parent_->addActionMessage(std::move(credit));
+}
+
 std::unique_ptr<Message> FederateState::receiveAny(InterfaceHandle& id)
 {
     Time earliest_time = Time::maxVal();
-    EndpointInfo* endpointI = nullptr;
-    auto elock = interfaceInformation.getEndpoints();
     // Find the end point with the earliest message time
-    for (const auto& end_point : elock) {
-        auto t = end_point->firstMessageTime();
-        if (t < earliest_time) {
-            earliest_time = t;
-            endpointI = end_point.get();
-        }
-    }
+    auto* endpointI = interfaceInformation.getMessageIndex().first(earliest_time);
     if (endpointI == nullptr) {
         return nullptr;
     }
@@ -246,6 +342,9 @@ std::unique_ptr<Message> FederateState::receiveAny(InterfaceHandle& id)
     if (earliest_time <= time_granted) {
         auto result = endpointI->getMessage(time_granted);
         id = (result) ? endpointI->id.handle : InterfaceHandle{};
+        if (result && endpointI->receiveCapacity > 0) {
+            returnMessageCredits(*endpointI);
+        }
 
         return result;
     }
@@ -259,6 +358,12 @@ const std::shared_ptr<const SmallBuffer>& FederateState::getValue(InterfaceHandl
     return interfaces().getInput(handle)->getData(inputIndex);
 }
 
+const std::shared_ptr<const SmallBuffer>&
+    FederateState::getValueAt(InterfaceHandle handle, Time valueTime, uint32_t* inputIndex)
+{
+    return interfaces().getInput(handle)->getDataAt(valueTime, inputIndex);
+}
+
 const std::vector<std::shared_ptr<const SmallBuffer>>&
     FederateState::getAllValues(InterfaceHandle handle)
 {
@@ -283,6 +388,10 @@ void FederateState::routeMessage(const ActionMessage& msg)
 void FederateState::addAction(const ActionMessage& action)
 {
     if (action.action() != CMD_IGNORE) {
+        if (mTrackQueueLatency) {
+            addAction(ActionMessage(action));
+            return;
+        }
         queue.push(action);
     }
 }
@@ -290,10 +399,31 @@ void FederateState::addAction(const ActionMessage& action)
 void FederateState::addAction(ActionMessage&& action)
 {
     if (action.action() != CMD_IGNORE) {
+        if (mTrackQueueLatency) {
+            action.enqueueTime = LatencyHistogram::now();
+        }
         queue.push(std::move(action));
     }
 }
 
+bool FederateState::stageRegistration(ActionMessage& command)
+{
+    auto staged = stagedRegistrations.lock();
+    // checked under the lock so a staged command can't be missed by takeStagedRegistrations
+    if (init_requested.load() || getState() != HELICS_CREATED) {
+        return false;
+    }
+    staged->push_back(std::move(command));
+    return true;
+}
+
+std::vector<ActionMessage> FederateState::takeStagedRegistrations()
+{
+    std::vector<ActionMessage> taken;
+    stagedRegistrations.lock()->swap(taken);
+    return taken;
+}
+
 void FederateState::createInterface(InterfaceType htype,
                                     InterfaceHandle handle,
                                     const std::string& key,
@@ -367,6 +497,8 @@ void FederateState::closeInterface(InterfaceHandle handle, InterfaceType type)
             auto* ept = interfaceInformation.getEndpoint(handle);
             if (ept != nullptr) {
                 ept->clearQueue();
+                // discarded messages return their credits
+                returnMessageCredits(*ept, true);
             }
         } break;
         case InterfaceType::INPUT: {
@@ -555,6 +687,7 @@ iteration_time FederateState::requestTime(Time nextTime, IterationRequest iterat
     if (try_lock()) {  // only enter this loop once per federate
         Time lastTime = timeCoord->getGrantedTime();
         events.clear();  // clear the event queue
+        valueSnapshot.clear();
         LOG_TRACE(timeCoord->printTimeStatus());
         // timeCoord->timeRequest (nextTime, iterate, nextValueTime (), nextMessageTime ());
 
@@ -672,11 +805,13 @@ iteration_time FederateState::requestTime(Time nextTime, IterationRequest iterat
 void FederateState::fillEventVectorUpTo(Time currentTime)
 {
     events.clear();
+    pendingSnapshot.clear();
     eventMessages.clear();
     for (const auto& ipt : interfaceInformation.getInputs()) {
         bool updated = ipt->updateTimeUpTo(currentTime);
         if (updated) {
             events.push_back(ipt->id.handle);
+            captureValueUpdate(*ipt);
         }
     }
     for (const auto& ept : interfaceInformation.getEndpoints()) {
@@ -685,15 +820,19 @@ void FederateState::fillEventVectorUpTo(Time currentTime)
             eventMessages.push_back(ept->id.handle);
         }
     }
+    swapValueSnapshot();
+    updateInputMemory();
 }
 
 void FederateState::fillEventVectorInclusive(Time currentTime)
 {
     events.clear();
+    pendingSnapshot.clear();
     for (const auto& ipt : interfaceInformation.getInputs()) {
         bool updated = ipt->updateTimeInclusive(currentTime);
         if (updated) {
             events.push_back(ipt->id.handle);
+            captureValueUpdate(*ipt);
         }
     }
     eventMessages.clear();
@@ -703,15 +842,19 @@ void FederateState::fillEventVectorInclusive(Time currentTime)
             eventMessages.push_back(ept->id.handle);
         }
     }
+    swapValueSnapshot();
+    updateInputMemory();
 }
 
 void FederateState::fillEventVectorNextIteration(Time currentTime)
 {
     events.clear();
+    pendingSnapshot.clear();
     for (const auto& ipt : interfaceInformation.getInputs()) {
         bool updated = ipt->updateTimeNextIteration(currentTime);
         if (updated) {
             events.push_back(ipt->id.handle);
+            captureValueUpdate(*ipt);
         }
     }
     eventMessages.clear();
@@ -721,6 +864,26 @@ void FederateState::fillEventVectorNextIteration(Time currentTime)
             eventMessages.push_back(ept->id.handle);
         }
     }
+    swapValueSnapshot();
+    updateInputMemory();
+}
+
+void FederateState::captureValueUpdate(const InputInfo& ipt)
+{
+    pendingSnapshot.emplace_back();
+    auto& update = pendingSnapshot.back();
+    update.handle = ipt.id.handle;
+    update.data = ipt.getData(&update.inputIndex);
+    if (ipt.input_sources.size() > 1) {
+        update.allData = ipt.getAllData();
+    }
+}
+
+void FederateState::swapValueSnapshot()
+{
+    // the old snapshot becomes the next pending one so its capacity is reused
+    std::swap(valueSnapshot, pendingSnapshot);
+    pendingSnapshot.clear();
 }
 
 IterationResult FederateState::genericUnspecifiedQueueProcess()
@@ -887,6 +1050,10 @@ MessageProcessingResult FederateState::processQueue() noexcept
 
     while (!(returnableResult(ret_code))) {
         auto cmd = queue.pop();
+        if (mTrackQueueLatency) {
+            queueLatency.record(cmd.enqueueTime);
+            cmd.enqueueTime = 0;
+        }
         if (messageShouldBeDelayed(cmd)) {
             delayQueues[cmd.source_id].push_back(cmd);
             continue;
@@ -1108,7 +1275,10 @@ MessageProcessingResult FederateState::processActionMessage(ActionMessage& cmd)
                                     cmd.actionTime,
                                     time_granted));
                 }
-                epi->addMessage(createMessageFromCommand(std::move(cmd)));
+                auto source = cmd.source_id;
+                if (epi->addMessage(createMessageFromCommand(std::move(cmd)), source)) {
+                    sendMessageCredits(*epi, source, 0);
+                }
             }
         } break;
         case CMD_PUB: {
@@ -1142,11 +1312,22 @@ MessageProcessingResult FederateState::processActionMessage(ActionMessage& cmd)
             }
             for (auto& src : subI->input_sources) {
                 if ((cmd.source_id == src.fed_id) && (cmd.source_handle == src.handle)) {
+                    // while iterating if needed, a value at the granted time within the convergence
+                    // tolerance of the previous value is stored but does not call for another
+                    // iteration
+                    const bool significant =
+                        (timeCoord->iterating != IterationRequest::ITERATE_IF_NEEDED) ||
+                        (cmd.actionTime > time_granted) ||
+                        subI->isSignificantChange(src, cmd.actionTime, cmd.payload);
+                    const auto previousBytes = (mTrackMemory) ? subI->memoryUsage() : 0;
                     subI->addData(src,
                                   cmd.actionTime,
                                   cmd.counter,
                                   std::make_shared<const SmallBuffer>(std::move(cmd.payload)));
-                    if (!subI->not_interruptible) {
+                    if (mTrackMemory) {
+                        inputMemory += subI->memoryUsage() - previousBytes;
+                    }
+                    if (!subI->not_interruptible && significant) {
                         timeCoord->updateValueTime(cmd.actionTime, !timeGranted_mode);
                         LOG_TRACE(timeCoord->printTimeStatus());
                     }
@@ -1175,6 +1356,9 @@ MessageProcessingResult FederateState::processActionMessage(ActionMessage& cmd)
                                     cmd.getString(unitStringLoc))) {
                     addDependency(cmd.source_id);
                 }
+                if (subI->accepts_raw_double) {
+                    sendRawDoubleAcceptance(*subI, cmd.getSource());
+                }
             } else {
                 auto* eptI = interfaceInformation.getEndpoint(cmd.dest_handle);
                 if (eptI != nullptr) {
@@ -1246,6 +1430,12 @@ MessageProcessingResult FederateState::processActionMessage(ActionMessage& cmd)
                 global_id = cmd.dest_id;
                 interfaceInformation.setGlobalId(cmd.dest_id);
                 timeCoord->source_id = global_id;
+                // the acknowledgment carries the federation time quantum, a quantum set on the
+                // federate itself takes precedence
+                if (cmd.actionTime > timeZero &&
+                    timeCoord->getTimeProperty(defs::Properties::TIME_QUANTUM) <= timeZero) {
+                    timeCoord->setProperty(defs::Properties::TIME_QUANTUM, cmd.actionTime);
+                }
                 return MessageProcessingResult::NEXT_STEP;
             }
             break;
@@ -1329,6 +1519,30 @@ void FederateState::setInterfaceProperty(const ActionMessage& cmd)
         return;
     }
     bool used = false;
+    if (cmd.messageID == inputConvergenceToleranceOption) {
+        double tolerance{-1.0};
+        if (cmd.payload.size() == sizeof(double)) {
+            std::memcpy(&tolerance, cmd.payload.data(), sizeof(double));
+        }
+        used = interfaceInformation.setInputTolerance(cmd.dest_handle, tolerance);
+        if (!used) {
+            LOG_WARNING("convergence tolerance not used due to unknown input");
+        }
+        return;
+    }
+    if (cmd.messageID == detail::rawDoubleEncodingOption) {
+        setRawDoubleEncoding(cmd);
+        return;
+    }
+    if (cmd.messageID == inputHistoryRetentionOption) {
+        used = interfaceInformation.setInputRetention(cmd.dest_handle,
+                                                      cmd.getExtraDestData(),
+                                                      cmd.actionTime);
+        if (!used) {
+            LOG_WARNING("history retention not used due to unknown input");
+        }
+        return;
+    }
     switch (static_cast<char>(cmd.counter)) {
         case 'i':
             used = interfaceInformation.setInputProperty(cmd.dest_handle,
@@ -1389,6 +1603,41 @@ void FederateState::setInterfaceProperty(const ActionMessage& cmd)
     }
 }
 
+void FederateState::setRawDoubleEncoding(const ActionMessage& cmd)
+{
+    const bool accepted = checkActionFlag(cmd, indicator_flag);
+    if (static_cast<InterfaceType>(cmd.counter) == InterfaceType::PUBLICATION) {
+        // forwarded from the federate of a subscriber
+        auto* pub = interfaceInformation.getPublication(cmd.dest_handle);
+        if (pub != nullptr) {
+            pub->setRawDoubleSubscriber(cmd.getSource(), accepted);
+        }
+        return;
+    }
+    auto* ipt = interfaceInformation.getInput(cmd.dest_handle);
+    if (ipt == nullptr) {
+        LOG_WARNING("raw double encoding not used due to unknown input");
+        return;
+    }
+    ipt->accepts_raw_double = accepted;
+    for (const auto& source : ipt->input_sources) {
+        sendRawDoubleAcceptance(*ipt, source);
+    }
+}
+
+void FederateState::sendRawDoubleAcceptance(const InputInfo& ipt, GlobalHandle source)
+{
+    ActionMessage accept(CMD_INTERFACE_CONFIGURE);
+    accept.setSource(ipt.id);
+    accept.setDestination(source);
+    accept.messageID = detail::rawDoubleEncodingOption;
+    accept.counter = static_cast<uint16_t>(InterfaceType::PUBLICATION);
+    if (ipt.accepts_raw_double) {
+        setActionFlag(accept, indicator_flag);
+    }
+    routeMessage(accept);
+}
+
 void FederateState::setProperty(int timeProperty, Time propertyVal)
 {
     switch (timeProperty) {
@@ -1427,6 +1676,9 @@ void FederateState::setProperty(int intProperty, int propertyVal)
             rt_lag = helics::Time(static_cast<double>(propertyVal));
             rt_lead = rt_lag;
             break;
+        case defs::Properties::FEDERATE_GROUP:
+            federateGroup = propertyVal;
+            break;
         default:
             timeCoord->setProperty(intProperty, propertyVal);
     }
@@ -1600,6 +1852,8 @@ int FederateState::getIntegerProperty(int intProperty) const
         case defs::Properties::FILE_LOG_LEVEL:
         case defs::Properties::CONSOLE_LOG_LEVEL:
             return logLevel;
+        case defs::Properties::FEDERATE_GROUP:
+            return federateGroup.load();
         default:
             return timeCoord->getIntegerProperty(intProperty);
     }
@@ -1677,17 +1931,8 @@ Time FederateState::nextValueTime() const
 /** find the next Message Event*/
 Time FederateState::nextMessageTime() const
 {
-    auto firstMessageTime = Time::maxVal();
-    for (const auto& ep : interfaceInformation.getEndpoints()) {
-        auto messageTime = ep->firstMessageTime();
-        if (messageTime < time_granted) {
-            messageTime = time_granted;
-        }
-        if (messageTime < firstMessageTime) {
-            firstMessageTime = messageTime;
-        }
-    }
-    return firstMessageTime;
+    auto firstMessageTime = interfaceInformation.getMessageIndex().firstTime();
+    return (firstMessageTime < time_granted) ? time_granted : firstMessageTime;
 }
 
 void FederateState::setCoreObject(CommonCore* parent)
@@ -1855,6 +2100,34 @@ std::string FederateState::processQueryActual(std::string_view query) const
     if (query == "current_time") {
         return timeCoord->printTimeStatus();
     }
+    if (query == "queues") {
+        Json::Value base;
+        base["name"] = getIdentifier();
+        base["id"] = global_id.load().baseValue();
+        generateQueueInfo(base);
+        return fileops::generateJsonString(base);
+    }
+    if (query == "queue_latency") {
+        Json::Value base;
+        base["name"] = getIdentifier();
+        base["id"] = global_id.load().baseValue();
+        queueLatency.generateJson(base["federate_queue"]);
+        return fileops::generateJsonString(base);
+    }
+    if (query == "memory") {
+        Json::Value base;
+        base["name"] = getIdentifier();
+        base["id"] = global_id.load().baseValue();
+        generateMemoryInfo(base);
+        // applications such as the recorder can report their own buffers
+        if (queryCallback) {
+            auto appMemory = queryCallback("memory");
+            if (!appMemory.empty() && appMemory.front() == '{') {
+                base["application"] = fileops::loadJsonStr(appMemory);
+            }
+        }
+        return fileops::generateJsonString(base);
+    }
     if (query == "current_state") {
         Json::Value base;
         base["name"] = getIdentifier();
@@ -1976,7 +2249,7 @@ std::string FederateState::processQuery(const std::string& query, bool force_ord
         qstring = processQueryActual(query);
     } else if ((query == "queries") || (query == "available_queries")) {
         qstring =
-            R"("publications","inputs","endpoints","subscriptions","current_state","global_state","dependencies","timeconfig","config","dependents","current_time")";
+            R"("publications","inputs","endpoints","subscriptions","current_state","global_state","dependencies","timeconfig","config","dependents","current_time","queues","queue_latency","memory")";
     } else {  // the rest might to prevent a race condition
         if (try_lock()) {
             qstring = processQueryActual(query);
@@ -11,6 +11,7 @@ SPDX-License-Identifier: BSD-3-Clause
 #include "BasicHandleInfo.hpp"
 #include "CoreTypes.hpp"
 #include "InterfaceInfo.hpp"
+#include "LatencyHistogram.hpp"
 #include "core-data.hpp"
 #include "gmlc/containers/BlockingQueue.hpp"
 #include "helicsTime.hpp"
@@ -85,6 +86,13 @@ class FederateState {
     /// flag indicating that the profiling should be captured in the federate log instead of
     /// forwarded
     bool mLocalProfileCapture{false};
+    /// flag indicating the time commands spend in the federate queue should be recorded
+    bool mTrackQueueLatency{false};
+    LatencyHistogram queueLatency;  //!< time spent by commands in the federate queue
+    /// flag indicating the bytes held by the inputs should be tracked for the core memory limit
+    bool mTrackMemory{false};
+    /// bytes held by the inputs, maintained by the thread processing the federate
+    std::atomic<std::uint64_t> inputMemory{0};
     int errorCode{0};  //!< storage for an error code
     CommonCore* parent_{nullptr};  //!< pointer to the higher level;
     std::string errorString;  //!< storage for an error string populated on an error
@@ -106,6 +114,8 @@ class FederateState {
     bool terminate_on_error{false};  //!< indicator that if the federate encounters a configuration
                                      //!< error it should cause a co-simulation abort
     int logLevel{HELICS_LOG_LEVEL_WARNING};  //!< the level of logging used in the federate
+    /// the federate group the federate belongs to (0 for no group)
+    std::atomic<int32_t> federateGroup{0};
 
     std::shared_ptr<MessageTimer>
         mTimer;  //!< message timer object for real time operations and timeouts
@@ -118,7 +128,13 @@ class FederateState {
     std::map<GlobalFederateId, std::deque<ActionMessage>>
         delayQueues;  //!< queue for delaying processing of messages for a time
     std::vector<InterfaceHandle> events;  //!< list of value events to process
+    /// the input values visible to the federate after the most recent grant
+    std::vector<ValueUpdate> valueSnapshot;
+    /// the snapshot under construction, swapped with valueSnapshot when complete
+    std::vector<ValueUpdate> pendingSnapshot;
     std::vector<InterfaceHandle> eventMessages;  //!< list of endpoints with messages to process
+    /// interface registrations held until the federate requests initialization
+    guarded<std::vector<ActionMessage>> stagedRegistrations;
     std::vector<GlobalFederateId> delayedFederates;  //!< list of federates to delay messages from
     Time time_granted{startupTime};  //!< the most recent granted time;
     Time allowed_send_time{startupTime};  //!< the next time a message can be sent;
@@ -147,6 +163,22 @@ class FederateState {
     void generateConfig(Json::Value& base) const;
 
   public:
+    /** load the occupancy of the federate action queue and endpoint queues into a json object*/
+    void generateQueueInfo(Json::Value& base) const;
+    /** load the memory held by the queues, input values, and endpoint messages into a json object
+    @return the total number of bytes*/
+    std::uint64_t generateMemoryInfo(Json::Value& base) const;
+    /** get an estimate of the bytes held by the queue and interface buffers of the federate
+    @details the input values are read from a counter kept by the federate so this is safe to call
+    from the core while the federate operates; the counter is only maintained if memory tracking
+    is turned on*/
+    std::uint64_t bufferedMemory() const;
+    /** turn on tracking of the bytes held by the inputs for use in bufferedMemory*/
+    void setMemoryTracking(bool track) { mTrackMemory = track; }
+    /** turn on recording of the time commands spend in the federate queue*/
+    void setQueueLatencyTracking(bool track) { mTrackQueueLatency = track; }
+    /** get the histogram of the time commands spend in the federate queue*/
+    const LatencyHistogram& getQueueLatency() const { return queueLatency; }
     /** reset the federate to created state*/
     void reset();
     /** reset the federate to the initializing state*/
@@ -181,6 +213,11 @@ class FederateState {
      */
     const std::shared_ptr<const SmallBuffer>& getValue(InterfaceHandle handle,
                                                        uint32_t* inputIndex);
+    /**
+     * Return the retained value of an input in effect at a particular time
+     */
+    const std::shared_ptr<const SmallBuffer>&
+        getValueAt(InterfaceHandle handle, Time valueTime, uint32_t* inputIndex);
 
     /**
      * Return all the available data for the specified handle or the latest input
@@ -251,6 +288,8 @@ class FederateState {
     void unlock() const { processing.clear(); }
     /** get the current logging level*/
     int loggingLevel() const { return logLevel; }
+    /** get the federate group of the federate, 0 if the federate is not part of a group*/
+    int32_t getFederateGroup() const { return federateGroup.load(); }
 
     /** set a tag (key-value pair)*/
     void setTag(const std::string& tag, const std::string& value);
@@ -302,6 +341,12 @@ class FederateState {
     @param currentTime the time of the update
     */
     void fillEventVectorNextIteration(Time currentTime);
+    /** add the current value of an updated input to the pending snapshot*/
+    void captureValueUpdate(const InputInfo& ipt);
+    /** make the pending snapshot visible to the federate*/
+    void swapValueSnapshot();
+    /** recompute the bytes held by the inputs if memory tracking is active*/
+    void updateInputMemory();
     /** add a dependency to the timing coordination*/
     void addDependency(GlobalFederateId fedToDependOn);
     /** add a dependent federate*/
@@ -316,6 +361,11 @@ class FederateState {
     void generateProfilingMessage(bool enterHelicsCode);
     /** generate a timing marker message system time + steady time*/
     void generateProfilingMarker();
+    /** send any credits for consumed messages on an endpoint back to their sources
+    @param all true to send all the credits instead of waiting for a full batch*/
+    void returnMessageCredits(EndpointInfo& ept, bool all = false);
+    /** send message credits and the receive capacity of an endpoint to a source federate*/
+    void sendMessageCredits(const EndpointInfo& ept, GlobalFederateId source, int32_t credits);
 
   public:
     /** get the granted time of a federate*/
@@ -325,6 +375,10 @@ class FederateState {
     /**get a reference to the handles of subscriptions with value updates
      */
     const std::vector<InterfaceHandle>& getEvents() const;
+    /** get the values of the inputs updated at the most recent grant
+    @details the snapshot is assembled with the events and remains valid until the next time or
+    mode request*/
+    const std::vector<ValueUpdate>& getValueSnapshot() const { return valueSnapshot; }
     /** get a vector of the federates this one depends on
      */
     std::vector<GlobalFederateId> getDependencies() const;
@@ -417,9 +471,21 @@ class FederateState {
     @return true if it should be published, false if not
     */
     bool checkAndSetValue(InterfaceHandle pub_id, const char* data, uint64_t len);
+    /** check a batch of values and get the subscribers for each under a single lock
+    @param values the publication handles and data to check
+    @param active indicators of which values to check, inactive values get no subscribers
+    @return the subscribers for each value, empty if the value should not be published*/
+    std::vector<std::vector<GlobalHandle>>
+        checkAndGetSubscribers(const std::vector<std::pair<InterfaceHandle, SmallBuffer>>& values,
+                               const std::vector<bool>& active);
 
     /** route a message either forward to parent or add to queue*/
     void routeMessage(const ActionMessage& msg);
+    /** record the raw double acceptance of an input or of a subscriber to a publication*/
+    void setRawDoubleEncoding(const ActionMessage& cmd);
+    /** tell a publication connected to an input whether the input accepts the raw double
+    encoding*/
+    void sendRawDoubleAcceptance(const InputInfo& ipt, GlobalHandle source);
     /** create an interface*/
     void createInterface(InterfaceType htype,
                          InterfaceHandle handle,
@@ -428,6 +494,13 @@ class FederateState {
                          const std::string& units);
     /** close an interface*/
     void closeInterface(InterfaceHandle handle, InterfaceType type);
+    /** hold an interface registration command while the federate is in the created state
+    @details registrations from each federate are collected locally so federates registering in
+    parallel do not contend on the core queue
+    @return true if the command was staged, false if it should be sent directly*/
+    bool stageRegistration(ActionMessage& command);
+    /** remove and return the staged registration commands, staging stops once init is requested*/
+    std::vector<ActionMessage> takeStagedRegistrations();
     /** send a command to a federate*/
     void sendCommand(ActionMessage& command);
 
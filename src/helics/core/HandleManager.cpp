@@ -370,4 +370,22 @@ std::string HandleManager::generateName(InterfaceType what) const
             return std::string("_handle_") + std::to_string(handles.size());
     }
 }
+
+std::uint64_t HandleManager::memoryUsage() const
+{
+    // each map entry is a node with the value and about two pointers of overhead
+    constexpr std::uint64_t mapNodeOverhead{2 * sizeof(void*)};
+    std::uint64_t bytes{0};
+    for (const auto& handle : handles) {
+        bytes += sizeof(BasicHandleInfo) + handle.key.size() + handle.type.size() +
+            handle.units.size();
+    }
+    const auto searchEntries =
+        publications.size() + endpoints.size() + inputs.size() + filters.size();
+    bytes += searchEntries *
+        (sizeof(std::pair<const std::string_view, InterfaceHandle>) + mapNodeOverhead);
+    bytes +=
+        unique_ids.size() * (sizeof(std::pair<const std::uint64_t, int32_t>) + mapNodeOverhead);
+    return bytes;
+}
 }  // namespace helics
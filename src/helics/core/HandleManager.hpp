@@ -107,6 +107,8 @@ class HandleManager {
     auto begin() const { return handles.begin(); }
     auto end() const { return handles.end(); }
     auto size() const { return handles.size(); }
+    /** get the approximate memory used by the handles and the search maps in bytes*/
+    std::uint64_t memoryUsage() const;
 
   private:
     void addSearchFields(const BasicHandleInfo& handle, int32_t index);
@@ -7,9 +7,13 @@ SPDX-License-Identifier: BSD-3-Clause
 #include "InputInfo.hpp"
 
 #include "../common/JsonGeneration.hpp"
+#include "ValueEncoding.hpp"
 #include "units/units/units.hpp"
 
 #include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
 #include <memory>
 #include <set>
 #include <string>
@@ -73,6 +77,80 @@ const std::shared_ptr<const SmallBuffer>& InputInfo::getData(uint32_t* inputInde
     return NullData;
 }
 
+const std::shared_ptr<const SmallBuffer>& InputInfo::getDataAt(Time valueTime,
+                                                                uint32_t* inputIndex) const
+{
+    int ind{0};
+    int mxind{-1};
+    Time mxTime{Time::minVal()};
+    const std::shared_ptr<const SmallBuffer>* result{&NullData};
+    for (const auto& hist : history) {
+        // records are in time order so the last one not after valueTime is the active value
+        auto rec = std::upper_bound(hist.begin(),
+                                    hist.end(),
+                                    valueTime,
+                                    [](Time tm, const dataRecord& record) {
+                                        return tm < record.time;
+                                    });
+        if (rec != hist.begin()) {
+            --rec;
+            if (rec->time > mxTime ||
+                (rec->time == mxTime && priorityCheck(ind, mxind, priority_sources))) {
+                mxTime = rec->time;
+                mxind = ind;
+                result = &rec->data;
+            }
+        }
+        ++ind;
+    }
+    if (inputIndex != nullptr) {
+        *inputIndex = (mxind >= 0) ? mxind : 0;
+    }
+    return *result;
+}
+
+void InputInfo::setHistoryRetention(int32_t valueCount, Time window)
+{
+    history_count = (valueCount > 0) ? valueCount : 0;
+    history_window = (window > timeZero) ? window : timeZero;
+    if (!retainsHistory()) {
+        for (auto& hist : history) {
+            hist.clear();
+            hist.shrink_to_fit();
+        }
+        return;
+    }
+    for (auto& hist : history) {
+        trimHistory(hist);
+    }
+}
+
+void InputInfo::retainHistory(int index,
+                              std::vector<dataRecord>::const_iterator first,
+                              std::vector<dataRecord>::const_iterator last)
+{
+    auto& hist = history[index];
+    // the records share the value buffers with the queue so nothing is copied but the pointers
+    hist.insert(hist.end(), first, last);
+    trimHistory(hist);
+}
+
+void InputInfo::trimHistory(std::deque<dataRecord>& hist) const
+{
+    if (history_count > 0) {
+        while (hist.size() > static_cast<std::size_t>(history_count)) {
+            hist.pop_front();
+        }
+    }
+    if (history_window > timeZero && !hist.empty()) {
+        const Time cutoff = hist.back().time - history_window;
+        // keep the value in effect at the cutoff so reads at the edge of the window resolve
+        while (hist.size() > 1 && hist[1].time <= cutoff) {
+            hist.pop_front();
+        }
+    }
+}
+
 static auto recordComparison = [](const InputInfo::dataRecord& rec1,
                                   const InputInfo::dataRecord& rec2) {
     return (rec1.time < rec2.time) ?
@@ -111,6 +189,120 @@ void InputInfo::addData(GlobalHandle source_id,
     }
 }
 
+namespace {
+    /** view of the numeric values in a data block
+    @details the layout mirrors the value encoding used by the application api, an 8 byte raw
+    little endian double or an 8 byte header followed by the values for doubles, integers, and
+    vectors of doubles*/
+    struct NumericView {
+        const std::byte* values{nullptr};
+        std::size_t count{0};
+        bool integer{false};
+        bool swap{false};
+    };
+
+    /** get a view of the numeric values in a data block
+    @param rawDouble set to true if the block may be in the raw double encoding*/
+    NumericView numericView(const SmallBuffer& data, bool rawDouble)
+    {
+        NumericView view;
+        if (data.size() == detail::rawDoubleSize) {
+            if (rawDouble) {
+                view.values = data.data();
+                view.count = 1;
+                view.swap = !detail::checks::isLittleEndian();
+            }
+            return view;
+        }
+        if (data.size() < 16) {
+            return view;
+        }
+        const auto* bytes = data.data();
+        const auto code = bytes[0] & ~detail::endianMask;
+        std::size_t count{0};
+        if (code == detail::doubleCode || code == detail::intCode) {
+            count = 1;
+        } else if (code == detail::vectorCode) {
+            for (int ii = 4; ii < 8; ++ii) {
+                count = (count << 8U) + std::to_integer<std::size_t>(bytes[ii]);
+            }
+        } else {
+            return view;
+        }
+        if (data.size() < 8 + count * sizeof(double)) {
+            return view;
+        }
+        view.values = bytes + 8;
+        view.count = count;
+        view.integer = (code == detail::intCode);
+        view.swap = ((bytes[0] & detail::endianMask) != detail::littleEndianCode);
+        return view;
+    }
+
+    double numericValue(const NumericView& view, std::size_t index)
+    {
+        std::byte raw[8];
+        std::memcpy(raw, view.values + index * 8, 8);
+        if (view.swap) {
+            detail::checks::swapBytes<8>(raw);
+        }
+        if (view.integer) {
+            std::int64_t ival;
+            std::memcpy(&ival, raw, 8);
+            return static_cast<double>(ival);
+        }
+        double val;
+        std::memcpy(&val, raw, 8);
+        return val;
+    }
+}  // namespace
+
+bool InputInfo::isSignificantChange(GlobalHandle source_id,
+                                    Time valueTime,
+                                    const SmallBuffer& data) const
+{
+    if (convergence_tolerance < 0.0) {
+        return true;
+    }
+    auto src = std::find(input_sources.begin(), input_sources.end(), source_id);
+    if (src == input_sources.end()) {
+        return true;
+    }
+    auto index = static_cast<std::size_t>(src - input_sources.begin());
+    const SmallBuffer* previous{nullptr};
+    const auto& queue = data_queues[index];
+    for (auto rec = queue.rbegin(); rec != queue.rend(); ++rec) {
+        if (rec->time <= valueTime) {
+            previous = rec->data.get();
+            break;
+        }
+    }
+    if (previous == nullptr) {
+        previous = current_data[index].get();
+    }
+    if (previous == nullptr) {
+        return true;
+    }
+    if (*previous == data) {
+        return false;
+    }
+    // only publications declared as double send the raw encoding and only to inputs accepting it
+    const bool rawDouble = accepts_raw_double && source_info[index].type == "double";
+    auto oldView = numericView(*previous, rawDouble);
+    auto newView = numericView(data, rawDouble);
+    if (oldView.count == 0 || oldView.count != newView.count) {
+        return true;
+    }
+    for (std::size_t ii = 0; ii < oldView.count; ++ii) {
+        auto diff = std::abs(numericValue(newView, ii) - numericValue(oldView, ii));
+        // written so a NaN difference counts as a change
+        if (!(diff <= convergence_tolerance)) {
+            return true;
+        }
+    }
+    return false;
+}
+
 bool InputInfo::addSource(GlobalHandle newSource,
                           const std::string& sourceName,
                           const std::string& stype,
@@ -127,6 +319,7 @@ bool InputInfo::addSource(GlobalHandle newSource,
     input_sources.push_back(newSource);
     source_info.emplace_back(sourceName, stype, sunits);
     data_queues.resize(input_sources.size());
+    history.resize(input_sources.size());
     current_data.resize(input_sources.size());
     current_data_time.resize(input_sources.size(), {Time::minVal(), 0});
     deactivated.push_back(Time::maxVal());
@@ -176,6 +369,38 @@ void InputInfo::clearFutureData()
     }
 }
 
+static std::uint64_t valueMemory(const std::shared_ptr<const SmallBuffer>& value)
+{
+    if (!value) {
+        return 0U;
+    }
+    return sizeof(SmallBuffer) + (value->ownsHeapMemory() ? value->capacity() : 0U);
+}
+
+std::uint64_t InputInfo::memoryUsage() const
+{
+    std::uint64_t bytes{0};
+    for (const auto& value : current_data) {
+        bytes += valueMemory(value);
+    }
+    for (const auto& queue : data_queues) {
+        bytes += queue.capacity() * sizeof(dataRecord);
+        for (const auto& record : queue) {
+            bytes += valueMemory(record.data);
+        }
+    }
+    for (std::size_t ii = 0; ii < history.size(); ++ii) {
+        bytes += history[ii].size() * sizeof(dataRecord);
+        for (const auto& record : history[ii]) {
+            // the most recent record usually shares its buffer with the current value
+            if (record.data != current_data[ii]) {
+                bytes += valueMemory(record.data);
+            }
+        }
+    }
+    return bytes;
+}
+
 const std::string& InputInfo::getInjectionType() const
 {
     if (inputType.empty()) {
@@ -282,6 +507,9 @@ bool InputInfo::updateTimeUpTo(Time newTime)
             ++currentValue;
         }
 
+        if (retainsHistory()) {
+            retainHistory(index, data_queue.begin(), currentValue);
+        }
         auto res = updateData(std::move(*last), index);
         data_queue.erase(data_queue.begin(), currentValue);
         ++index;
@@ -324,6 +552,9 @@ bool InputInfo::updateTimeNextIteration(Time newTime)
             }
         }
 
+        if (retainsHistory()) {
+            retainHistory(index, data_queue.begin(), currentValue);
+        }
         auto res = updateData(std::move(*last), index);
         data_queue.erase(data_queue.begin(), currentValue);
         ++index;
@@ -356,6 +587,9 @@ bool InputInfo::updateTimeInclusive(Time newTime)
             ++currentValue;
         }
 
+        if (retainsHistory()) {
+            retainHistory(index, data_queue.begin(), currentValue);
+        }
         auto res = updateData(std::move(*last), index);
         data_queue.erase(data_queue.begin(), currentValue);
         ++index;
@@ -8,6 +8,7 @@ SPDX-License-Identifier: BSD-3-Clause
 
 #include "basic_CoreTypes.hpp"
 
+#include <deque>
 #include <memory>
 #include <string>
 #include <tuple>
@@ -76,7 +77,13 @@ class InputInfo {
     bool strict_type_matching{
         false};  //!< indicator that the handle need to have strict type matching
     bool ignore_unit_mismatch{false};  //!< ignore unit mismatches
+    /// the input accepts the raw double encoding from double publications
+    bool accepts_raw_double{false};
+    /// values at the granted time closer than this to the previous value do not trigger iterations
+    double convergence_tolerance{-1.0};
     int32_t required_connnections{0};  //!< an exact number of connections required
+    int32_t history_count{0};  //!< the number of past values to retain for each source
+    Time history_window{timeZero};  //!< the span of time to retain past values for each source
     std::vector<std::pair<helics::Time, unsigned int>>
         current_data_time;  //!< the most recent published data times
     std::vector<std::shared_ptr<const SmallBuffer>>
@@ -87,6 +94,8 @@ class InputInfo {
     std::vector<int32_t> priority_sources;  //!< the list of priority inputs;
   private:
     std::vector<std::vector<dataRecord>> data_queues;  //!< queue of the data
+    /// values of each source that were moved out of the queue and retained for time shifted reads
+    std::vector<std::deque<dataRecord>> history;
 
   public:
     /** get all the current data*/
@@ -95,12 +104,34 @@ class InputInfo {
     const std::shared_ptr<const SmallBuffer>& getData(int index) const;
     /** get a the most recent data point*/
     const std::shared_ptr<const SmallBuffer>& getData(uint32_t* inputIndex) const;
+    /** get the retained data point in effect at a particular time
+    @details selects the most recent value at or before valueTime across all sources using the same
+    priority rules as getData
+    @return a null pointer if no value at or before valueTime is retained*/
+    const std::shared_ptr<const SmallBuffer>& getDataAt(Time valueTime,
+                                                        uint32_t* inputIndex) const;
+    /** set the retention policy for past values
+    @details a value is kept while it is one of the most recent valueCount values of its source and
+    while it is needed to answer reads within window of the most recent value, a limit of zero
+    disables that check and disabling both clears the retained values
+    @param valueCount the number of values to keep for each source
+    @param window the span of time before the most recent value which can be read*/
+    void setHistoryRetention(int32_t valueCount, Time window);
+    /** check if past values are retained*/
+    bool retainsHistory() const { return history_count > 0 || history_window > timeZero; }
     /** add a data block into the queue*/
     void addData(GlobalHandle source_id,
                  Time valueTime,
                  unsigned int iteration,
                  std::shared_ptr<const SmallBuffer> data);
 
+    /** check if a new data block would be a significant change for convergence purposes
+    @details numeric values are compared element wise against the most recent value from the same
+    source at or before valueTime, other values must match exactly to be considered unchanged
+    @return true if the difference exceeds the convergence tolerance, if the tolerance is negative,
+    or if there is no previous value*/
+    bool isSignificantChange(GlobalHandle source_id, Time valueTime, const SmallBuffer& data) const;
+
     /** update current data not including data at the specified time
     @param newTime the time to move the subscription to
     @return true if the value has changed
@@ -132,6 +163,9 @@ class InputInfo {
     void removeSource(const std::string& sourceName, Time minTime);
     /** clear all non-current data*/
     void clearFutureData();
+    /** get the approximate memory held by the current and queued values in bytes
+    @details values shared with other inputs are counted in each of them*/
+    std::uint64_t memoryUsage() const;
 
     const std::string& getInjectionType() const;
     const std::string& getInjectionUnits() const;
@@ -141,6 +175,12 @@ class InputInfo {
 
   private:
     bool updateData(dataRecord&& update, int index);
+    /** copy the records moved out of a data queue into the history and trim it to the policy*/
+    void retainHistory(int index,
+                       std::vector<dataRecord>::const_iterator first,
+                       std::vector<dataRecord>::const_iterator last);
+    /** remove the records no longer covered by the retention policy*/
+    void trimHistory(std::deque<dataRecord>& hist) const;
     mutable std::string inputUnits;
     mutable std::string inputType;
     mutable std::string sourceTargets;
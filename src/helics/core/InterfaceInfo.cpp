@@ -8,6 +8,7 @@ SPDX-License-Identifier: BSD-3-Clause
 
 #include "../common/JsonProcessingFunctions.hpp"
 #include "../common/fmt_format.h"
+#include "ValueEncoding.hpp"
 #include "helics_definitions.hpp"
 
 #include <sstream>
@@ -39,7 +40,7 @@ void InterfaceInfo::createEndpoint(InterfaceHandle handle,
                                    const std::string& type)
 {
     endpoints.lock()->insert(
-        endpointName, handle, GlobalHandle{global_id, handle}, endpointName, type);
+        endpointName, handle, GlobalHandle{global_id, handle}, endpointName, type, &messageIndex);
 }
 
 void InterfaceInfo::setChangeUpdateFlag(bool updateFlag)
@@ -161,6 +162,26 @@ bool InterfaceInfo::setInputProperty(InterfaceHandle id, int32_t option, int32_t
     return true;
 }
 
+bool InterfaceInfo::setInputTolerance(InterfaceHandle id, double tolerance)
+{
+    auto* ipt = getInput(id);
+    if (ipt == nullptr) {
+        return false;
+    }
+    ipt->convergence_tolerance = tolerance;
+    return true;
+}
+
+bool InterfaceInfo::setInputRetention(InterfaceHandle id, int32_t valueCount, Time window)
+{
+    auto* ipt = getInput(id);
+    if (ipt == nullptr) {
+        return false;
+    }
+    ipt->setHistoryRetention(valueCount, window);
+    return true;
+}
+
 bool InterfaceInfo::setPublicationProperty(InterfaceHandle id, int32_t option, int32_t value)
 {
     auto* pub = getPublication(id);
@@ -211,6 +232,9 @@ bool InterfaceInfo::setEndpointProperty(InterfaceHandle id, int32_t option, int3
         case defs::Options::CONNECTION_OPTIONAL:
             ept->required = !bvalue;
             break;
+        case defs::Options::RECEIVE_CAPACITY:
+            ept->receiveCapacity = (value > 0) ? value : 0;
+            break;
         default:
             return false;
             break;
@@ -229,6 +253,9 @@ int32_t InterfaceInfo::getInputProperty(InterfaceHandle id, int32_t option) cons
         case defs::Options::IGNORE_INTERRUPTS:
             flagval = ipt->not_interruptible;
             break;
+        case detail::rawDoubleEncodingOption:
+            flagval = ipt->accepts_raw_double;
+            break;
         case defs::Options::HANDLE_ONLY_UPDATE_ON_CHANGE:
             flagval = ipt->only_update_on_change;
             break;
@@ -288,6 +315,9 @@ int32_t InterfaceInfo::getPublicationProperty(InterfaceHandle id, int32_t option
             break;
         case defs::Options::CONNECTIONS:
             return static_cast<int32_t>(pub->subscribers.size());
+        case detail::rawDoubleEncodingOption:
+            flagval = pub->rawDoubleAccepted.load();
+            break;
         default:
             break;
     }
@@ -308,6 +338,8 @@ int32_t InterfaceInfo::getEndpointProperty(InterfaceHandle id, int32_t option) c
         case defs::Options::CONNECTION_OPTIONAL:
             flagval = !ept->required;
             break;
+        case defs::Options::RECEIVE_CAPACITY:
+            return ept->receiveCapacity;
         default:
             break;
     }
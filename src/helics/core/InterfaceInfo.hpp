@@ -22,6 +22,13 @@ SPDX-License-Identifier: BSD-3-Clause
  * federate
  */
 namespace helics {
+/// option id of an interface configure command carrying an input convergence tolerance as a
+/// double in the payload
+constexpr int32_t inputConvergenceToleranceOption{-1001};
+/// option id of an interface configure command carrying an input history retention policy, the
+/// value count in the extra destination data and the time window as the action time
+constexpr int32_t inputHistoryRetentionOption{-1002};
+
 /** generic class for holding information about interfaces for a core federate structure*/
 class InterfaceInfo {
   public:
@@ -60,6 +67,8 @@ class InterfaceInfo {
     auto cgetEndpoints() const { return endpoints.lock_shared(); }
     auto cgetPublications() const { return publications.lock_shared(); }
     auto cgetInputs() const { return inputs.lock_shared(); }
+    /** get the index of the first queued message of each endpoint*/
+    const MessageHeadIndex& getMessageIndex() const { return messageIndex; }
     /** set the global id of the federate for use in the interfaces*/
     void setGlobalId(GlobalFederateId newglobalId) { global_id = newglobalId; }
     /** set the change update flag which controls when a subscription is updated*/
@@ -70,6 +79,12 @@ class InterfaceInfo {
     bool setInputProperty(InterfaceHandle id, int32_t option, int32_t value);
     bool setPublicationProperty(InterfaceHandle id, int32_t option, int32_t value);
     bool setEndpointProperty(InterfaceHandle id, int32_t option, int32_t value);
+    /** set the convergence tolerance of an input
+    @return true if the input exists*/
+    bool setInputTolerance(InterfaceHandle id, double tolerance);
+    /** set the history retention policy of an input
+    @return true if the input exists*/
+    bool setInputRetention(InterfaceHandle id, int32_t valueCount, Time window);
     /** get properties for an interface*/
     int32_t getInputProperty(InterfaceHandle id, int32_t option) const;
     int32_t getPublicationProperty(InterfaceHandle id, int32_t option) const;
@@ -86,6 +101,8 @@ class InterfaceInfo {
     std::atomic<GlobalFederateId> global_id;
     bool only_update_on_change{
         false};  //!< flag indicating that subscriptions values should only be updated on change
+    /// the endpoint message index, declared before the endpoints so it outlives them
+    MessageHeadIndex messageIndex;
     shared_guarded<
         gmlc::containers::DualMappedPointerVector<PublicationInfo, std::string, InterfaceHandle>>
         publications;  //!< storage for all the publications
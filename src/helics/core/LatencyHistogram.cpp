@@ -0,0 +1,71 @@
+/*
+Copyright (c) 2017-2021,
+Battelle Memorial Institute; Lawrence Livermore National Security, LLC; Alliance for Sustainable
+Energy, LLC.  See the top-level NOTICE for additional details. All rights reserved.
+SPDX-License-Identifier: BSD-3-Clause
+*/
+#include "LatencyHistogram.hpp"
+
+#include "json/json.h"
+
+namespace helics {
+void LatencyHistogram::record(int64_t enqueueTime)
+{
+    if (enqueueTime > 0) {
+        recordLatency(std::chrono::nanoseconds(now() - enqueueTime));
+    }
+}
+
+void LatencyHistogram::recordLatency(std::chrono::nanoseconds latency)
+{
+    auto nanoseconds = static_cast<uint64_t>((latency.count() > 0) ? latency.count() : 0);
+    auto micro = nanoseconds / 1000U;
+    int index{0};
+    while (micro > 0U && index < bucketCount - 1) {
+        micro >>= 1U;
+        ++index;
+    }
+    buckets[index].fetch_add(1, std::memory_order_relaxed);
+    total.fetch_add(1, std::memory_order_relaxed);
+    totalNanoseconds.fetch_add(nanoseconds, std::memory_order_relaxed);
+    auto prevMax = maxNanoseconds.load(std::memory_order_relaxed);
+    while (nanoseconds > prevMax &&
+           !maxNanoseconds.compare_exchange_weak(prevMax, nanoseconds, std::memory_order_relaxed)) {
+    }
+}
+
+double LatencyHistogram::percentile(double fraction) const
+{
+    auto cnt = count();
+    if (cnt == 0U) {
+        return 0.0;
+    }
+    auto target = static_cast<uint64_t>(fraction * static_cast<double>(cnt));
+    uint64_t accumulated{0};
+    for (int ii = 0; ii < bucketCount - 1; ++ii) {
+        accumulated += bucket(ii);
+        if (accumulated > target) {
+            return static_cast<double>(uint64_t{1} << ii);
+        }
+    }
+    return static_cast<double>(maxNanoseconds.load(std::memory_order_relaxed)) / 1000.0;
+}
+
+void LatencyHistogram::generateJson(Json::Value& base) const
+{
+    auto cnt = count();
+    base["count"] = static_cast<Json::UInt64>(cnt);
+    base["mean_us"] = (cnt > 0U) ?
+        static_cast<double>(totalNanoseconds.load(std::memory_order_relaxed)) /
+            (1000.0 * static_cast<double>(cnt)) :
+        0.0;
+    base["max_us"] = static_cast<double>(maxNanoseconds.load(std::memory_order_relaxed)) / 1000.0;
+    base["p50_us"] = percentile(0.5);
+    base["p99_us"] = percentile(0.99);
+    base["buckets"] = Json::arrayValue;
+    for (int ii = 0; ii < bucketCount; ++ii) {
+        base["buckets"].append(static_cast<Json::UInt64>(bucket(ii)));
+    }
+}
+
+}  // namespace helics
@@ -0,0 +1,53 @@
+/*
+Copyright (c) 2017-2021,
+Battelle Memorial Institute; Lawrence Livermore National Security, LLC; Alliance for Sustainable
+Energy, LLC.  See the top-level NOTICE for additional details. All rights reserved.
+SPDX-License-Identifier: BSD-3-Clause
+*/
+#pragma once
+
+#include "json/forwards.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace helics {
+/** histogram of the time messages spend waiting in a queue
+@details bucket i counts latencies under 2^i microseconds, the last bucket counts everything
+larger. Recording is lock free and may be done from one thread while another reads the results.
+*/
+class LatencyHistogram {
+  public:
+    static constexpr int bucketCount{24};
+    /** get the current time in the form used for enqueue timestamps*/
+    static int64_t now()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+    }
+    /** record the latency of a single message
+    @param enqueueTime the time the message was queued from now(), 0 if it was not stamped*/
+    void record(int64_t enqueueTime);
+    /** record a latency directly*/
+    void recordLatency(std::chrono::nanoseconds latency);
+    /** get the number of latencies recorded*/
+    uint64_t count() const { return total.load(std::memory_order_relaxed); }
+    /** get the count in a specific bucket*/
+    uint64_t bucket(int index) const { return buckets[index].load(std::memory_order_relaxed); }
+    /** get the upper bound of the bucket containing the given fraction of the recorded latencies
+    in microseconds*/
+    double percentile(double fraction) const;
+    /** load the summary of the histogram into a json object*/
+    void generateJson(Json::Value& base) const;
+
+  private:
+    std::array<std::atomic<uint64_t>, bucketCount> buckets{};
+    std::atomic<uint64_t> total{0};
+    std::atomic<uint64_t> totalNanoseconds{0};
+    std::atomic<uint64_t> maxNanoseconds{0};
+};
+
+}  // namespace helics
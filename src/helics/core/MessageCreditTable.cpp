@@ -0,0 +1,111 @@
+/*
+Copyright (c) 2017-2021,
+Battelle Memorial Institute; Lawrence Livermore National Security, LLC; Alliance for Sustainable
+Energy, LLC.  See the top-level NOTICE for additional details. All rights reserved.
+SPDX-License-Identifier: BSD-3-Clause
+*/
+#include "MessageCreditTable.hpp"
+
+#include <algorithm>
+
+namespace helics {
+void MessageCreditTable::updateCredits(GlobalFederateId source,
+                                       GlobalHandle endpoint,
+                                       std::string_view name,
+                                       int32_t capacity,
+                                       int32_t credits)
+{
+    {
+        std::lock_guard<std::mutex> lock(creditLock);
+        auto& fedWindows = windows[source];
+        auto fnd = fedWindows.find(endpoint);
+        if (capacity <= 0) {
+            if (fnd != fedWindows.end()) {
+                fedWindows.erase(fnd);
+            }
+            if (fedWindows.empty()) {
+                windows.erase(source);
+            }
+            active.store(!windows.empty());
+        } else {
+            if (fnd == fedWindows.end()) {
+                fnd = fedWindows.emplace(endpoint, Window{}).first;
+            }
+            fnd->second.capacity = capacity;
+            fnd->second.outstanding = std::max(fnd->second.outstanding - credits, 0);
+            if (fnd->second.outstanding < fnd->second.capacity) {
+                fnd->second.overdrawn = false;
+            }
+            if (!name.empty()) {
+                auto known = endpointNames.find(name);
+                if (known == endpointNames.end()) {
+                    endpointNames.emplace(std::string(name), endpoint);
+                } else {
+                    known->second = endpoint;
+                }
+            }
+            active.store(true);
+        }
+    }
+    creditAvailable.notify_all();
+}
+
+bool MessageCreditTable::acquire(GlobalFederateId source,
+                                 GlobalHandle endpoint,
+                                 std::chrono::milliseconds timeout)
+{
+    std::unique_lock<std::mutex> lock(creditLock);
+    auto stopTime = std::chrono::steady_clock::now() + timeout;
+    while (true) {
+        // the table may have changed while waiting
+        auto fed = windows.find(source);
+        if (fed == windows.end()) {
+            return true;
+        }
+        auto fnd = fed->second.find(endpoint);
+        if (fnd == fed->second.end()) {
+            return true;
+        }
+        auto& window = fnd->second;
+        if (window.overdrawn || window.outstanding < window.capacity) {
+            ++window.outstanding;
+            return true;
+        }
+        if (creditAvailable.wait_until(lock, stopTime) == std::cv_status::timeout) {
+            window.overdrawn = true;
+            ++window.outstanding;
+            return false;
+        }
+    }
+}
+
+GlobalHandle MessageCreditTable::findEndpoint(std::string_view name) const
+{
+    std::lock_guard<std::mutex> lock(creditLock);
+    auto fnd = endpointNames.find(name);
+    return (fnd != endpointNames.end()) ? fnd->second : GlobalHandle{};
+}
+
+int32_t MessageCreditTable::outstanding(GlobalFederateId source, GlobalHandle endpoint) const
+{
+    std::lock_guard<std::mutex> lock(creditLock);
+    auto fed = windows.find(source);
+    if (fed == windows.end()) {
+        return 0;
+    }
+    auto fnd = fed->second.find(endpoint);
+    return (fnd != fed->second.end()) ? fnd->second.outstanding : 0;
+}
+
+void MessageCreditTable::clear()
+{
+    {
+        std::lock_guard<std::mutex> lock(creditLock);
+        windows.clear();
+        endpointNames.clear();
+        active.store(false);
+    }
+    creditAvailable.notify_all();
+}
+
+}  // namespace helics
@@ -0,0 +1,72 @@
+/*
+Copyright (c) 2017-2021,
+Battelle Memorial Institute; Lawrence Livermore National Security, LLC; Alliance for Sustainable
+Energy, LLC.  See the top-level NOTICE for additional details. All rights reserved.
+SPDX-License-Identifier: BSD-3-Clause
+*/
+#pragma once
+
+#include "GlobalFederateId.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+namespace helics {
+/** table of the message windows advertised by endpoints with a limited receive capacity
+@details the window is tracked for each sending federate and destination endpoint handle.  A sender
+acquires a credit before each message and the receiving federate returns credits as messages are
+consumed or discarded.  A sender that finds the window full waits once for credits; if none arrive
+within the timeout the window is marked overdrawn and further sends proceed without waiting until
+credits are returned.  Destinations which have not advertised a capacity are not limited.  Sends
+addressed by name are matched to the handle through the name carried by the advertisement.
+*/
+class MessageCreditTable {
+  public:
+    MessageCreditTable() = default;
+    /** update the window from a destination endpoint
+    @param source the federate sending messages to the endpoint
+    @param endpoint the handle of the destination endpoint
+    @param name the name of the destination endpoint
+    @param capacity the receive capacity of the endpoint, 0 to remove the window
+    @param credits the number of messages consumed by the endpoint*/
+    void updateCredits(GlobalFederateId source,
+                       GlobalHandle endpoint,
+                       std::string_view name,
+                       int32_t capacity,
+                       int32_t credits);
+    /** acquire a credit to send a message, waiting for the window to open if it is full
+    @details an overdrawn window does not wait
+    @return false if the timeout expired and the window became overdrawn, the credit is still
+    taken*/
+    bool acquire(GlobalFederateId source, GlobalHandle endpoint, std::chrono::milliseconds timeout);
+    /** get the handle of a limited endpoint from its name
+    @return an invalid handle if no endpoint with the name has advertised a capacity*/
+    GlobalHandle findEndpoint(std::string_view name) const;
+    /** get the number of messages outstanding to an endpoint*/
+    int32_t outstanding(GlobalFederateId source, GlobalHandle endpoint) const;
+    /** check if there are no limited destinations*/
+    bool empty() const { return !active.load(); }
+    /** remove all the windows and release any waiting senders*/
+    void clear();
+
+  private:
+    struct Window {
+        int32_t capacity{0};  //!< the number of messages the destination will queue
+        int32_t outstanding{0};  //!< messages sent and not yet consumed
+        bool overdrawn{false};  //!< a sender timed out waiting and credits have not been returned
+    };
+    mutable std::mutex creditLock;
+    std::condition_variable creditAvailable;
+    std::map<GlobalFederateId, std::map<GlobalHandle, Window>> windows;
+    /// the handles of the limited endpoints by name
+    std::map<std::string, GlobalHandle, std::less<>> endpointNames;
+    std::atomic<bool> active{false};
+};
+}  // namespace helics
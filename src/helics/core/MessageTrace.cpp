@@ -0,0 +1,104 @@
+/*
+Copyright (c) 2017-2021,
+Battelle Memorial Institute; Lawrence Livermore National Security, LLC; Alliance for Sustainable
+Energy, LLC.  See the top-level NOTICE for additional details. All rights reserved.
+SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include "MessageTrace.hpp"
+
+#include "core-exceptions.hpp"
+
+#include <cerrno>
+#include <cstring>
+
+namespace helics {
+static constexpr char traceTag[8] = {'H', 'E', 'L', 'I', 'C', 'S', 'T', 'R'};
+static constexpr uint32_t traceVersion{1};
+
+MessageTraceWriter::~MessageTraceWriter()
+{
+    try {
+        close();
+    }
+    catch (const std::ios_base::failure&) {
+    }
+}
+
+void MessageTraceWriter::open(const std::string& fileName)
+{
+    close();
+    file.open(fileName, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (file.fail()) {
+        throw std::ios_base::failure(std::strerror(errno));
+    }
+    file.write(traceTag, sizeof(traceTag));
+    file.write(reinterpret_cast<const char*>(&traceVersion), sizeof(traceVersion));
+    startTime = std::chrono::steady_clock::now();
+    count = 0;
+}
+
+void MessageTraceWriter::record(const ActionMessage& command)
+{
+    if (!file.is_open()) {
+        return;
+    }
+    auto arrival = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                       std::chrono::steady_clock::now() - startTime)
+                       .count();
+    command.to_string(buffer);
+    auto timestamp = static_cast<int64_t>(arrival);
+    auto length = static_cast<uint32_t>(buffer.size());
+    file.write(reinterpret_cast<const char*>(&timestamp), sizeof(timestamp));
+    file.write(reinterpret_cast<const char*>(&length), sizeof(length));
+    file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    ++count;
+}
+
+void MessageTraceWriter::close()
+{
+    if (file.is_open()) {
+        file.flush();
+        file.close();
+    }
+}
+
+std::vector<TraceRecord> loadMessageTrace(const std::string& fileName)
+{
+    std::ifstream file(fileName, std::ios::in | std::ios::binary);
+    if (file.fail()) {
+        throw std::ios_base::failure(std::strerror(errno));
+    }
+    char tag[sizeof(traceTag)];
+    uint32_t version{0};
+    file.read(tag, sizeof(tag));
+    file.read(reinterpret_cast<char*>(&version), sizeof(version));
+    if (!file || std::memcmp(tag, traceTag, sizeof(traceTag)) != 0 || version != traceVersion) {
+        throw InvalidParameter(fileName + " is not a valid message trace");
+    }
+    std::vector<TraceRecord> records;
+    std::string buffer;
+    while (true) {
+        int64_t timestamp{0};
+        uint32_t length{0};
+        file.read(reinterpret_cast<char*>(&timestamp), sizeof(timestamp));
+        if (file.gcount() == 0) {
+            break;
+        }
+        file.read(reinterpret_cast<char*>(&length), sizeof(length));
+        buffer.resize(length);
+        file.read(buffer.data(), length);
+        if (!file) {
+            // a trace cut off while writing still has usable records before the break
+            break;
+        }
+        auto& rec = records.emplace_back();
+        rec.processed = std::chrono::nanoseconds(timestamp);
+        if (rec.command.from_string(buffer) == 0) {
+            throw InvalidParameter(fileName + " contains an invalid command record");
+        }
+    }
+    return records;
+}
+
+}  // namespace helics
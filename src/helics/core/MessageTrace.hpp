@@ -0,0 +1,61 @@
+/*
+Copyright (c) 2017-2021,
+Battelle Memorial Institute; Lawrence Livermore National Security, LLC; Alliance for Sustainable
+Energy, LLC.  See the top-level NOTICE for additional details. All rights reserved.
+SPDX-License-Identifier: BSD-3-Clause
+*/
+#pragma once
+
+#include "ActionMessage.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace helics {
+/** a single command read from a message trace*/
+struct TraceRecord {
+    /// time since the start of the trace when the command was taken from the queue for processing
+    std::chrono::nanoseconds processed{0};
+    ActionMessage command;  //!< the command that was processed
+};
+
+/** writer for a binary record of the commands processed by a broker or core
+@details the file starts with an 8 byte tag and a 32 bit version followed by a record for each
+command containing a 64 bit nanosecond timestamp relative to the opening of the trace, a 32 bit
+length, and the serialized command.  Commands are recorded as they are dequeued by the
+processing loop, so the timestamps are processing times and do not include queueing delay.
+Integers are written in native byte order so a trace is intended to be replayed on the same
+architecture that captured it.
+*/
+class MessageTraceWriter {
+  public:
+    MessageTraceWriter() = default;
+    ~MessageTraceWriter();
+    /** open a trace file, replacing any existing file
+    @throw std::ios_base::failure if the file cannot be opened*/
+    void open(const std::string& fileName);
+    /** check if the trace is recording*/
+    bool isOpen() const { return file.is_open(); }
+    /** record a command with the current time, called as the command is taken from the queue*/
+    void record(const ActionMessage& command);
+    /** flush and close the trace file*/
+    void close();
+    /** get the number of commands recorded*/
+    std::size_t recordCount() const { return count; }
+
+  private:
+    std::ofstream file;
+    std::string buffer;  //!< reusable serialization buffer
+    decltype(std::chrono::steady_clock::now()) startTime;
+    std::size_t count{0};
+};
+
+/** load all the commands from a trace file
+@throw std::ios_base::failure if the file cannot be opened
+@throw InvalidParameter if the file is not a valid message trace*/
+std::vector<TraceRecord> loadMessageTrace(const std::string& fileName);
+
+}  // namespace helics
@@ -0,0 +1,258 @@
+/*
+Copyright (c) 2017-2021,
+Battelle Memorial Institute; Lawrence Livermore National Security, LLC; Alliance for Sustainable
+Energy, LLC.  See the top-level NOTICE for additional details. All rights reserved.
+SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include "PayloadCompression.hpp"
+
+#include "flagOperations.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <memory>
+
+namespace helics {
+static constexpr std::size_t minMatch{4};
+/// the last bytes of a block are always literals
+static constexpr std::size_t lastLiterals{5};
+/// matches must start at least this far from the end of a block
+static constexpr std::size_t matchStartLimit{12};
+static constexpr std::size_t maximumOffset{65535};
+static constexpr unsigned int hashBits{12};
+/// the size of the uncompressed size field at the start of a compressed message payload
+static constexpr std::size_t sizeFieldSize{4};
+
+static std::uint32_t readSequence(const std::byte* data)
+{
+    std::uint32_t value;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+static std::uint32_t hashSequence(std::uint32_t sequence)
+{
+    return (sequence * 2654435761U) >> (32U - hashBits);
+}
+
+/** write the extension bytes of a literal or match length beyond the 15 in the token*/
+static std::byte* writeLength(std::byte* out, std::size_t length)
+{
+    while (length >= 255) {
+        *out++ = std::byte{255};
+        length -= 255;
+    }
+    *out++ = static_cast<std::byte>(length);
+    return out;
+}
+
+/** read the extension bytes of a length, returns false if the data ends first*/
+static bool readLength(const std::byte*& in, const std::byte* end, std::size_t& length)
+{
+    unsigned int next{255};
+    while (next == 255) {
+        if (in >= end) {
+            return false;
+        }
+        next = std::to_integer<unsigned int>(*in++);
+        length += next;
+    }
+    return true;
+}
+
+static std::byte* writeSequence(std::byte* out,
+                                const std::byte* literals,
+                                std::size_t literalLength,
+                                std::size_t offset,
+                                std::size_t matchLength)
+{
+    auto* token = out++;
+    auto tokenValue = static_cast<unsigned int>(std::min<std::size_t>(literalLength, 15)) << 4U;
+    if (literalLength >= 15) {
+        out = writeLength(out, literalLength - 15);
+    }
+    std::memcpy(out, literals, literalLength);
+    out += literalLength;
+    if (offset != 0) {
+        *out++ = static_cast<std::byte>(offset & 0xFFU);
+        *out++ = static_cast<std::byte>((offset >> 8U) & 0xFFU);
+        tokenValue += static_cast<unsigned int>(std::min<std::size_t>(matchLength, 15));
+        if (matchLength >= 15) {
+            out = writeLength(out, matchLength - 15);
+        }
+    }
+    *token = static_cast<std::byte>(tokenValue);
+    return out;
+}
+
+std::size_t compressBlock(const std::byte* source, std::size_t size, std::byte* dest)
+{
+    const std::byte* input = source;
+    const std::byte* anchor = source;
+    const std::byte* const inputEnd = source + size;
+    std::byte* out = dest;
+    if (size > matchStartLimit) {
+        const std::byte* const matchStartEnd = inputEnd - matchStartLimit;
+        const std::byte* const matchEnd = inputEnd - lastLiterals;
+        // positions are offsets from the start so an empty table entry is a harmless candidate
+        std::array<std::uint32_t, 1U << hashBits> table{};
+        while (input < matchStartEnd) {
+            auto sequence = readSequence(input);
+            auto& entry = table[hashSequence(sequence)];
+            const std::byte* ref = source + entry;
+            entry = static_cast<std::uint32_t>(input - source);
+            if (ref >= input || static_cast<std::size_t>(input - ref) > maximumOffset ||
+                readSequence(ref) != sequence) {
+                ++input;
+                continue;
+            }
+            while (input > anchor && ref > source && input[-1] == ref[-1]) {
+                --input;
+                --ref;
+            }
+            const std::byte* matchScan = input + minMatch;
+            const std::byte* refScan = ref + minMatch;
+            while (matchScan < matchEnd && *matchScan == *refScan) {
+                ++matchScan;
+                ++refScan;
+            }
+            out = writeSequence(out,
+                                anchor,
+                                static_cast<std::size_t>(input - anchor),
+                                static_cast<std::size_t>(input - ref),
+                                static_cast<std::size_t>(matchScan - input) - minMatch);
+            input = matchScan;
+            anchor = input;
+        }
+    }
+    out = writeSequence(out, anchor, static_cast<std::size_t>(inputEnd - anchor), 0, 0);
+    return static_cast<std::size_t>(out - dest);
+}
+
+bool decompressBlock(const std::byte* source, std::size_t size, std::byte* dest, std::size_t destSize)
+{
+    const std::byte* input = source;
+    const std::byte* const inputEnd = source + size;
+    std::byte* out = dest;
+    std::byte* const outEnd = dest + destSize;
+    while (input < inputEnd) {
+        auto token = std::to_integer<unsigned int>(*input++);
+        std::size_t literalLength = token >> 4U;
+        if (literalLength == 15 && !readLength(input, inputEnd, literalLength)) {
+            return false;
+        }
+        if (literalLength > static_cast<std::size_t>(inputEnd - input) ||
+            literalLength > static_cast<std::size_t>(outEnd - out)) {
+            return false;
+        }
+        std::memcpy(out, input, literalLength);
+        out += literalLength;
+        input += literalLength;
+        if (input == inputEnd) {
+            // the final sequence has only literals
+            break;
+        }
+        if (inputEnd - input < 2) {
+            return false;
+        }
+        auto offset = std::to_integer<std::size_t>(input[0]) +
+            (std::to_integer<std::size_t>(input[1]) << 8U);
+        input += 2;
+        if (offset == 0 || offset > static_cast<std::size_t>(out - dest)) {
+            return false;
+        }
+        std::size_t matchLength = token & 0x0FU;
+        if (matchLength == 15 && !readLength(input, inputEnd, matchLength)) {
+            return false;
+        }
+        matchLength += minMatch;
+        if (matchLength > static_cast<std::size_t>(outEnd - out)) {
+            return false;
+        }
+        // copied a byte at a time since the match may overlap the output
+        const std::byte* ref = out - offset;
+        for (std::size_t ii = 0; ii < matchLength; ++ii) {
+            *out++ = *ref++;
+        }
+    }
+    return out == outEnd;
+}
+
+bool PayloadCompressor::isCandidateType(const ActionMessage& cmd)
+{
+    // priority commands would lose their priority inside the wrapper
+    return !isProtocolCommand(cmd) && !isPriorityCommand(cmd) &&
+        cmd.action() != CMD_COMPRESSED_MESSAGE;
+}
+
+bool PayloadCompressor::compress(const ActionMessage& cmd, ActionMessage& wrapper)
+{
+    if (cmd.payload.size() < threshold || !isCandidateType(cmd)) {
+        return false;
+    }
+    if (skipRemaining > 0) {
+        --skipRemaining;
+        ++stats.skipped;
+        return false;
+    }
+    auto start = std::chrono::steady_clock::now();
+    auto msize = static_cast<std::size_t>(cmd.serializedByteCount());
+    auto serialized = std::make_unique<std::byte[]>(msize);
+    cmd.toByteArray(serialized.get(), msize);
+
+    wrapper = ActionMessage(CMD_COMPRESSED_MESSAGE);
+    wrapper.source_id = cmd.source_id;
+    wrapper.dest_id = cmd.dest_id;
+    wrapper.payload.resize(sizeFieldSize + compressedSizeBound(msize));
+    auto* data = wrapper.payload.data();
+    for (std::size_t ii = 0; ii < sizeFieldSize; ++ii) {
+        data[ii] = static_cast<std::byte>((msize >> (8U * (sizeFieldSize - 1 - ii))) & 0xFFU);
+    }
+    auto csize = compressBlock(serialized.get(), msize, data + sizeFieldSize);
+    stats.processingTime += static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() -
+                                                             start)
+            .count());
+    // require at least a 1/8 reduction to be worth the work on the receiving side
+    if (sizeFieldSize + csize > msize - msize / 8) {
+        ++stats.rejected;
+        backoff = (backoff == 0) ? 1 : std::min(backoff * 2, maximumBackoff);
+        skipRemaining = backoff;
+        return false;
+    }
+    backoff = 0;
+    wrapper.payload.resize(sizeFieldSize + csize);
+    ++stats.compressed;
+    stats.bytesIn += msize;
+    stats.bytesOut += wrapper.payload.size();
+    return true;
+}
+
+bool decompressMessage(const ActionMessage& wrapper, ActionMessage& original)
+{
+    if (wrapper.action() != CMD_COMPRESSED_MESSAGE || wrapper.payload.size() <= sizeFieldSize) {
+        return false;
+    }
+    const auto* data = wrapper.payload.data();
+    std::size_t msize{0};
+    for (std::size_t ii = 0; ii < sizeFieldSize; ++ii) {
+        msize = (msize << 8U) + std::to_integer<std::size_t>(data[ii]);
+    }
+    // the size comes from the peer so check it before allocating
+    if (msize > restoredSizeBound(wrapper.payload.size() - sizeFieldSize)) {
+        return false;
+    }
+    auto restored = std::make_unique<std::byte[]>(msize);
+    if (!decompressBlock(data + sizeFieldSize,
+                         wrapper.payload.size() - sizeFieldSize,
+                         restored.get(),
+                         msize)) {
+        return false;
+    }
+    return original.fromByteArray(restored.get(), msize) > 0;
+}
+
+}  // namespace helics
@@ -0,0 +1,93 @@
+/*
+Copyright (c) 2017-2021,
+Battelle Memorial Institute; Lawrence Livermore National Security, LLC; Alliance for Sustainable
+Energy, LLC.  See the top-level NOTICE for additional details. All rights reserved.
+SPDX-License-Identifier: BSD-3-Clause
+*/
+#pragma once
+
+#include "ActionMessage.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace helics {
+/** get the largest possible size of a compressed block of data*/
+constexpr std::size_t compressedSizeBound(std::size_t size)
+{
+    return size + size / 255 + 16;
+}
+
+/** get the largest size a block of compressed data can restore to
+@details a byte of compressed data codes at most 255 bytes of the original so a larger restored size
+can only come from a damaged or hostile message*/
+constexpr std::size_t restoredSizeBound(std::size_t compressedSize)
+{
+    return compressedSize * 255;
+}
+
+/** compress a block of data with a fast LZ77 codec using the LZ4 block layout
+@param source the data to compress
+@param size the number of bytes in source
+@param[out] dest the location for the compressed data, must hold compressedSizeBound(size) bytes
+@return the number of bytes written to dest*/
+std::size_t compressBlock(const std::byte* source, std::size_t size, std::byte* dest);
+
+/** restore a block of data generated by compressBlock
+@param source the compressed data
+@param size the number of bytes in source
+@param[out] dest the location for the restored data
+@param destSize the exact size of the restored data
+@return true if the block was valid and restored exactly destSize bytes*/
+bool decompressBlock(const std::byte* source, std::size_t size, std::byte* dest, std::size_t destSize);
+
+/** the sending side of payload compression for a single route
+@details commands with a payload of at least the threshold size are serialized and compressed into
+a CMD_COMPRESSED_MESSAGE.  If the compressed form is not sufficiently smaller than the original the
+command is sent as is and the compressor skips a growing number of later commands before trying
+again, so a stream of incompressible payloads costs little processing time.
+*/
+class PayloadCompressor {
+  public:
+    /// the default size of the smallest payload to compress
+    static constexpr std::size_t defaultThreshold{1024};
+    /// the maximum number of commands skipped after compression fails to help
+    static constexpr std::uint32_t maximumBackoff{64};
+
+    /** statistics on the compression of a route*/
+    struct Statistics {
+        std::uint64_t compressed{0};  //!< the number of commands sent compressed
+        std::uint64_t rejected{0};  //!< the number of attempts that did not reduce the size enough
+        std::uint64_t skipped{0};  //!< the number of candidates skipped while backing off
+        std::uint64_t bytesIn{0};  //!< the serialized size of the compressed commands
+        std::uint64_t bytesOut{0};  //!< the size of the compressed commands
+        std::uint64_t processingTime{0};  //!< the time spent in compression attempts in ns
+    };
+
+    PayloadCompressor() = default;
+    /** construct with a specific payload size threshold*/
+    explicit PayloadCompressor(std::size_t payloadThreshold): threshold(payloadThreshold) {}
+    /** check if a command is a candidate for compression based only on the command type*/
+    static bool isCandidateType(const ActionMessage& cmd);
+    /** generate the compressed form of a command
+    @param cmd the command to compress
+    @param[out] wrapper the command to send in place of cmd
+    @return true if the wrapper was generated, false if cmd should be sent as is*/
+    bool compress(const ActionMessage& cmd, ActionMessage& wrapper);
+    /** get the compression statistics*/
+    const Statistics& statistics() const { return stats; }
+    /** get the payload size threshold*/
+    std::size_t getThreshold() const { return threshold; }
+
+  private:
+    std::size_t threshold{defaultThreshold};
+    std::uint32_t backoff{0};  //!< the number of candidates to skip after the next rejection
+    std::uint32_t skipRemaining{0};  //!< the remaining candidates to skip
+    Statistics stats;
+};
+
+/** restore the original command from a CMD_COMPRESSED_MESSAGE
+@return true if the command was restored, false if the message was invalid*/
+bool decompressMessage(const ActionMessage& wrapper, ActionMessage& original);
+
+}  // namespace helics
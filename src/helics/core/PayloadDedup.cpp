@@ -0,0 +1,153 @@
+/*
+Copyright (c) 2017-2021,
+Battelle Memorial Institute; Lawrence Livermore National Security, LLC; Alliance for Sustainable
+Energy, LLC.  See the top-level NOTICE for additional details. All rights reserved.
+SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include "PayloadDedup.hpp"
+
+#include "flagOperations.hpp"
+
+#include <cstring>
+#include <limits>
+
+namespace helics {
+static constexpr std::size_t hashSize{sizeof(std::uint64_t)};
+
+std::uint64_t payloadHash(const SmallBuffer& data)
+{
+    // 64 bit FNV-1a
+    std::uint64_t hash{0xcbf29ce484222325ULL};
+    const auto* bytes = data.data();
+    for (std::size_t ii = 0; ii < data.size(); ++ii) {
+        hash ^= std::to_integer<std::uint64_t>(bytes[ii]);
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+bool PayloadDedupEncoder::isCandidate(const ActionMessage& cmd)
+{
+    switch (cmd.action()) {
+        case CMD_SEND_MESSAGE:
+        case CMD_SEND_FOR_FILTER:
+        case CMD_SEND_FOR_FILTER_AND_RETURN:
+        case CMD_SEND_FOR_DEST_FILTER_AND_RETURN:
+        case CMD_FILTER_RESULT:
+        case CMD_DEST_FILTER_RESULT:
+            return cmd.payload.size() >= minimumPayloadSize &&
+                cmd.payload.size() <= maximumPayloadSize;
+        default:
+            return false;
+    }
+}
+
+/** generate the wrapper payload, the hash followed by the serialized command*/
+static void packWrapper(std::uint64_t hash, const ActionMessage& cmd, ActionMessage& wrapper)
+{
+    auto msize = static_cast<std::size_t>(cmd.serializedByteCount());
+    wrapper.payload.resize(hashSize + msize);
+    auto* data = wrapper.payload.data();
+    for (std::size_t ii = 0; ii < hashSize; ++ii) {
+        data[ii] = static_cast<std::byte>((hash >> (8U * (hashSize - 1 - ii))) & 0xFFU);
+    }
+    cmd.toByteArray(data + hashSize, msize);
+}
+
+bool PayloadDedupEncoder::encode(GlobalBrokerId source,
+                                 route_id rid,
+                                 const ActionMessage& cmd,
+                                 ActionMessage& wrapper)
+{
+    if (!isCandidate(cmd)) {
+        return false;
+    }
+    auto hash = payloadHash(cmd.payload);
+    auto& cache = routes[rid];
+    wrapper = ActionMessage(CMD_DEDUPLICATED_MESSAGE);
+    wrapper.source_id = source;
+    wrapper.dest_id = cmd.dest_id;
+    wrapper.messageID = rid.baseValue();
+
+    for (std::size_t ii = 0; ii < cache.slots.size(); ++ii) {
+        const auto& slot = cache.slots[ii];
+        if (slot.hash != hash || slot.data.size() != cmd.payload.size() ||
+            std::memcmp(slot.data.data(), cmd.payload.data(), slot.data.size()) != 0) {
+            continue;
+        }
+        // the receiver already has the payload so send the command without it
+        ActionMessage stripped(cmd);
+        stripped.payload.clear();
+        wrapper.counter = static_cast<std::uint16_t>(ii);
+        setActionFlag(wrapper, indicator_flag);
+        packWrapper(hash, stripped, wrapper);
+        ++references;
+        savedBytes += cmd.payload.size();
+        return true;
+    }
+    if (cache.slots.size() < slotsPerRoute) {
+        cache.slots.emplace_back();
+        cache.next = static_cast<std::uint16_t>(cache.slots.size() - 1);
+    }
+    auto& slot = cache.slots[cache.next];
+    slot.hash = hash;
+    slot.data = cmd.payload;
+    wrapper.counter = cache.next;
+    cache.next = static_cast<std::uint16_t>((cache.next + 1) % slotsPerRoute);
+    packWrapper(hash, cmd, wrapper);
+    return true;
+}
+
+bool PayloadDedupDecoder::decode(const ActionMessage& wrapper, ActionMessage& original)
+{
+    if (wrapper.action() != CMD_DEDUPLICATED_MESSAGE || wrapper.payload.size() <= hashSize ||
+        wrapper.counter >= PayloadDedupEncoder::slotsPerRoute) {
+        return false;
+    }
+    const auto* data = wrapper.payload.data();
+    std::uint64_t hash{0};
+    for (std::size_t ii = 0; ii < hashSize; ++ii) {
+        hash = (hash << 8U) + std::to_integer<std::uint64_t>(data[ii]);
+    }
+    if (original.fromByteArray(data + hashSize, wrapper.payload.size() - hashSize) == 0) {
+        return false;
+    }
+    auto& slots = caches[{wrapper.source_id.baseValue(), wrapper.messageID}];
+    if (checkActionFlag(wrapper, indicator_flag)) {
+        if (wrapper.counter >= slots.size() || slots[wrapper.counter].hash != hash) {
+            return false;
+        }
+        original.payload = slots[wrapper.counter].data;
+        return true;
+    }
+    if (wrapper.counter >= slots.size()) {
+        slots.resize(wrapper.counter + 1U);
+    }
+    slots[wrapper.counter].hash = hash;
+    slots[wrapper.counter].data = original.payload;
+    return true;
+}
+
+void PayloadDedupDecoder::removeSource(GlobalBrokerId source)
+{
+    auto cache = caches.lower_bound({source.baseValue(), std::numeric_limits<std::int32_t>::min()});
+    while (cache != caches.end() && cache->first.first == source.baseValue()) {
+        cache = caches.erase(cache);
+    }
+}
+
+std::size_t PayloadDedupDecoder::cachedPayloadCount() const
+{
+    std::size_t count{0};
+    for (const auto& cache : caches) {
+        for (const auto& slot : cache.second) {
+            if (!slot.data.empty()) {
+                ++count;
+            }
+        }
+    }
+    return count;
+}
+
+}  // namespace helics
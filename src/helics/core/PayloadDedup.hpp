@@ -0,0 +1,93 @@
+/*
+Copyright (c) 2017-2021,
+Battelle Memorial Institute; Lawrence Livermore National Security, LLC; Alliance for Sustainable
+Energy, LLC.  See the top-level NOTICE for additional details. All rights reserved.
+SPDX-License-Identifier: BSD-3-Clause
+*/
+#pragma once
+
+#include "ActionMessage.hpp"
+
+#include <cstdint>
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace helics {
+/** generate the content hash used to identify payloads for deduplication*/
+std::uint64_t payloadHash(const SmallBuffer& data);
+
+/** the sending side of payload deduplication
+@details the encoder keeps the recently sent payloads for each route in a fixed set of slots.  The
+first time a payload is sent on a route the message is wrapped in a CMD_DEDUPLICATED_MESSAGE
+carrying the payload, its hash, and the slot the receiver should store it in.  Later messages with
+the same payload on the route carry only the hash and slot.  The encoder chooses the slots so the
+receiving cache always mirrors the sending one as long as messages on a route are delivered in
+order.
+*/
+class PayloadDedupEncoder {
+  public:
+    /// payloads smaller than this are always sent directly
+    static constexpr std::size_t minimumPayloadSize{256};
+    /// payloads larger than this are always sent directly to bound the cache memory
+    static constexpr std::size_t maximumPayloadSize{256U * 1024U};
+    /// the number of payloads remembered for each route
+    static constexpr std::uint16_t slotsPerRoute{32};
+
+    /** check if a command is a message whose payload may be deduplicated*/
+    static bool isCandidate(const ActionMessage& cmd);
+    /** generate the deduplicated form of a command sent on a route
+    @param source the id of the sending broker or core
+    @param rid the route the command is sent on
+    @param cmd the command to send
+    @param[out] wrapper the command to send in place of cmd
+    @return true if the wrapper was generated, false if cmd should be sent as is*/
+    bool encode(GlobalBrokerId source, route_id rid, const ActionMessage& cmd, ActionMessage& wrapper);
+    /** forget the payloads sent on a route*/
+    void removeRoute(route_id rid) { routes.erase(rid); }
+    /** get the number of messages sent with only a payload reference*/
+    std::uint64_t referenceCount() const { return references; }
+    /** get the number of payload bytes not sent due to deduplication*/
+    std::uint64_t bytesSaved() const { return savedBytes; }
+
+  private:
+    struct Slot {
+        std::uint64_t hash{0};
+        SmallBuffer data;
+    };
+    struct RouteCache {
+        std::vector<Slot> slots;
+        std::uint16_t next{0};  //!< the next slot to replace
+    };
+    std::map<route_id, RouteCache> routes;
+    std::uint64_t references{0};
+    std::uint64_t savedBytes{0};
+};
+
+/** the receiving side of payload deduplication, restores messages generated by a
+PayloadDedupEncoder*/
+class PayloadDedupDecoder {
+  public:
+    /** restore the original command from a CMD_DEDUPLICATED_MESSAGE
+    @param wrapper the deduplicated message
+    @param[out] original the restored command
+    @return true if the command was restored, false if the message was invalid or referenced a
+    payload that is not in the cache*/
+    bool decode(const ActionMessage& wrapper, ActionMessage& original);
+    /** forget the payloads received from a broker or core*/
+    void removeSource(GlobalBrokerId source);
+    /** forget all cached payloads*/
+    void clear() { caches.clear(); }
+    /** get the number of payloads currently cached*/
+    std::size_t cachedPayloadCount() const;
+
+  private:
+    struct Slot {
+        std::uint64_t hash{0};
+        SmallBuffer data;
+    };
+    /// cached payloads indexed by the sending broker and the route it sent them on
+    std::map<std::pair<std::int32_t, std::int32_t>, std::vector<Slot>> caches;
+};
+
+}  // namespace helics
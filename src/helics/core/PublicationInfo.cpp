@@ -28,6 +28,7 @@ bool PublicationInfo::addSubscriber(GlobalHandle newSubscriber)
         }
     }
     subscribers.push_back(newSubscriber);
+    updateRawDoubleAccepted();
     return true;
 }
 
@@ -35,6 +36,28 @@ void PublicationInfo::removeSubscriber(GlobalHandle subscriberToRemove)
 {
     subscribers.erase(std::remove(subscribers.begin(), subscribers.end(), subscriberToRemove),
                       subscribers.end());
+    setRawDoubleSubscriber(subscriberToRemove, false);
+}
+
+void PublicationInfo::setRawDoubleSubscriber(GlobalHandle subscriber, bool accepted)
+{
+    auto fnd = std::find(rawDoubleSubscribers.begin(), rawDoubleSubscribers.end(), subscriber);
+    if (accepted && fnd == rawDoubleSubscribers.end()) {
+        rawDoubleSubscribers.push_back(subscriber);
+    } else if (!accepted && fnd != rawDoubleSubscribers.end()) {
+        rawDoubleSubscribers.erase(fnd);
+    }
+    updateRawDoubleAccepted();
+}
+
+void PublicationInfo::updateRawDoubleAccepted()
+{
+    const bool accepted = !subscribers.empty() &&
+        std::all_of(subscribers.begin(), subscribers.end(), [this](const auto& sub) {
+            return std::find(rawDoubleSubscribers.begin(), rawDoubleSubscribers.end(), sub) !=
+                rawDoubleSubscribers.end();
+        });
+    rawDoubleAccepted.store(accepted);
 }
 
 }  // namespace helics
@@ -8,6 +8,7 @@ SPDX-License-Identifier: BSD-3-Clause
 
 #include "GlobalFederateId.hpp"
 
+#include <atomic>
 #include <cstdint>
 #include <string>
 #include <vector>
@@ -27,6 +28,10 @@ class PublicationInfo {
     }
     const GlobalHandle id;  //!< the identifier for the containing federate
     std::vector<GlobalHandle> subscribers;  //!< container for all the subscribers of a publication
+    /// the subscribers that accept the raw double encoding
+    std::vector<GlobalHandle> rawDoubleSubscribers;
+    /// all the subscribers accept the raw double encoding, read outside the federate processing
+    std::atomic<bool> rawDoubleAccepted{false};
     const std::string key;  //!< the key identifier for the publication
     const std::string type;  //!< the type of the publication data
     const std::string units;  //!< the units of the publication data
@@ -45,5 +50,12 @@ class PublicationInfo {
 
     /** remove a subscriber*/
     void removeSubscriber(GlobalHandle subscriberToRemove);
+    /** record whether a subscriber accepts the raw double encoding
+    @details the acceptance may arrive before the subscriber is added*/
+    void setRawDoubleSubscriber(GlobalHandle subscriber, bool accepted);
+
+  private:
+    /** recompute whether every subscriber accepts the raw double encoding*/
+    void updateRawDoubleAccepted();
 };
 }  // namespace helics
@@ -7,7 +7,9 @@ SPDX-License-Identifier: BSD-3-Clause
 #pragma once
 
 #include <array>
+#include <atomic>
 #include <cstddef>
+#include <cstdint>
 #include <cstring>
 #include <new>
 #include <stdexcept>
@@ -77,6 +79,7 @@ class SmallBuffer {
     ~SmallBuffer()
     {
         if (usingAllocatedBuffer && !nonOwning) {
+            trackHeap(-static_cast<std::int64_t>(bufferCapacity));
             delete[] heap;
         }
     }
@@ -103,6 +106,7 @@ class SmallBuffer {
                     bufferSize = sb.bufferSize;
                     return *this;
                 }
+                trackHeap(-static_cast<std::int64_t>(bufferCapacity));
                 delete[] heap;
             }
         }
@@ -230,10 +234,12 @@ class SmallBuffer {
     {
         auto* newHeap = reinterpret_cast<std::byte*>(data);
         if (usingAllocatedBuffer && !nonOwning) {
+            trackHeap(-static_cast<std::int64_t>(bufferCapacity));
             if (newHeap != heap) {
                 delete[] heap;
             }
         }
+        trackHeap(static_cast<std::int64_t>(capacity));
         heap = newHeap;
         bufferCapacity = capacity;
         bufferSize = size;
@@ -248,10 +254,13 @@ class SmallBuffer {
             if (newHeap == heap) {
                 // if the heaps are the same the only thing to change is the size and capacity
                 // don't change the other characteristics
+                trackHeap(static_cast<std::int64_t>(capacity) -
+                          static_cast<std::int64_t>(bufferCapacity));
                 bufferSize = size;
                 bufferCapacity = capacity;
                 return;
             }
+            trackHeap(-static_cast<std::int64_t>(bufferCapacity));
             delete[] heap;
         }
         heap = newHeap;
@@ -281,7 +290,9 @@ class SmallBuffer {
             }
             auto* ndata = new std::byte[size];
             std::memcpy(ndata, heap, bufferSize);
+            trackHeap(static_cast<std::int64_t>(size));
             if (usingAllocatedBuffer && !nonOwning) {
+                trackHeap(-static_cast<std::int64_t>(bufferCapacity));
                 delete[] heap;
             }
             heap = ndata;
@@ -336,12 +347,18 @@ class SmallBuffer {
             std::swap(sb2.bufferSize, bufferSize);
         }
     }
+    /** check if the data is held in heap memory owned by the buffer
+    @details if true the memory returned by release must be freed with delete[]*/
+    bool ownsHeapMemory() const { return usingAllocatedBuffer && !nonOwning; }
     /** release the memory from ownership */
     std::byte* release()
     {
         if (!usingAllocatedBuffer) {
             return nullptr;
         }
+        if (!nonOwning) {
+            trackHeap(-static_cast<std::int64_t>(bufferCapacity));
+        }
         auto* released = heap;
         heap = buffer.data();
         usingAllocatedBuffer = false;
@@ -351,7 +368,20 @@ class SmallBuffer {
         return released;
     }
 
+    /** get the heap memory currently owned by all the buffers in the process in bytes*/
+    static std::int64_t allocatedHeapBytes()
+    {
+        return heapBytes.load(std::memory_order_relaxed);
+    }
+
   private:
+    static void trackHeap(std::int64_t change)
+    {
+        heapBytes.fetch_add(change, std::memory_order_relaxed);
+    }
+    /// the heap memory owned by all buffers, used for the memory accounting of cores and brokers
+    static inline std::atomic<std::int64_t> heapBytes{0};
+
     std::array<std::byte, 64> buffer{std::byte{0}};
     std::size_t bufferSize{0};
     std::size_t bufferCapacity{64};
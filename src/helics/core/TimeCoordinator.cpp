@@ -297,6 +297,9 @@ void TimeCoordinator::generateConfig(Json::Value& base) const
     if (info.inputDelay > timeZero) {
         base["intput_delay"] = static_cast<double>(info.inputDelay);
     }
+    if (info.quantum > timeZero) {
+        base["time_quantum"] = static_cast<double>(info.quantum);
+    }
 }
 
 void TimeCoordinator::generateDebuggingTimeInfo(Json::Value& base) const
@@ -405,6 +408,17 @@ Time TimeCoordinator::generateAllowedTime(Time testTime) const
             testTime = timeBase + info.period;
         }
     }
+    if (!info.ignore_quantum) {
+        // collapse events that are close together onto a single grant time
+        auto quantized = quantizeTime(testTime, info.quantum);
+        if (quantized != testTime && info.period > timeEpsilon && quantized < Time::maxVal()) {
+            // a periodic federate is only granted times on its period grid
+            auto timeBase = std::max(time_grantBase, info.offset);
+            auto blk = std::ceil((quantized - timeBase) / info.period);
+            quantized = timeBase + blk * info.period;
+        }
+        testTime = quantized;
+    }
     return testTime;
 }
 
@@ -1014,6 +1028,9 @@ void TimeCoordinator::setProperty(int timeProperty, Time propertyVal)
         case defs::Properties::OFFSET:
             info.offset = propertyVal;
             break;
+        case defs::Properties::TIME_QUANTUM:
+            info.quantum = (propertyVal > timeZero) ? propertyVal : timeZero;
+            break;
         default:
             break;
     }
@@ -1045,6 +1062,9 @@ void TimeCoordinator::setOptionFlag(int optionFlag, bool value)
         case defs::Flags::EVENT_TRIGGERED:
             info.event_triggered = value;
             break;
+        case defs::Flags::IGNORE_TIME_QUANTUM:
+            info.ignore_quantum = value;
+            break;
         default:
             break;
     }
@@ -1063,6 +1083,8 @@ Time TimeCoordinator::getTimeProperty(int timeProperty) const
             return info.period;
         case defs::Properties::OFFSET:
             return info.offset;
+        case defs::Properties::TIME_QUANTUM:
+            return info.quantum;
         default:
             return Time::minVal();
     }
@@ -1093,6 +1115,8 @@ bool TimeCoordinator::getOptionFlag(int optionFlag) const
             return info.restrictive_time_policy;
         case defs::Flags::EVENT_TRIGGERED:
             return info.event_triggered;
+        case defs::Flags::IGNORE_TIME_QUANTUM:
+            return info.ignore_quantum;
         default:
             throw(std::invalid_argument("flag not recognized"));
     }
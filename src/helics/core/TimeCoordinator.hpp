@@ -34,6 +34,7 @@ class tcoptions {
     Time outputDelay = timeZero;
     Time offset = timeZero;
     Time period = timeZero;
+    Time quantum = timeZero;  //!< event times are rounded up to a multiple of the quantum
     // Time rtLag = timeZero;
     // Time rtLead = timeZero;
     // bool observer = false;
@@ -45,6 +46,8 @@ class tcoptions {
     /** have the shown event time match dependency events for use with federates
     that trigger on events but don't have internal generated events*/
     bool event_triggered = false;
+    /// do not round event times onto the quantum grid
+    bool ignore_quantum = false;
     int maxIterations = 50;
 };
 
@@ -16,7 +16,7 @@ SPDX-License-Identifier: BSD-3-Clause
 #include <string>
 
 namespace helics {
-static bool processMessage(const ActionMessage& m, DependencyInfo& dep)
+bool processDependencyMessage(const ActionMessage& m, DependencyInfo& dep)
 {
     switch (m.action()) {
         case CMD_EXEC_REQUEST:
@@ -331,7 +331,7 @@ bool TimeDependencies::updateTime(const ActionMessage& m)
     if (depInfo == nullptr || !depInfo->dependency) {
         return false;
     }
-    return processMessage(m, *depInfo);
+    return processDependencyMessage(m, *depInfo);
 }
 
 bool TimeDependencies::checkIfReadyForExecEntry(bool iterating) const
@@ -146,6 +146,10 @@ class TimeDependencies {
     void setDependencyVector(const std::vector<DependencyInfo>& deps) { dependencies = deps; }
 };
 
+/** update the time information of a dependency from a time or disconnect message
+@return true if the message applied to the dependency*/
+bool processDependencyMessage(const ActionMessage& m, DependencyInfo& dep);
+
 TimeData generateMinTimeUpstream(const TimeDependencies& dependencies,
                                  bool restricted,
                                  GlobalFederateId self,
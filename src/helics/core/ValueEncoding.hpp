@@ -0,0 +1,99 @@
+/*
+Copyright (c) 2017-2021,
+Battelle Memorial Institute; Lawrence Livermore National Security, LLC; Alliance for Sustainable
+Energy, LLC.  See the top-level NOTICE for additional details. All rights reserved.
+SPDX-License-Identifier: BSD-3-Clause
+*/
+#pragma once
+
+/** @file
+definitions of the wire format of values shared by the value converters of the application api and
+the value comparisons in the core
+*/
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+namespace helics {
+namespace detail {
+    namespace checks {
+        /*! This code in checks namespace exerpted from cereal portable binary archives
+        code is modified slightly to fit name conventions and make use of C++17
+
+          Copyright (c) 2014, Randolph Voorhies, Shane Grant
+          All rights reserved.
+
+          Redistribution and use in source and binary forms, with or without
+          modification, are permitted provided that the following conditions are met:
+              * Redistributions of source code must retain the above copyright
+                notice, this list of conditions and the following disclaimer.
+              * Redistributions in binary form must reproduce the above copyright
+                notice, this list of conditions and the following disclaimer in the
+                documentation and/or other materials provided with the distribution.
+              * Neither the name of cereal nor the
+                names of its contributors may be used to endorse or promote products
+                derived from this software without specific prior written permission.
+
+          THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+          ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+          WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+          DISCLAIMED. IN NO EVENT SHALL RANDOLPH VOORHIES OR SHANE GRANT BE LIABLE FOR ANY
+          DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+          (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+          LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+          ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+          (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+          SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+        */
+        //! Returns true if the current machine is little endian
+        /*! @ingroup Internal */
+        inline bool isLittleEndian()
+        {
+            static constexpr std::int32_t test{1};
+            return *reinterpret_cast<const char*>(&test) == 1;
+        }
+
+        //! Swaps the order of bytes for some chunk of memory
+        /*! @param data The data as a uint8_t pointer
+            @tparam DataSize The true size of the data
+            @ingroup Internal */
+        template<std::size_t DataSize>
+        inline void swapBytes(std::byte* data)
+        {
+            for (std::size_t i = 0, end = DataSize / 2; i < end; ++i) {
+                std::swap(data[i], data[DataSize - i - 1]);
+            }
+        }
+    }  // namespace checks
+
+    /// codes in the first byte of the header of a coded value
+    constexpr std::byte doubleCode{0xB0};
+    constexpr std::byte intCode{0x50};
+    constexpr std::byte complexCode{0x12};
+    constexpr std::byte stringCode{0x0E};
+    constexpr std::byte vectorCode{0x6C};
+    constexpr std::byte npCode{0xAE};
+    constexpr std::byte cvCode{0x62};
+    constexpr std::byte customCode{0xF4};
+
+    constexpr std::byte endianMask{0x01};
+    // constexpr std::byte lowByteMask{0xFF};
+    // constexpr std::byte codeMask{0xFE};
+
+    constexpr std::byte littleEndianCode{0x0};
+    // constexpr std::byte bigEndianCode{0x01};
+
+    /** the size of the raw double encoding, a little endian double with no header
+    @details the raw encoding is only sent by publications declared as double and only when every
+    subscriber has accepted it, a data block of this size from a double publication is always raw
+    since the coded form is 16 bytes*/
+    constexpr std::size_t rawDoubleSize{sizeof(double)};
+
+    /** handle option negotiating the raw double encoding
+    @details set on an input to accept the raw encoding from double publications, the acceptance is
+    forwarded to each publication connected to the input.  Read on a publication it is 1 if every
+    subscriber has accepted the raw encoding*/
+    constexpr std::int32_t rawDoubleEncodingOption{-1003};
+}  // namespace detail
+}  // namespace helics
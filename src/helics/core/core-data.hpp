@@ -6,6 +6,7 @@ SPDX-License-Identifier: BSD-3-Clause
 */
 #pragma once
 
+#include "LocalFederateId.hpp"
 #include "SmallBuffer.hpp"
 #include "helics/helics-config.h"
 #include "helicsTime.hpp"
@@ -25,6 +26,15 @@ all user functions are found in this namespace along with many other functions i
  */
 namespace helics {
 
+/** the value of an updated input captured when a time is granted*/
+struct ValueUpdate {
+    InterfaceHandle handle;  //!< the handle of the input
+    std::shared_ptr<const SmallBuffer> data;  //!< the most recent data for the input
+    uint32_t inputIndex{0};  //!< the index of the source that generated the most recent data
+    /// all the current data for inputs with more than one source, empty otherwise
+    std::vector<std::shared_ptr<const SmallBuffer>> allData;
+};
+
 /** class containing a message structure*/
 class Message {
   public:
@@ -64,6 +64,15 @@ constexpr uint16_t delayed_timing_flag = extra_flag2;
 /// overload of flag to indicate it should use the json packetization
 constexpr uint16_t use_json_serialization_flag = extra_flag3;
 
+/// overload of extra_flag1 to indicate a multi-message has its messages packed in the payload
+constexpr uint16_t packed_messages_flag = extra_flag1;
+
+/// overload of extra_flag2 to indicate a broker or core can exchange compressed messages
+constexpr uint16_t compression_flag = extra_flag2;
+
+/// overload of extra_flag1 to indicate a broker or core can receive payloads in a separate frame
+constexpr uint16_t payload_frames_flag = extra_flag1;
+
 /** template function to set a flag in an object containing a flags field
 @tparam FlagContainer an object with a .flags field
 @tparam FlagIndex a type that can be used as part of a shift to index into a flag object
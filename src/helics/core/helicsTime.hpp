@@ -43,6 +43,29 @@ constexpr Time operator"" _t(long double val)
     return {static_cast<double>(val)};
 }  // NOLINT
 
+/** round a time up to the next multiple of a quantum
+@details times already on the grid and the maximum time are returned unchanged, a quantum of zero or
+less disables the rounding*/
+inline Time quantizeTime(Time time, Time quantum)
+{
+    if (quantum <= timeZero || time >= Time::maxVal()) {
+        return time;
+    }
+    const auto code = time.getBaseTimeCode();
+    const auto step = quantum.getBaseTimeCode();
+    const auto remainder = code % step;
+    if (remainder == 0) {
+        return time;
+    }
+    if (code > Time::maxVal().getBaseTimeCode() - step) {
+        return Time::maxVal();
+    }
+    // a negative remainder means truncation already moved the value up
+    Time result = timeZero;
+    result.setBaseTimeCode(code - remainder + ((remainder > 0) ? step : 0));
+    return result;
+}
+
 /** simple structure with the time and completion marker for iterations or dense time steps*/
 struct iteration_time {
     Time grantedTime;  //!< the time of the granted step
@@ -87,6 +87,8 @@ namespace defs {
         PROFILING_MARKER = HELICS_FLAG_PROFILING_MARKER,
         /** flag indicating that profiling should captured to federate log file*/
         LOCAL_PROFILING_CAPTURE = HELICS_FLAG_LOCAL_PROFILING_CAPTURE,
+        /** flag indicating that a federate should not use the federation time quantum*/
+        IGNORE_TIME_QUANTUM = HELICS_FLAG_IGNORE_TIME_QUANTUM,
     };
     /** potential errors that might be generated by a helics federate/core/broker */
     enum Errors : int32_t {
@@ -126,10 +128,12 @@ namespace defs {
         RT_TOLERANCE = HELICS_PROPERTY_TIME_RT_TOLERANCE,
         INPUT_DELAY = HELICS_PROPERTY_TIME_INPUT_DELAY,
         OUTPUT_DELAY = HELICS_PROPERTY_TIME_OUTPUT_DELAY,
+        TIME_QUANTUM = HELICS_PROPERTY_TIME_QUANTUM,
         MAX_ITERATIONS = HELICS_PROPERTY_INT_MAX_ITERATIONS,
         LOG_LEVEL = HELICS_PROPERTY_INT_LOG_LEVEL,
         FILE_LOG_LEVEL = HELICS_PROPERTY_INT_FILE_LOG_LEVEL,
-        CONSOLE_LOG_LEVEL = HELICS_PROPERTY_INT_CONSOLE_LOG_LEVEL
+        CONSOLE_LOG_LEVEL = HELICS_PROPERTY_INT_CONSOLE_LOG_LEVEL,
+        FEDERATE_GROUP = HELICS_PROPERTY_INT_FEDERATE_GROUP
     };
 
     /** options for handles */
@@ -147,7 +151,8 @@ namespace defs {
         MULTI_INPUT_HANDLING_METHOD = HELICS_HANDLE_OPTION_MULTI_INPUT_HANDLING_METHOD,
         INPUT_PRIORITY_LOCATION = HELICS_HANDLE_OPTION_INPUT_PRIORITY_LOCATION,
         CLEAR_PRIORITY_LIST = HELICS_HANDLE_OPTION_CLEAR_PRIORITY_LIST,
-        CONNECTIONS = HELICS_HANDLE_OPTION_CONNECTIONS
+        CONNECTIONS = HELICS_HANDLE_OPTION_CONNECTIONS,
+        RECEIVE_CAPACITY = HELICS_HANDLE_OPTION_RECEIVE_CAPACITY
     };
 
 }  // namespace defs
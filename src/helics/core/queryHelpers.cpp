@@ -7,11 +7,50 @@ SPDX-License-Identifier: BSD-3-Clause
 
 #include "queryHelpers.hpp"
 
+#include "../common/JsonBuilder.hpp"
+#include "ActionMessage.hpp"
 #include "FederateState.hpp"
 #include "HandleManager.hpp"
 
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <iterator>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
 namespace helics {
 
+void MapBuilderResult::setJson(std::string result)
+{
+    jsonResult = std::move(result);
+    jsonGenerated = true;
+    // a fixed result overrides the builder contents so the binary form is not valid
+    binaryAllowed = false;
+}
+
+const std::string& MapBuilderResult::json()
+{
+    if (!jsonGenerated) {
+        jsonResult = builder.generate();
+        jsonGenerated = true;
+    }
+    return jsonResult;
+}
+
+const std::string& MapBuilderResult::forRequestor(const ActionMessage& requestor)
+{
+    if (!binaryAllowed || requestor.counter == GENERAL_QUERY) {
+        return json();
+    }
+    if (binaryResult.empty()) {
+        binaryResult = builder.generateBinary();
+    }
+    return binaryResult;
+}
+
 static void addTags(Json::Value& v, const BasicHandleInfo& bhi)
 {
     if (bhi.tagCount() > 0) {
@@ -109,4 +148,139 @@ void generateInterfaceConfig(Json::Value& iblock,
         }
     }
 }
+
+namespace {
+    /** a node of a graph query result*/
+    struct GraphNode {
+        const char* kind{nullptr};  //!< the name of the array holding the node
+        Json::Value parent;  //!< the id of the parent node
+        const Json::Value* node{nullptr};
+    };
+}  // namespace
+
+static constexpr std::array<const char*, 3> graphNodeArrays{"brokers", "cores", "federates"};
+
+static bool isGraphNodeArray(const std::string& name)
+{
+    return std::find(graphNodeArrays.begin(), graphNodeArrays.end(), name) !=
+        graphNodeArrays.end();
+}
+
+static void collectGraphNodes(const Json::Value& node,
+                              const char* kind,
+                              const Json::Value& parent,
+                              std::map<std::int64_t, GraphNode>& nodes)
+{
+    if (!node.isObject() || !node.isMember("id")) {
+        return;
+    }
+    nodes.emplace(node["id"].asInt64(), GraphNode{kind, parent, &node});
+    for (const auto* child : graphNodeArrays) {
+        const auto& children = node[child];
+        if (children.isArray()) {
+            for (const auto& sub : children) {
+                collectGraphNodes(sub, child, node["id"], nodes);
+            }
+        }
+    }
+}
+
+/** get the elements of one array not in another*/
+static Json::Value arrayDifference(const Json::Value& first, const Json::Value& second)
+{
+    std::vector<Json::Value> lhs(first.begin(), first.end());
+    std::vector<Json::Value> rhs(second.begin(), second.end());
+    std::sort(lhs.begin(), lhs.end());
+    std::sort(rhs.begin(), rhs.end());
+    std::vector<Json::Value> diff;
+    std::set_difference(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), std::back_inserter(diff));
+    Json::Value result = Json::arrayValue;
+    for (auto& val : diff) {
+        result.append(std::move(val));
+    }
+    return result;
+}
+
+static void compareGraphField(const std::string& field,
+                              const Json::Value& before,
+                              const Json::Value& after,
+                              Json::Value& change)
+{
+    if (before == after) {
+        return;
+    }
+    Json::Value fieldChange;
+    fieldChange["field"] = field;
+    if ((before.isArray() || before.isNull()) && (after.isArray() || after.isNull())) {
+        fieldChange["added"] = arrayDifference(after, before);
+        fieldChange["removed"] = arrayDifference(before, after);
+    } else {
+        fieldChange["value"] = after;
+    }
+    change["fields"].append(std::move(fieldChange));
+}
+
+Json::Value generateGraphDelta(const Json::Value& previous, const Json::Value& current)
+{
+    std::map<std::int64_t, GraphNode> before;
+    std::map<std::int64_t, GraphNode> after;
+    collectGraphNodes(previous, "root", Json::Value(), before);
+    collectGraphNodes(current, "root", Json::Value(), after);
+
+    Json::Value delta;
+    delta["added"] = Json::arrayValue;
+    delta["removed"] = Json::arrayValue;
+    delta["changed"] = Json::arrayValue;
+    for (const auto& [id, info] : after) {
+        auto fnd = before.find(id);
+        if (fnd == before.end()) {
+            Json::Value added;
+            added["kind"] = info.kind;
+            added["parent"] = info.parent;
+            Json::Value nodeData = Json::objectValue;
+            for (const auto& name : info.node->getMemberNames()) {
+                if (!isGraphNodeArray(name)) {
+                    nodeData[name] = (*info.node)[name];
+                }
+            }
+            added["node"] = std::move(nodeData);
+            delta["added"].append(std::move(added));
+            continue;
+        }
+        const auto& oldNode = *fnd->second.node;
+        const auto& newNode = *info.node;
+        Json::Value change;
+        change["id"] = static_cast<Json::Int64>(id);
+        change["fields"] = Json::arrayValue;
+        for (const auto& name : newNode.getMemberNames()) {
+            if (!isGraphNodeArray(name)) {
+                compareGraphField(name, oldNode[name], newNode[name], change);
+            }
+        }
+        for (const auto& name : oldNode.getMemberNames()) {
+            if (!isGraphNodeArray(name) && !newNode.isMember(name)) {
+                compareGraphField(name, oldNode[name], Json::Value(), change);
+            }
+        }
+        if (!change["fields"].empty()) {
+            change["name"] = newNode["name"];
+            delta["changed"].append(std::move(change));
+        }
+    }
+    for (const auto& [id, info] : before) {
+        if (after.find(id) == after.end()) {
+            Json::Value removed;
+            removed["kind"] = info.kind;
+            removed["id"] = static_cast<Json::Int64>(id);
+            removed["name"] = (*info.node)["name"];
+            delta["removed"].append(std::move(removed));
+        }
+    }
+    return delta;
+}
+
+bool isEmptyGraphDelta(const Json::Value& delta)
+{
+    return delta["added"].empty() && delta["removed"].empty() && delta["changed"].empty();
+}
 }  // namespace helics
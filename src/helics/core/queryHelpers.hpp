@@ -71,6 +71,35 @@ std::string generateStringVector_if(const X& data, Proc generator, validator val
 }
 
 namespace helics {
+class ActionMessage;
+namespace fileops {
+    class JsonMapBuilder;
+}  // namespace fileops
+
+/** helper for generating the result of a completed map builder in the form needed by each requestor
+@details answers to general queries are JSON text, results going to a map builder in another
+broker or core use the binary transport encoding; each form is only generated if needed*/
+class MapBuilderResult {
+  public:
+    MapBuilderResult(fileops::JsonMapBuilder& mapBuilder, bool allowBinary):
+        builder(mapBuilder), binaryAllowed(allowBinary)
+    {
+    }
+    /** override the builder output with a fixed JSON string*/
+    void setJson(std::string result);
+    /** get the JSON text form of the result*/
+    const std::string& json();
+    /** get the result in the form to use for a particular requestor*/
+    const std::string& forRequestor(const ActionMessage& requestor);
+
+  private:
+    fileops::JsonMapBuilder& builder;
+    bool binaryAllowed{true};
+    bool jsonGenerated{false};
+    std::string jsonResult;
+    std::string binaryResult;
+};
+
 void generateInterfaceConfig(Json::Value& iblock,
                              const helics::HandleManager& hm,
                              const helics::GlobalFederateId& fed);
@@ -79,4 +108,17 @@ Json::Value generateInterfaceConfig(const helics::HandleManager& hm,
                                     const helics::GlobalFederateId& fed);
 
 void addFederateTags(Json::Value& v, const helics::FederateState* fed);
+
+/** generate the changes between two versions of a federation graph query result
+@details the nodes of the graph are the objects with an "id" in the "brokers", "cores", and
+"federates" arrays.  The result contains an "added" array with the new nodes and their parent id, a
+"removed" array with the ids of nodes no longer present, and a "changed" array describing fields of
+the remaining nodes that differ, arrays such as dependencies and interfaces are reported as the
+elements added and removed.
+@param previous the earlier graph
+@param current the new graph*/
+Json::Value generateGraphDelta(const Json::Value& previous, const Json::Value& current);
+
+/** check if a delta from generateGraphDelta contains no changes*/
+bool isEmptyGraphDelta(const Json::Value& delta);
 }  // namespace helics
@@ -458,6 +458,10 @@ class ValueFederate: public virtual Federate {
     {
         helicsFederatePublishJSON(fed, json.c_str(), hThrowOnError());
     }
+    /** start staging publications to send to the core together*/
+    void beginPublishBatch() { helicsFederateBeginPublishBatch(fed, hThrowOnError()); }
+    /** send the staged publications to the core and end the batch*/
+    void commitPublishBatch() { helicsFederateCommitPublishBatch(fed, hThrowOnError()); }
 
   private:
     // Utility function for converting numbers to string
@@ -7,10 +7,14 @@ SPDX-License-Identifier: BSD-3-Clause
 
 #pragma once
 #include "helics/core/ActionMessage.hpp"
+#include "helics/core/LatencyHistogram.hpp"
+#include "helics/core/PayloadDedup.hpp"
 
 #include <atomic>
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace helics {
 class CommsInterface;
@@ -23,6 +27,9 @@ class CommsBroker: public BrokerT {
     std::atomic<int> disconnectionStage{0};  //!< the stage of disconnection
     std::unique_ptr<COMMS> comms;  //!< the actual comms object
     std::atomic<bool> brokerInitialized{false};  //!< atomic protecting local initialization
+    /// time the comms receive callback takes to place a received message on the action queue
+    LatencyHistogram receiveDispatchLatency;
+    PayloadDedupEncoder sentPayloads;  //!< payloads recently sent on each route
   public:
     /** default constructor*/
     CommsBroker() noexcept;
@@ -40,8 +47,29 @@ class CommsBroker: public BrokerT {
     void commDisconnect();
     /** load the comms object directly*/
     void loadComms();
+    /** check if a command sent on a route should be held and packed with other messages
+    @details if the command is not held any messages it must follow are sent first*/
+    bool checkCoalescing(route_id rid, const ActionMessage& cmd);
+    /** hold a message for packing with other messages on the same route*/
+    void coalesce(route_id rid, ActionMessage&& cmd);
+    /** send any held message for a specific route*/
+    void flushRoute(route_id rid);
+    /** check if a command sent on a route should have its payload deduplicated*/
+    bool checkDeduplication(route_id rid, const ActionMessage& cmd) const;
+    /// messages held during a processing pass, one entry per route
+    std::vector<std::pair<route_id, ActionMessage>> pendingMessages;
+
+  protected:
+    virtual void flushCoalescedMessages() override;
+    virtual void generateQueueLatency(Json::Value& base) const override;
+    virtual void setRouteCompression(route_id rid, bool active) override;
+    virtual bool payloadFramesAvailable() const override;
+    virtual void enableRoutePayloadFrames(route_id rid) override;
+    virtual void generateCompressionStats(Json::Value& base) const override;
+    virtual bool transmitBacklogged() const override;
 
   public:
+    virtual void configureBase() override;
     virtual void transmit(route_id rid, const ActionMessage& cmd) override;
     virtual void transmit(route_id rid, ActionMessage&& cmd) override;
 
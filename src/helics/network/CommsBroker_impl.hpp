@@ -8,13 +8,16 @@ SPDX-License-Identifier: BSD-3-Clause
 #pragma once
 #include "CommsBroker.hpp"
 #include "CommsInterface.hpp"
+#include "NetworkCommsInterface.hpp"
 #include "helics/core/BrokerBase.hpp"
+#include "json/json.h"
 
 #include <atomic>
 #include <memory>
 #include <mutex>
 #include <string>
 #include <thread>
+#include <type_traits>
 #include <utility>
 namespace helics {
 template<class COMMS, class BrokerT>
@@ -50,10 +53,98 @@ template<class COMMS, class BrokerT>
 void CommsBroker<COMMS, BrokerT>::loadComms()
 {
     comms = std::make_unique<COMMS>();
-    comms->setCallback([this](ActionMessage&& M) { BrokerBase::addActionMessage(std::move(M)); });
+    comms->setCallback([this](ActionMessage&& M) {
+        if (BrokerBase::trackQueueLatency) {
+            // measures the hand off from the comms receive thread, not the time on the network
+            auto received = LatencyHistogram::now();
+            BrokerBase::addActionMessage(std::move(M));
+            receiveDispatchLatency.record(received);
+        } else {
+            BrokerBase::addActionMessage(std::move(M));
+        }
+    });
     comms->setLoggingCallback(BrokerBase::getLoggingCallback());
 }
 
+template<class COMMS, class BrokerT>
+void CommsBroker<COMMS, BrokerT>::configureBase()
+{
+    BrokerT::configureBase();
+    comms->setLatencyTracking(BrokerBase::trackQueueLatency);
+    if (BrokerBase::enable_payload_dedup && !comms->hasOrderedDelivery()) {
+        // the receiving cache only mirrors the sending one if messages arrive in order
+        BrokerBase::enable_payload_dedup = false;
+        this->sendToLogger(BrokerBase::global_id.load(),
+                           HELICS_LOG_LEVEL_WARNING,
+                           BrokerBase::identifier,
+                           "payload deduplication is not available without in order delivery");
+    }
+}
+
+template<class COMMS, class BrokerT>
+void CommsBroker<COMMS, BrokerT>::generateQueueLatency(Json::Value& base) const
+{
+    BrokerT::generateQueueLatency(base);
+    receiveDispatchLatency.generateJson(base["receive_dispatch"]);
+    comms->getTransmitLatency().generateJson(base["transmit_queue"]);
+}
+
+template<class COMMS, class BrokerT>
+void CommsBroker<COMMS, BrokerT>::setRouteCompression(route_id rid, bool active)
+{
+    // only the network comms have a compression stage
+    if constexpr (std::is_base_of_v<NetworkCommsInterface, COMMS>) {
+        comms->setRouteCompression(rid, active);
+    }
+}
+
+template<class COMMS, class BrokerT>
+void CommsBroker<COMMS, BrokerT>::generateCompressionStats(Json::Value& base) const
+{
+    base["routes"] = Json::arrayValue;
+    if constexpr (std::is_base_of_v<NetworkCommsInterface, COMMS>) {
+        for (const auto& routeStats : comms->getCompressionStats()) {
+            const auto& stats = routeStats.second;
+            Json::Value route;
+            route["route"] = routeStats.first.baseValue();
+            route["compressed"] = static_cast<Json::UInt64>(stats.compressed);
+            route["rejected"] = static_cast<Json::UInt64>(stats.rejected);
+            route["skipped"] = static_cast<Json::UInt64>(stats.skipped);
+            route["bytes_in"] = static_cast<Json::UInt64>(stats.bytesIn);
+            route["bytes_out"] = static_cast<Json::UInt64>(stats.bytesOut);
+            route["ratio"] = (stats.bytesOut > 0) ?
+                static_cast<double>(stats.bytesIn) / static_cast<double>(stats.bytesOut) :
+                1.0;
+            route["cpu_time_ns"] = static_cast<Json::UInt64>(stats.processingTime);
+            auto attempts = stats.compressed + stats.rejected;
+            route["cpu_ns_per_attempt"] = (attempts > 0) ?
+                static_cast<double>(stats.processingTime) / static_cast<double>(attempts) :
+                0.0;
+            base["routes"].append(route);
+        }
+    }
+}
+
+template<class COMMS, class BrokerT>
+bool CommsBroker<COMMS, BrokerT>::payloadFramesAvailable() const
+{
+    return comms && comms->supportsPayloadFrames();
+}
+
+template<class COMMS, class BrokerT>
+void CommsBroker<COMMS, BrokerT>::enableRoutePayloadFrames(route_id rid)
+{
+    if (payloadFramesAvailable()) {
+        comms->enablePayloadFrames(rid);
+    }
+}
+
+template<class COMMS, class BrokerT>
+bool CommsBroker<COMMS, BrokerT>::transmitBacklogged() const
+{
+    return comms && comms->transmitBacklogged();
+}
+
 template<class COMMS, class BrokerT>
 CommsBroker<COMMS, BrokerT>::~CommsBroker()
 {
@@ -82,6 +173,9 @@ void CommsBroker<COMMS, BrokerT>::commDisconnect()
 {
     int exp = 0;
     if (disconnectionStage.compare_exchange_strong(exp, 1)) {
+        if (BrokerBase::isQueueProcessingThread()) {
+            flushCoalescedMessages();
+        }
         comms->disconnect();
         disconnectionStage = 2;
     }
@@ -96,13 +190,108 @@ bool CommsBroker<COMMS, BrokerT>::tryReconnect()
 template<class COMMS, class BrokerT>
 void CommsBroker<COMMS, BrokerT>::transmit(route_id rid, const ActionMessage& cmd)
 {
-    comms->transmit(rid, cmd);
+    if (checkDeduplication(rid, cmd)) {
+        ActionMessage wrapper;
+        sentPayloads.encode(BrokerBase::global_id.load(), rid, cmd, wrapper);
+        transmit(rid, std::move(wrapper));
+        return;
+    }
+    if (checkCoalescing(rid, cmd)) {
+        coalesce(rid, ActionMessage(cmd));
+    } else {
+        comms->transmit(rid, cmd);
+    }
 }
 
 template<class COMMS, class BrokerT>
 void CommsBroker<COMMS, BrokerT>::transmit(route_id rid, ActionMessage&& cmd)
 {
-    comms->transmit(rid, std::move(cmd));
+    if (checkDeduplication(rid, cmd)) {
+        ActionMessage wrapper;
+        sentPayloads.encode(BrokerBase::global_id.load(), rid, cmd, wrapper);
+        cmd = std::move(wrapper);
+    }
+    if (checkCoalescing(rid, cmd)) {
+        coalesce(rid, std::move(cmd));
+    } else {
+        comms->transmit(rid, std::move(cmd));
+    }
+}
+
+template<class COMMS, class BrokerT>
+bool CommsBroker<COMMS, BrokerT>::checkCoalescing(route_id rid, const ActionMessage& cmd)
+{
+    // only the queue processing thread has a processing pass to hold messages for
+    if (BrokerBase::disable_coalescing || isPriorityCommand(cmd) ||
+        !BrokerBase::isQueueProcessingThread()) {
+        return false;
+    }
+    if (isDisconnectCommand(cmd) || isErrorCommand(cmd)) {
+        flushCoalescedMessages();
+        return false;
+    }
+    if (rid == control_route || isProtocolCommand(cmd) || isQueueControlCommand(cmd) ||
+        cmd.action() == CMD_MULTI_MESSAGE ||
+        cmd.serializedByteCount() > comms->getMaxMessageSize() / 4) {
+        flushRoute(rid);
+        return false;
+    }
+    return true;
+}
+
+template<class COMMS, class BrokerT>
+bool CommsBroker<COMMS, BrokerT>::checkDeduplication(route_id rid, const ActionMessage& cmd) const
+{
+    // the route caches are only updated from the queue processing thread
+    return BrokerBase::enable_payload_dedup && rid != control_route &&
+        PayloadDedupEncoder::isCandidate(cmd) && BrokerBase::isQueueProcessingThread();
+}
+
+template<class COMMS, class BrokerT>
+void CommsBroker<COMMS, BrokerT>::coalesce(route_id rid, ActionMessage&& cmd)
+{
+    for (auto& pending : pendingMessages) {
+        if (pending.first != rid) {
+            continue;
+        }
+        auto& bundle = pending.second;
+        if (bundle.action() != CMD_MULTI_MESSAGE) {
+            // a second message on the route so start a bundle
+            ActionMessage multi(CMD_MULTI_MESSAGE);
+            appendPackedMessage(multi, bundle);
+            bundle = std::move(multi);
+        }
+        if (bundle.serializedByteCount() + cmd.serializedByteCount() >
+                comms->getMaxMessageSize() ||
+            appendPackedMessage(bundle, cmd) < 0) {
+            comms->transmit(rid, std::move(bundle));
+            bundle = std::move(cmd);
+        }
+        return;
+    }
+    pendingMessages.emplace_back(rid, std::move(cmd));
+}
+
+template<class COMMS, class BrokerT>
+void CommsBroker<COMMS, BrokerT>::flushRoute(route_id rid)
+{
+    for (auto pending = pendingMessages.begin(); pending != pendingMessages.end(); ++pending) {
+        if (pending->first == rid) {
+            comms->transmit(rid, std::move(pending->second));
+            pendingMessages.erase(pending);
+            return;
+        }
+    }
+}
+
+template<class COMMS, class BrokerT>
+void CommsBroker<COMMS, BrokerT>::flushCoalescedMessages()
+{
+    // a single held message goes out as is, only routes with several get a bundle
+    for (auto& pending : pendingMessages) {
+        comms->transmit(pending.first, std::move(pending.second));
+    }
+    pendingMessages.clear();
 }
 
 template<class COMMS, class BrokerT>
@@ -117,6 +306,8 @@ template<class COMMS, class BrokerT>
 void CommsBroker<COMMS, BrokerT>::removeRoute(route_id rid)
 {
     comms->removeRoute(rid);
+    sentPayloads.removeRoute(rid);
+    setRouteCompression(rid, false);
 }
 
 template<class COMMS, class BrokerT>
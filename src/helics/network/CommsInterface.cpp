@@ -110,6 +110,7 @@ void CommsInterface::loadNetworkInfo(const NetworkBrokerData& netInfo)
         interfaceNetwork = netInfo.interfaceNetwork;
         maxMessageSize = netInfo.maxMessageSize;
         maxMessageCount = netInfo.maxMessageCount;
+        txQueue.setDataLimit(netInfo.maxTransmitBytes);
         brokerInitString = netInfo.brokerInitString;
         autoBroker = netInfo.autobroker;
         switch (netInfo.server_mode) {
@@ -201,6 +202,14 @@ void CommsInterface::removeRoute(route_id rid)
     transmit(control_route, rt);
 }
 
+void CommsInterface::enablePayloadFrames(route_id rid)
+{
+    ActionMessage rt(CMD_PROTOCOL);
+    rt.messageID = ENABLE_PAYLOAD_FRAMES;
+    rt.setExtraData(rid.baseValue());
+    transmit(control_route, rt);
+}
+
 void CommsInterface::setTxStatus(connection_status txStatus)
 {
     if (tx_status == txStatus) {
@@ -211,10 +220,13 @@ void CommsInterface::setTxStatus(connection_status txStatus)
             if (tx_status == connection_status::startup) {
                 tx_status = txStatus;
                 txTrigger.activate();
+                txQueue.setBackpressure(true);
             }
             break;
         case connection_status::terminated:
         case connection_status::error:
+            // nothing is going to drain the queue anymore
+            txQueue.setBackpressure(false);
             if (tx_status == connection_status::startup) {
                 tx_status = txStatus;
                 txTrigger.activate();
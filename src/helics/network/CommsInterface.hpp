@@ -7,9 +7,9 @@ SPDX-License-Identifier: BSD-3-Clause
 #pragma once
 
 #include "NetworkBrokerData.hpp"
+#include "TransmitQueue.hpp"
 #include "gmlc/concurrency/TriggerVariable.hpp"
 #include "gmlc/concurrency/TripWire.hpp"
-#include "gmlc/containers/BlockingPriorityQueue.hpp"
 #include "helics/core/ActionMessage.hpp"
 
 #include <functional>
@@ -82,9 +82,26 @@ class CommsInterface {
     /** set the max message size and max Queue size
      */
     void setMessageSize(int maxMsgSize, int maxCount);
+    /** get the maximum message size for the comms*/
+    int getMaxMessageSize() const { return maxMessageSize; }
+    /** turn on or off recording of the time messages wait for transmission*/
+    void setLatencyTracking(bool active) { txQueue.setLatencyTracking(active); }
+    /** get the histogram of the time messages waited for transmission*/
+    const LatencyHistogram& getTransmitLatency() const { return txQueue.getLatency(); }
+    /** check if the data waiting for transmission exceeds the transmit data limit*/
+    bool transmitBacklogged() const { return txQueue.overDataLimit(); }
+    /** check if the comms can send and receive a large payload in a frame separate from the
+    command*/
+    virtual bool supportsPayloadFrames() const { return false; }
+    /** send large payloads on a route in a separate frame
+    @details only valid for comms that support payload frames, and only once the other side of
+    the route has reported that it can receive them*/
+    void enablePayloadFrames(route_id rid);
     /** check if the commInterface is connected
      */
     bool isConnected() const;
+    /** check if messages sent on a route are delivered in the order they were sent*/
+    bool hasOrderedDelivery() const { return orderedDelivery; }
 
     /** set the timeout for the initial broker connection
     @param timeOut the value is in milliseconds
@@ -140,6 +157,7 @@ class CommsInterface {
     bool serverMode{true};  //!< some comms have a server mode and non-server mode
     bool autoBroker{false};  //!< the broker should be automatically generated if needed
     bool useJsonSerialization{false};  //!< true to make all connections use JSON serialization
+    bool orderedDelivery{true};  //!< messages on a route are delivered in order
     /** timeout for the initial connection to a broker or to bind a broker port(in ms)*/
     std::chrono::milliseconds connectionTimeout{4000};
     int maxMessageSize = 16 * 1024;  //!< the maximum message size for the queues (if needed)
@@ -149,8 +167,7 @@ class CommsInterface {
         ActionCallback;  //!< the callback for what to do with a received message
     std::function<void(int level, const std::string& name, const std::string& message)>
         loggingCallback;  //!< callback for logging
-    gmlc::containers::BlockingPriorityQueue<std::pair<route_id, ActionMessage>>
-        txQueue;  //!< set of messages waiting to be transmitted
+    TransmitQueue txQueue;  //!< set of messages waiting to be transmitted
     // closing the files or connection can take some time so there is a need for inter-thread
     // communication to not spit out warning messages if it is in the process of disconnecting
     std::atomic<bool> disconnecting{
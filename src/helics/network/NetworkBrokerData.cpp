@@ -89,8 +89,22 @@ std::shared_ptr<helicsCLI11App>
                      "The maximum number of message to have in a queue")
         ->capture_default_str()
         ->check(CLI::PositiveNumber);
+    nbparser
+        ->add_option(
+            "--maxtxbytes",
+            maxTransmitBytes,
+            "the maximum number of bytes of data messages waiting for transmission before sending blocks, 0 for no limit")
+        ->capture_default_str()
+        ->ignore_underscore();
     nbparser->add_option("--networkretries", maxRetries, "the maximum number of network retries")
         ->capture_default_str();
+    nbparser
+        ->add_option(
+            "--compression_threshold",
+            compressionThreshold,
+            "the smallest payload in bytes to compress on routes with compression enabled")
+        ->capture_default_str()
+        ->ignore_underscore();
     nbparser->add_flag("--useosport",
                        use_os_port,
                        "specify that the ports should be allocated by the host operating system");
@@ -6,6 +6,7 @@ SPDX-License-Identifier: BSD-3-Clause
 */
 #pragma once
 
+#include <cstddef>
 #include <memory>
 #include <string>
 #include <utility>
@@ -55,7 +56,11 @@ class NetworkBrokerData {
     int portStart{-1};  //!< the starting port for automatic port definitions
     int maxMessageSize{16 * 256};  //!< maximum message size
     int maxMessageCount{256};  //!< maximum message count
+    /// bound on the memory used by data messages waiting for transmission (0 for no bound)
+    std::size_t maxTransmitBytes{64 * 1024 * 1024};
     int maxRetries{5};  //!< the maximum number of retries to establish a network connection
+    /// the smallest payload considered for compression on routes that negotiate it
+    std::size_t compressionThreshold{1024};
     InterfaceNetworks interfaceNetwork{InterfaceNetworks::LOCAL};
     bool reuse_address{false};  //!< allow reuse of binding address
     bool use_os_port{false};  //!< specify that any automatic port allocation should use operating
@@ -10,8 +10,12 @@ SPDX-License-Identifier: BSD-3-Clause
 #include "NetworkBrokerData.hpp"
 #include "helics/core/ActionMessage.hpp"
 
+#include <algorithm>
 #include <memory>
+#include <random>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace helics {
 NetworkCommsInterface::NetworkCommsInterface(InterfaceTypes type,
@@ -23,6 +27,16 @@ NetworkCommsInterface::NetworkCommsInterface(InterfaceTypes type,
 
 static const std::string localHostString = "localhost";
 
+std::chrono::milliseconds NetworkCommsInterface::connectionRetryDelay(int attempt)
+{
+    static constexpr int firstDelay{25};
+    static constexpr int maximumDelay{1000};
+    thread_local std::mt19937 generator{std::random_device{}()};
+    const int upper = std::min(firstDelay << std::clamp(attempt, 0, 6), maximumDelay);
+    std::uniform_int_distribution<int> spread(upper / 2, upper);
+    return std::chrono::milliseconds(spread(generator));
+}
+
 int NetworkCommsInterface::PortAllocator::findOpenPort(int count, const std::string& host)
 {
     if ((host == "127.0.0.1") || (host == "::1")) {
@@ -83,6 +97,7 @@ void NetworkCommsInterface::loadNetworkInfo(const NetworkBrokerData& netInfo)
     brokerPort = netInfo.brokerPort;
     PortNumber = netInfo.portNumber;
     maxRetries = netInfo.maxRetries;
+    compressionThreshold = netInfo.compressionThreshold;
     switch (networkType) {
         case InterfaceTypes::TCP:
         case InterfaceTypes::UDP:
@@ -191,6 +206,47 @@ void NetworkCommsInterface::setFlag(const std::string& flag, bool val)
     }
 }
 
+void NetworkCommsInterface::setRouteCompression(route_id rid, bool active)
+{
+    std::lock_guard<std::mutex> lock(compressionLock);
+    if (active) {
+        routeCompressors.emplace(rid, PayloadCompressor(compressionThreshold));
+    } else {
+        routeCompressors.erase(rid);
+    }
+    anyCompression.store(!routeCompressors.empty());
+}
+
+std::vector<std::pair<route_id, PayloadCompressor::Statistics>>
+    NetworkCommsInterface::getCompressionStats() const
+{
+    std::vector<std::pair<route_id, PayloadCompressor::Statistics>> stats;
+    std::lock_guard<std::mutex> lock(compressionLock);
+    stats.reserve(routeCompressors.size());
+    for (const auto& compressor : routeCompressors) {
+        stats.emplace_back(compressor.first, compressor.second.statistics());
+    }
+    return stats;
+}
+
+bool NetworkCommsInterface::compressForRoute(route_id rid, ActionMessage& cmd)
+{
+    if (!anyCompression.load() || rid == control_route ||
+        !PayloadCompressor::isCandidateType(cmd)) {
+        return false;
+    }
+    ActionMessage wrapper;
+    {
+        std::lock_guard<std::mutex> lock(compressionLock);
+        auto fnd = routeCompressors.find(rid);
+        if (fnd == routeCompressors.end() || !fnd->second.compress(cmd, wrapper)) {
+            return false;
+        }
+    }
+    cmd = std::move(wrapper);
+    return true;
+}
+
 ActionMessage NetworkCommsInterface::generateReplyToIncomingMessage(ActionMessage& cmd)
 {
     if (isProtocolCommand(cmd)) {
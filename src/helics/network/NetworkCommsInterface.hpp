@@ -7,11 +7,17 @@ SPDX-License-Identifier: BSD-3-Clause
 #pragma once
 
 #include "CommsInterface.hpp"
+#include "helics/core/PayloadCompression.hpp"
 #include "helics/helics-config.h"
 
+#include <atomic>
+#include <chrono>
 #include <map>
+#include <mutex>
 #include <set>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace helics {
 /** implementation for the communication interface that uses ZMQ messages to communicate*/
@@ -51,6 +57,12 @@ class NetworkCommsInterface: public CommsInterface {
     void setAutomaticPortStartPort(int startingPort);
     /** set a flag on the communication system*/
     virtual void setFlag(const std::string& flag, bool val) override;
+    /** turn payload compression on or off for a route
+    @details should only be activated once the other end of the route has agreed to
+    decompress messages*/
+    void setRouteCompression(route_id rid, bool active);
+    /** get the compression statistics for each route with compression active*/
+    std::vector<std::pair<route_id, PayloadCompressor::Statistics>> getCompressionStats() const;
 
   protected:
     int brokerPort{-1};  //!< standardized broker port to use for connection to the brokers
@@ -64,8 +76,17 @@ class NetworkCommsInterface: public CommsInterface {
     std::atomic<bool> hasBroker{false};
     int maxRetries{5};  // the maximum number of network retries
 
+    /** replace a command with its compressed form if compression is active on the route
+    @return true if the command was replaced*/
+    bool compressForRoute(route_id rid, ActionMessage& cmd);
+
   private:
     PortAllocator openPorts;  //!< a structure to deal with port allocations
+    /// the payload size threshold for compression
+    std::size_t compressionThreshold{PayloadCompressor::defaultThreshold};
+    std::atomic<bool> anyCompression{false};  //!< flag indicating some route uses compression
+    mutable std::mutex compressionLock;  //!< lock protecting the route compressors
+    std::map<route_id, PayloadCompressor> routeCompressors;  //!< the compressor for each route
 
   public:
     /** find an open port for a subBroker*/
@@ -84,6 +105,19 @@ class NetworkCommsInterface: public CommsInterface {
   protected:
     ActionMessage generatePortRequest(int cnt = 1) const;
     void loadPortDefinitions(const ActionMessage& cmd);
+    /** get a randomized delay before a connection attempt
+    @details the delay grows exponentially with the attempt number up to a limit and is spread
+    randomly so that many clients started together do not retry in lockstep
+    @param attempt the number of attempts already made*/
+    static std::chrono::milliseconds connectionRetryDelay(int attempt);
+    /** get the delay to wait after the broker asks for the connection to be delayed*/
+    std::chrono::milliseconds nextConnectionDelay()
+    {
+        return connectionRetryDelay(++connectionDelayCount);
+    }
+
+  private:
+    int connectionDelayCount{0};  //!< the number of connection delays requested by the broker
 };
 
 }  // namespace helics
@@ -0,0 +1,238 @@
+/*
+Copyright (c) 2017-2021,
+Battelle Memorial Institute; Lawrence Livermore National Security, LLC; Alliance for Sustainable
+Energy, LLC.  See the top-level NOTICE for additional details. All rights reserved.
+SPDX-License-Identifier: BSD-3-Clause
+*/
+#include "TransmitQueue.hpp"
+
+#include <utility>
+
+namespace helics {
+static std::size_t laneFor(TrafficClass cls)
+{
+    // protocol messages on a regular route are scheduled along with the timing messages
+    return (cls == TrafficClass::CONTROL) ? 0U : static_cast<std::size_t>(cls) - 1U;
+}
+
+static bool isBoundedClass(TrafficClass cls)
+{
+    return (cls == TrafficClass::DATA || cls == TrafficClass::BULK);
+}
+
+static std::size_t messageBytes(const ActionMessage& cmd)
+{
+    return sizeof(ActionMessage) + cmd.payload.size();
+}
+
+TrafficClass TransmitQueue::classify(route_id rid, const ActionMessage& cmd)
+{
+    if (rid == control_route || isPriorityCommand(cmd) || isProtocolCommand(cmd)) {
+        return TrafficClass::CONTROL;
+    }
+    if (isTimingCommand(cmd)) {
+        return TrafficClass::TIMING;
+    }
+    return (cmd.payload.size() >= bulkMessageSize) ? TrafficClass::BULK : TrafficClass::DATA;
+}
+
+void TransmitQueue::emplace(route_id rid, const ActionMessage& cmd)
+{
+    push(rid, ActionMessage(cmd), false);
+}
+
+void TransmitQueue::emplace(route_id rid, ActionMessage&& cmd)
+{
+    push(rid, std::move(cmd), false);
+}
+
+void TransmitQueue::emplacePriority(route_id rid, const ActionMessage& cmd)
+{
+    push(rid, ActionMessage(cmd), true);
+}
+
+void TransmitQueue::emplacePriority(route_id rid, ActionMessage&& cmd)
+{
+    push(rid, std::move(cmd), true);
+}
+
+void TransmitQueue::push(route_id rid, ActionMessage&& cmd, bool priority)
+{
+    std::unique_lock<std::mutex> lock(queueLock);
+    if (trackLatency) {
+        cmd.enqueueTime = LatencyHistogram::now();
+    }
+    if (priority) {
+        priorityLane.emplace_back(rid, std::move(cmd));
+    } else if (rid == control_route) {
+        barriers.emplace_back(latestEpoch, value_type(rid, std::move(cmd)));
+        ++latestEpoch;
+        epochCounts.push_back(0);
+    } else {
+        auto cls = classify(rid, cmd);
+        if (isBoundedClass(cls)) {
+            queuedDataBytes += messageBytes(cmd);
+            updateDataLimit();
+        }
+        auto& route = routes[rid];
+        route.messages.emplace_back(latestEpoch, std::move(cmd));
+        ++epochCounts.back();
+        schedule(rid, route);
+    }
+    ++messageCount;
+    lock.unlock();
+    messageAvailable.notify_one();
+}
+
+void TransmitQueue::schedule(route_id rid, RouteQueue& route)
+{
+    if (route.scheduled || route.messages.empty() ||
+        route.messages.front().first != currentEpoch) {
+        return;
+    }
+    lanes[laneFor(classify(rid, route.messages.front().second))].push_back(rid);
+    route.scheduled = true;
+}
+
+void TransmitQueue::updateDataLimit()
+{
+    dataLimitExceeded.store(backpressure && dataLimit > 0 && queuedDataBytes > dataLimit,
+                            std::memory_order_relaxed);
+}
+
+void TransmitQueue::advanceEpoch()
+{
+    ++currentEpoch;
+    epochCounts.pop_front();
+    for (auto& route : routes) {
+        schedule(route.first, route.second);
+    }
+}
+
+TransmitQueue::value_type TransmitQueue::popRoute(std::deque<route_id>& lane)
+{
+    auto rid = lane.front();
+    lane.pop_front();
+    auto& route = routes[rid];
+    value_type result(rid, std::move(route.messages.front().second));
+    route.messages.pop_front();
+    route.scheduled = false;
+    --epochCounts.front();
+    if (isBoundedClass(classify(rid, result.second))) {
+        queuedDataBytes -= messageBytes(result.second);
+        updateDataLimit();
+    }
+    schedule(rid, route);
+    return result;
+}
+
+std::optional<TransmitQueue::value_type> TransmitQueue::popReady()
+{
+    auto result = selectReady();
+    if (result && trackLatency) {
+        latency.record(result->second.enqueueTime);
+        result->second.enqueueTime = 0;
+    }
+    return result;
+}
+
+std::optional<TransmitQueue::value_type> TransmitQueue::selectReady()
+{
+    if (!priorityLane.empty()) {
+        value_type result = std::move(priorityLane.front());
+        priorityLane.pop_front();
+        --messageCount;
+        return result;
+    }
+    if (!barriers.empty() && epochCounts.front() == 0) {
+        value_type result = std::move(barriers.front().second);
+        barriers.pop_front();
+        advanceEpoch();
+        --messageCount;
+        return result;
+    }
+    // weighted round robin over the class lanes, visiting the starting lane again with new credits
+    for (std::size_t attempt = 0; attempt <= lanes.size(); ++attempt) {
+        if (!lanes[laneIndex].empty() && laneCredits > 0) {
+            --laneCredits;
+            --messageCount;
+            return popRoute(lanes[laneIndex]);
+        }
+        laneIndex = (laneIndex + 1) % lanes.size();
+        laneCredits = laneWeights[laneIndex];
+    }
+    return std::nullopt;
+}
+
+TransmitQueue::value_type TransmitQueue::pop()
+{
+    std::unique_lock<std::mutex> lock(queueLock);
+    while (true) {
+        auto result = popReady();
+        if (result) {
+            return std::move(*result);
+        }
+        messageAvailable.wait(lock);
+    }
+}
+
+std::optional<TransmitQueue::value_type> TransmitQueue::pop(std::chrono::milliseconds timeout)
+{
+    auto stopTime = std::chrono::steady_clock::now() + timeout;
+    std::unique_lock<std::mutex> lock(queueLock);
+    while (true) {
+        auto result = popReady();
+        if (result) {
+            return result;
+        }
+        if (messageAvailable.wait_until(lock, stopTime) == std::cv_status::timeout) {
+            return popReady();
+        }
+    }
+}
+
+std::optional<TransmitQueue::value_type> TransmitQueue::try_pop()
+{
+    std::lock_guard<std::mutex> lock(queueLock);
+    return popReady();
+}
+
+bool TransmitQueue::empty() const
+{
+    std::lock_guard<std::mutex> lock(queueLock);
+    return (messageCount == 0);
+}
+
+std::size_t TransmitQueue::size() const
+{
+    std::lock_guard<std::mutex> lock(queueLock);
+    return messageCount;
+}
+
+std::size_t TransmitQueue::dataBytes() const
+{
+    std::lock_guard<std::mutex> lock(queueLock);
+    return queuedDataBytes;
+}
+
+void TransmitQueue::setDataLimit(std::size_t maxBytes)
+{
+    std::lock_guard<std::mutex> lock(queueLock);
+    dataLimit = maxBytes;
+    updateDataLimit();
+}
+
+void TransmitQueue::setLatencyTracking(bool active)
+{
+    std::lock_guard<std::mutex> lock(queueLock);
+    trackLatency = active;
+}
+
+void TransmitQueue::setBackpressure(bool active)
+{
+    std::lock_guard<std::mutex> lock(queueLock);
+    backpressure = active;
+    updateDataLimit();
+}
+
+}  // namespace helics
@@ -0,0 +1,124 @@
+/*
+Copyright (c) 2017-2021,
+Battelle Memorial Institute; Lawrence Livermore National Security, LLC; Alliance for Sustainable
+Energy, LLC.  See the top-level NOTICE for additional details. All rights reserved.
+SPDX-License-Identifier: BSD-3-Clause
+*/
+#pragma once
+
+#include "helics/core/ActionMessage.hpp"
+#include "helics/core/LatencyHistogram.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+
+namespace helics {
+/** traffic classes for messages waiting to be transmitted*/
+enum class TrafficClass : int {
+    CONTROL = 0,  //!< priority commands and comms protocol messages
+    TIMING = 1,  //!< time coordination messages
+    DATA = 2,  //!< general data and registration messages
+    BULK = 3  //!< messages carrying large payloads
+};
+
+/** queue of messages waiting for transmission with separate lanes for different traffic classes
+@details priority commands are always sent first; the remaining messages are scheduled with a
+weighted round robin over the timing, data, and bulk classes.  Messages on a single route are always
+sent in the order they were queued, so classes only overtake each other across routes.  A
+non-priority message on the control route is a barrier and is sent only after everything queued
+before it.  The memory used by data and bulk messages can be bounded.  Queueing never blocks since
+it is called from the core and broker processing loops; instead the queue reports when the bound
+is exceeded so the core can hold federates before they produce more data.
+*/
+class TransmitQueue {
+  public:
+    using value_type = std::pair<route_id, ActionMessage>;
+    /** the payload size at which a message is treated as bulk traffic*/
+    static constexpr std::size_t bulkMessageSize{16 * 1024};
+    /** the number of messages the timing, data, and bulk lanes may send in a turn*/
+    static constexpr std::array<int, 3> laneWeights{8, 4, 1};
+
+    TransmitQueue() = default;
+    /** queue a message for transmission along a route*/
+    void emplace(route_id rid, const ActionMessage& cmd);
+    /** queue a message for transmission along a route*/
+    void emplace(route_id rid, ActionMessage&& cmd);
+    /** queue a message in the control lane*/
+    void emplacePriority(route_id rid, const ActionMessage& cmd);
+    /** queue a message in the control lane*/
+    void emplacePriority(route_id rid, ActionMessage&& cmd);
+    /** get the next message to transmit, blocking until one is available*/
+    value_type pop();
+    /** get the next message to transmit, waiting for at most the specified timeout*/
+    std::optional<value_type> pop(std::chrono::milliseconds timeout);
+    /** get the next message to transmit if one is available*/
+    std::optional<value_type> try_pop();
+    /** check if there are no messages waiting*/
+    bool empty() const;
+    /** get the number of messages waiting*/
+    std::size_t size() const;
+    /** get the approximate number of bytes used by waiting data and bulk messages*/
+    std::size_t dataBytes() const;
+    /** set the bound on the bytes used by waiting data and bulk messages, 0 for no bound*/
+    void setDataLimit(std::size_t maxBytes);
+    /** turn on or off reporting that the data limit is exceeded
+    @details this should only be active while a transmitter is removing messages*/
+    void setBackpressure(bool active);
+    /** check if the data limit is exceeded while backpressure is active, safe to call without
+    holding the queue*/
+    bool overDataLimit() const { return dataLimitExceeded.load(std::memory_order_relaxed); }
+    /** turn on or off recording of the time messages wait in the queue*/
+    void setLatencyTracking(bool active);
+    /** get the histogram of the time messages waited in the queue*/
+    const LatencyHistogram& getLatency() const { return latency; }
+    /** determine the traffic class of a message sent along a route*/
+    static TrafficClass classify(route_id rid, const ActionMessage& cmd);
+
+  private:
+    /// messages queued for a single route tagged with their barrier epoch
+    struct RouteQueue {
+        std::deque<std::pair<std::uint64_t, ActionMessage>> messages;
+        bool scheduled{false};  //!< the route is in one of the class lanes
+    };
+    void push(route_id rid, ActionMessage&& cmd, bool priority);
+    std::optional<value_type> popReady();
+    std::optional<value_type> selectReady();
+    value_type popRoute(std::deque<route_id>& lane);
+    /** put a route in the lane for its first message if the message is sendable*/
+    void schedule(route_id rid, RouteQueue& route);
+    /** start the next epoch after a barrier is sent*/
+    void advanceEpoch();
+    /** update the data limit indicator, must be called with the queue locked*/
+    void updateDataLimit();
+
+    mutable std::mutex queueLock;
+    std::condition_variable messageAvailable;
+    std::deque<value_type> priorityLane;
+    /// barrier messages with the epoch that must complete before they are sent
+    std::deque<std::pair<std::uint64_t, value_type>> barriers;
+    std::unordered_map<route_id, RouteQueue> routes;
+    /// routes ready to send, indexed by traffic class - TIMING
+    std::array<std::deque<route_id>, 3> lanes;
+    /// messages outstanding in each epoch starting with the current one
+    std::deque<std::size_t> epochCounts{0};
+    std::uint64_t currentEpoch{0};
+    std::uint64_t latestEpoch{0};
+    std::size_t messageCount{0};
+    std::size_t queuedDataBytes{0};
+    std::size_t dataLimit{0};
+    std::size_t laneIndex{0};
+    int laneCredits{laneWeights[0]};
+    bool backpressure{false};
+    std::atomic<bool> dataLimitExceeded{false};
+    bool trackLatency{false};
+    LatencyHistogram latency;
+};
+}  // namespace helics
@@ -34,6 +34,7 @@ namespace tcp {
       private:
         virtual bool brokerConnect() override;
         bool no_outgoing_connections = false;  //!< disable outgoing connections if true;
+        bool multiplex_connections = false;  //!< share outgoing connections in the process
         std::vector<std::string>
             connections;  //!< defined connections These are connections that the comm section
         //!< reaches out to regardless of whether it is a broker/core/ or server
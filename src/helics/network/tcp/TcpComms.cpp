@@ -233,11 +233,7 @@ namespace tcp {
                         "initial connection to broker timed out exceeding max number of retries ");
                     return terminate(connection_status::error);
                 }
-                if (retries % 2 == 1) {
-                    std::this_thread::yield();
-                } else {
-                    std::this_thread::sleep_for(std::chrono::milliseconds(100));
-                }
+                std::this_thread::sleep_for(connectionRetryDelay(retries));
 
                 if (requestDisconnect.load(std::memory_order::memory_order_acquire)) {
                     return terminate(connection_status::terminated);
@@ -319,7 +315,7 @@ namespace tcp {
                             continue;
                         }
                         if (mess->second.messageID == DELAY_CONNECTION) {
-                            std::this_thread::sleep_for(std::chrono::seconds(2));
+                            std::this_thread::sleep_for(nextConnectionDelay());
                             continue;
                         }
                         rxMessageQueue.push(mess->second);
@@ -419,6 +415,7 @@ namespace tcp {
             if (processed) {
                 continue;
             }
+            compressForRoute(rid, cmd);
 
             if (rid == parent_route_id) {
                 if (hasBroker) {
@@ -13,6 +13,7 @@ SPDX-License-Identifier: BSD-3-Clause
 #include "../networkDefaults.hpp"
 #include "TcpCommsCommon.h"
 #include "TcpHelperClasses.h"
+#include "TcpMuxConnection.h"
 
 #include <map>
 #include <memory>
@@ -64,6 +65,11 @@ namespace tcp {
                 outgoingConnectionsAllowed = val;
                 propertyUnLock();
             }
+        } else if (flag == "multiplex") {
+            if (propertyLock()) {
+                multiplexed = val;
+                propertyUnLock();
+            }
         } else {
             NetworkCommsInterface::setFlag(flag, val);
         }
@@ -83,29 +89,30 @@ namespace tcp {
         return 0;
     }
 
-    size_t
-        TcpCommsSS::dataReceive(TcpConnection* connection, const char* data, size_t bytes_received)
+    void TcpCommsSS::receiveMessage(ActionMessage&& cmd, int connectionId, std::uint32_t channel)
     {
-        size_t used_total = 0;
-        while (used_total < bytes_received) {
-            ActionMessage m;
-            auto used = m.depacketize(reinterpret_cast<const std::byte*>(data) + used_total,
-                                      bytes_received - used_total);
-            if (used == 0) {
-                break;
-            }
-            if (isProtocolCommand(m)) {
-                m.setExtraData(connection->getIdentifier());
-                txQueue.emplace(control_route, std::move(m));
-            } else {
-                if (ActionCallback) {
-                    ActionCallback(std::move(m));
-                }
+        if (isProtocolCommand(cmd)) {
+            cmd.setExtraData(connectionId);
+            cmd.setExtraDestData(static_cast<int32_t>(channel));
+            txQueue.emplace(control_route, std::move(cmd));
+        } else {
+            if (ActionCallback) {
+                ActionCallback(std::move(cmd));
             }
-            used_total += used;
         }
+    }
 
-        return used_total;
+    size_t
+        TcpCommsSS::dataReceive(TcpConnection* connection, const char* data, size_t bytes_received)
+    {
+        // incoming sockets may carry frames from several multiplexed comms
+        return extractMuxFrames(data,
+                                bytes_received,
+                                [this, connection](std::uint32_t channel, ActionMessage&& m) {
+                                    receiveMessage(std::move(m),
+                                                   connection->getIdentifier(),
+                                                   channel);
+                                });
     }
 
     void TcpCommsSS::queue_rx_function()
@@ -113,6 +120,40 @@ namespace tcp {
         // this function does nothing since everything is handled in the other thread
     }
 
+    /** a route to another comms, either a socket of its own or a channel on a shared socket*/
+    struct TcpRoute {
+        TcpConnection::pointer connection;  //!< the socket used by the route
+        std::shared_ptr<TcpMuxConnection> mux;  //!< the shared connection for outgoing channels
+        std::uint32_t channel{0};  //!< the multiplexed channel, 0 if the socket is not shared
+
+        TcpRoute() = default;
+        TcpRoute(TcpConnection::pointer conn, std::uint32_t chan = 0):
+            connection(std::move(conn)), channel(chan)
+        {
+        }
+        explicit operator bool() const { return connection || mux; }
+        /** send a command
+        @throws std::system_error on failure*/
+        void send(const ActionMessage& cmd) const
+        {
+            if (mux) {
+                mux->send(channel, cmd);
+            } else {
+                connection->send(generateMuxFrame(channel, cmd));
+            }
+        }
+        /** close the socket or release the channel on a shared connection*/
+        void close()
+        {
+            if (mux) {
+                mux->removeChannel(channel);
+                mux.reset();
+            } else if (connection) {
+                connection->close();
+            }
+        }
+    };
+
     static TcpConnection::pointer generateConnection(std::shared_ptr<AsioContextManager>& ioctx,
                                                      const std::string& address)
     {
@@ -181,18 +222,64 @@ namespace tcp {
         cmessage.payload = getAddress();
         auto cstring = cmessage.packetize();
 
-        std::vector<std::pair<std::string, TcpConnection::pointer>> made_connections;
+        // open a channel on the connection shared by all the comms in the process for an address
+        auto generateMuxRoute = [this, ci, &ioctx, &cmessage](const std::string& host,
+                                                              const std::string& port) {
+            TcpRoute route;
+            route.mux = TcpMuxConnection::getConnection(ioctx->getBaseContext(),
+                                                        host,
+                                                        port,
+                                                        maxMessageSize,
+                                                        std::chrono::milliseconds(connectionTimeout));
+            if (route.mux) {
+                auto connectionId = route.mux->getIdentifier();
+                route.channel = route.mux->addChannel(
+                    [this, connectionId](ActionMessage&& m) {
+                        receiveMessage(std::move(m), connectionId, 0);
+                    },
+                    [ci](const std::error_code& error) { commErrorHandler(ci, nullptr, error); });
+                try {
+                    route.send(cmessage);
+                }
+                catch (const std::system_error&) {
+                    route.close();
+                    throw;
+                }
+            }
+            return route;
+        };
+        auto generateRoute = [&](const std::string& address) {
+            TcpRoute route;
+            if (multiplexed) {
+                try {
+                    std::string interface;
+                    std::string port;
+                    std::tie(interface, port) = extractInterfaceandPortString(address);
+                    route = generateMuxRoute(interface, port);
+                }
+                catch (std::exception&) {
+                    route = TcpRoute{};
+                }
+                return route;
+            }
+            auto new_connect = generateConnection(ioctx, address);
+            if (new_connect) {
+                new_connect->setDataCall(dataCall);
+                new_connect->setErrorCall(errorCall);
+                new_connect->send(cstring);
+                new_connect->startReceive();
+                route.connection = std::move(new_connect);
+            }
+            return route;
+        };
+
+        std::vector<std::pair<std::string, TcpRoute>> made_connections;
         std::map<std::string, route_id> established_routes;
         if (outgoingConnectionsAllowed) {
             for (const auto& conn : connections) {
-                auto new_connect = generateConnection(ioctx, conn);
+                auto new_connect = generateRoute(conn);
 
                 if (new_connect) {
-                    new_connect->setDataCall(dataCall);
-                    new_connect->setErrorCall(errorCall);
-                    new_connect->send(cstring);
-                    new_connect->startReceive();
-
                     made_connections.emplace_back(conn, std::move(new_connect));
                 }
             }
@@ -200,9 +287,9 @@ namespace tcp {
         setRxStatus(connection_status::connected);
         std::vector<char> buffer;
 
-        TcpConnection::pointer brokerConnection;
+        TcpRoute brokerConnection;
 
-        std::map<route_id, TcpConnection::pointer> routes;  // for all the other possible routes
+        std::map<route_id, TcpRoute> routes;  // for all the other possible routes
         if (!brokerTargetAddress.empty()) {
             hasBroker = true;
         }
@@ -212,14 +299,22 @@ namespace tcp {
             }
             if (outgoingConnectionsAllowed) {
                 try {
-                    brokerConnection = makeConnection(ioctx->getBaseContext(),
-                                                      brokerTargetAddress,
-                                                      std::to_string(brokerPort),
-                                                      maxMessageSize,
-                                                      std::chrono::milliseconds(connectionTimeout));
+                    if (multiplexed) {
+                        brokerConnection =
+                            generateMuxRoute(brokerTargetAddress, std::to_string(brokerPort));
+                    } else {
+                        brokerConnection =
+                            makeConnection(ioctx->getBaseContext(),
+                                           brokerTargetAddress,
+                                           std::to_string(brokerPort),
+                                           maxMessageSize,
+                                           std::chrono::milliseconds(connectionTimeout));
+                    }
                     if (!brokerConnection) {
                         logError("initial connection to broker timed out");
-
+                        for (auto& mc : made_connections) {
+                            mc.second.close();
+                        }
                         if (server) {
                             server->close();
                         }
@@ -228,14 +323,20 @@ namespace tcp {
                         return;
                     }
 
-                    brokerConnection->setDataCall(dataCall);
-                    brokerConnection->setErrorCall(errorCall);
+                    if (!multiplexed) {
+                        brokerConnection.connection->setDataCall(dataCall);
+                        brokerConnection.connection->setErrorCall(errorCall);
 
-                    brokerConnection->send(cstring);
-                    brokerConnection->startReceive();
+                        brokerConnection.connection->send(cstring);
+                        brokerConnection.connection->startReceive();
+                    }
                 }
                 catch (std::exception& e) {
                     logError(e.what());
+                    brokerConnection.close();
+                    for (auto& mc : made_connections) {
+                        mc.second.close();
+                    }
                     setTxStatus(connection_status::error);
                     setRxStatus(connection_status::error);
                     return;
@@ -261,7 +362,10 @@ namespace tcp {
                     switch (cmd.messageID) {
                         case CONNECTION_INFORMATION:
                             if (server) {
-                                auto conn = server->findSocket(cmd.getExtraData());
+                                // the extra dest data carries the channel for multiplexed
+                                // connections
+                                TcpRoute conn(server->findSocket(cmd.getExtraData()),
+                                              static_cast<std::uint32_t>(cmd.getExtraDestData()));
                                 if (conn) {
                                     if (!brokerConnection) {  // check if the connection matches the
                                                               // broker
@@ -309,13 +413,8 @@ namespace tcp {
                             if (!established) {
                                 if (outgoingConnectionsAllowed) {
                                     auto new_connect =
-                                        generateConnection(ioctx,
-                                                           std::string(cmd.payload.to_string()));
+                                        generateRoute(std::string(cmd.payload.to_string()));
                                     if (new_connect) {
-                                        new_connect->setDataCall(dataCall);
-                                        new_connect->setErrorCall(errorCall);
-                                        new_connect->send(cstring);
-                                        new_connect->startReceive();
                                         routes.emplace(route_id{cmd.getExtraData()},
                                                        std::move(new_connect));
                                         established_routes[std::string(cmd.payload.to_string())] =
@@ -346,11 +445,12 @@ namespace tcp {
             if (processed) {
                 continue;
             }
+            compressForRoute(rid, cmd);
 
             if (rid == parent_route_id) {
                 if ((hasBroker) && (brokerConnection)) {
                     try {
-                        brokerConnection->send(cmd.packetize());
+                        brokerConnection.send(cmd);
                     }
                     catch (const std::system_error& se) {
                         if (se.code() != asio::error::connection_aborted) {
@@ -370,7 +470,7 @@ namespace tcp {
                 auto rt_find = routes.find(rid);
                 if (rt_find != routes.end()) {
                     try {
-                        rt_find->second->send(cmd.packetize());
+                        rt_find->second.send(cmd);
                     }
                     catch (const std::system_error& se) {
                         if (se.code() != asio::error::connection_aborted) {
@@ -383,7 +483,7 @@ namespace tcp {
                 } else {
                     if (hasBroker) {
                         try {
-                            brokerConnection->send(cmd.packetize());
+                            brokerConnection.send(cmd);
                         }
                         catch (const std::system_error& se) {
                             if (se.code() != asio::error::connection_aborted) {
@@ -405,21 +505,15 @@ namespace tcp {
         }  // while (!haltLoop)
 
         for (auto& rt : made_connections) {
-            if (rt.second) {
-                rt.second->close();
-            }
+            rt.second.close();
         }
         made_connections.clear();
         for (auto& rt : routes) {
-            if (rt.second) {
-                rt.second->close();
-            }
-        }
-        if (brokerConnection) {
-            brokerConnection->close();
+            rt.second.close();
         }
+        brokerConnection.close();
         routes.clear();
-        brokerConnection = nullptr;
+        brokerConnection = TcpRoute{};
         setTxStatus(connection_status::terminated);
         if (server) {
             std::this_thread::sleep_for(std::chrono::milliseconds(50));
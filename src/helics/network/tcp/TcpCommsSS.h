@@ -9,6 +9,7 @@ SPDX-License-Identifier: BSD-3-Clause
 #include "../NetworkCommsInterface.hpp"
 
 #include <atomic>
+#include <cstdint>
 #include <set>
 #include <string>
 #include <vector>
@@ -41,6 +42,7 @@ namespace tcp {
         bool outgoingConnectionsAllowed{
             true};  //!< disable all outgoing connections- allow only incoming connections
         bool reuse_address{false};
+        bool multiplexed{false};  //!< share outgoing connections with the other comms in the process
         std::vector<std::string> connections;  //!< list of connections to make
         virtual int getDefaultBrokerPort() const override;
         virtual void queue_rx_function() override;  //!< the functional loop for the receive queue
@@ -50,6 +52,13 @@ namespace tcp {
     return code for required action 0=NONE, -1 TERMINATE*/
         int processIncomingMessage(ActionMessage&& cmd);
 
+        /** handle a single message received on a connection
+    @param cmd the received message
+    @param connectionId the identifier of the socket the message arrived on
+    @param channel the multiplexed channel of the message, 0 if not multiplexed
+    */
+        void receiveMessage(ActionMessage&& cmd, int connectionId, std::uint32_t channel);
+
         /** callback function for receiving data asynchronously from the socket
     @param connection pointer to the connection
     @param data the pointer to the data
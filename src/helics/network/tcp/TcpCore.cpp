@@ -30,6 +30,10 @@ namespace tcp {
                        no_outgoing_connections,
                        "disable outgoing connections")
             ->ignore_underscore();
+        hApp->add_flag("--multiplex",
+                       multiplex_connections,
+                       "share outgoing connections with the other tcpss cores and brokers in the "
+                       "process");
         return hApp;
     }
 
@@ -42,6 +46,9 @@ namespace tcp {
         if (no_outgoing_connections) {
             comms->setFlag("allow_outgoing", false);
         }
+        if (multiplex_connections) {
+            comms->setFlag("multiplex", true);
+        }
         lock.unlock();
         return NetworkCore::brokerConnect();
     }
@@ -32,6 +32,7 @@ namespace tcp {
       private:
         std::vector<std::string> connections;  //!< defined connections
         bool no_outgoing_connections = false;  //!< disable outgoing connections if true;
+        bool multiplex_connections = false;  //!< share outgoing connections in the process
         virtual bool brokerConnect() override;
     };
 
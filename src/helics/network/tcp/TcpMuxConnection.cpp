@@ -0,0 +1,247 @@
+/*
+Copyright (c) 2017-2021,
+Battelle Memorial Institute; Lawrence Livermore National Security, LLC; Alliance for Sustainable
+Energy, LLC.  See the top-level NOTICE for additional details. All rights reserved.
+SPDX-License-Identifier: BSD-3-Clause
+*/
+#include "TcpMuxConnection.h"
+
+#include "../../core/ActionMessage.hpp"
+#include "TcpCommsCommon.h"
+
+#include <exception>
+#include <future>
+#include <utility>
+#include <vector>
+
+namespace helics {
+namespace tcp {
+    std::string generateMuxFrame(std::uint32_t channel, const ActionMessage& cmd)
+    {
+        if (channel == 0) {
+            return cmd.packetize();
+        }
+        std::string frame;
+        cmd.packetize(frame);
+        frame.insert(0, muxHeaderSize, muxFrameMarker);
+        frame[1] = static_cast<char>((channel >> 24U) & 0xFFU);
+        frame[2] = static_cast<char>((channel >> 16U) & 0xFFU);
+        frame[3] = static_cast<char>((channel >> 8U) & 0xFFU);
+        frame[4] = static_cast<char>(channel & 0xFFU);
+        return frame;
+    }
+
+    std::size_t extractMuxFrames(const char* data,
+                                 std::size_t dataSize,
+                                 const std::function<void(std::uint32_t, ActionMessage&&)>& handler)
+    {
+        std::size_t used_total{0};
+        while (used_total < dataSize) {
+            const char* frame = data + used_total;
+            std::size_t header{0};
+            std::uint32_t channel{0};
+            if (frame[0] == muxFrameMarker) {
+                if (dataSize - used_total < muxHeaderSize) {
+                    break;
+                }
+                for (std::size_t ii = 1; ii < muxHeaderSize; ++ii) {
+                    channel = (channel << 8U) + static_cast<unsigned char>(frame[ii]);
+                }
+                header = muxHeaderSize;
+            }
+            ActionMessage m;
+            auto used = m.depacketize(frame + header, dataSize - used_total - header);
+            if (used == 0) {
+                break;
+            }
+            handler(channel, std::move(m));
+            used_total += header + used;
+        }
+        return used_total;
+    }
+
+    namespace {
+        /** the shared connection to an address and the result of a connection in progress*/
+        struct RegistryEntry {
+            std::weak_ptr<TcpMuxConnection> connection;
+            /// valid while a connection to the address is being made
+            std::shared_future<std::shared_ptr<TcpMuxConnection>> pending;
+        };
+    }  // namespace
+
+    static std::mutex registryLock;
+    static std::map<std::string, RegistryEntry> registry;
+
+    std::shared_ptr<TcpMuxConnection>
+        TcpMuxConnection::getConnection(asio::io_context& io_context,
+                                        const std::string& host,
+                                        const std::string& port,
+                                        std::size_t bufferSize,
+                                        std::chrono::milliseconds timeOut)
+    {
+        const std::string key = host + ':' + port;
+        std::promise<std::shared_ptr<TcpMuxConnection>> result;
+        {
+            std::unique_lock<std::mutex> lock(registryLock);
+            auto& entry = registry[key];
+            auto existing = entry.connection.lock();
+            if (existing && !existing->failed.load()) {
+                return existing;
+            }
+            if (entry.pending.valid()) {
+                // another caller is connecting to the same address so share its socket
+                auto pending = entry.pending;
+                lock.unlock();
+                if (pending.wait_for(timeOut) != std::future_status::ready) {
+                    return nullptr;
+                }
+                return pending.get();
+            }
+            entry.pending = result.get_future().share();
+        }
+        // the registry is not locked while connecting so connections to other addresses proceed
+        std::shared_ptr<TcpMuxConnection> mux;
+        std::exception_ptr error;
+        try {
+            auto conn = makeConnection(io_context, host, port, bufferSize, timeOut);
+            if (conn) {
+                mux.reset(new TcpMuxConnection(std::move(conn)));
+            }
+        }
+        catch (...) {
+            error = std::current_exception();
+        }
+        {
+            std::lock_guard<std::mutex> lock(registryLock);
+            auto& entry = registry[key];
+            entry.connection = mux;
+            entry.pending = {};
+            for (auto it = registry.begin(); it != registry.end();) {
+                if (it->second.connection.expired() && !it->second.pending.valid()) {
+                    it = registry.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+        }
+        if (error) {
+            result.set_exception(error);
+            std::rethrow_exception(error);
+        }
+        result.set_value(mux);
+        return mux;
+    }
+
+    std::size_t TcpMuxConnection::activeConnectionCount()
+    {
+        std::lock_guard<std::mutex> lock(registryLock);
+        std::size_t count{0};
+        for (const auto& entry : registry) {
+            if (!entry.second.connection.expired()) {
+                ++count;
+            }
+        }
+        return count;
+    }
+
+    TcpMuxConnection::TcpMuxConnection(TcpConnection::pointer conn): connection(std::move(conn))
+    {
+        // the callbacks use this directly, the destructor waits for the receive loop to halt before
+        // the object goes away
+        connection->setDataCall(
+            [this](const TcpConnection::pointer& /*unused*/, const char* data, size_t datasize) {
+                return dataReceive(data, datasize);
+            });
+        connection->setErrorCall(
+            [this](const TcpConnection::pointer& /*unused*/, const std::error_code& error) {
+                errorReceive(error);
+                return false;
+            });
+        connection->startReceive();
+    }
+
+    TcpMuxConnection::~TcpMuxConnection() { connection->close(); }
+
+    std::uint32_t TcpMuxConnection::addChannel(ReceiveCallback receive, ErrorCallback error)
+    {
+        auto chan = std::make_shared<Channel>(std::move(receive), std::move(error));
+        std::lock_guard<std::mutex> lock(channelLock);
+        auto channel = nextChannel++;
+        channels.emplace(channel, std::move(chan));
+        return channel;
+    }
+
+    void TcpMuxConnection::removeChannel(std::uint32_t channel)
+    {
+        std::shared_ptr<Channel> chan;
+        {
+            std::lock_guard<std::mutex> lock(channelLock);
+            auto fnd = channels.find(channel);
+            if (fnd == channels.end()) {
+                return;
+            }
+            chan = std::move(fnd->second);
+            channels.erase(fnd);
+        }
+        // waits for a callback in progress on another thread to finish
+        std::lock_guard<std::recursive_mutex> callLock(chan->callLock);
+        chan->active = false;
+    }
+
+    std::shared_ptr<TcpMuxConnection::Channel>
+        TcpMuxConnection::findChannel(std::uint32_t channel) const
+    {
+        std::lock_guard<std::mutex> lock(channelLock);
+        auto fnd = channels.find(channel);
+        return (fnd != channels.end()) ? fnd->second : nullptr;
+    }
+
+    std::size_t TcpMuxConnection::channelCount() const
+    {
+        std::lock_guard<std::mutex> lock(channelLock);
+        return channels.size();
+    }
+
+    void TcpMuxConnection::send(std::uint32_t channel, const ActionMessage& cmd)
+    {
+        auto frame = generateMuxFrame(channel, cmd);
+        std::lock_guard<std::mutex> lock(sendLock);
+        connection->send(frame);
+    }
+
+    std::size_t TcpMuxConnection::dataReceive(const char* data, std::size_t bytesReceived)
+    {
+        // the callbacks run without channelLock so they can add or remove channels
+        return extractMuxFrames(data, bytesReceived, [this](std::uint32_t channel, ActionMessage&& m) {
+            auto chan = findChannel(channel);
+            if (!chan) {
+                return;
+            }
+            std::lock_guard<std::recursive_mutex> callLock(chan->callLock);
+            if (chan->active && chan->receive) {
+                chan->receive(std::move(m));
+            }
+        });
+    }
+
+    void TcpMuxConnection::errorReceive(const std::error_code& error)
+    {
+        failed.store(true);
+        std::vector<std::shared_ptr<Channel>> active;
+        {
+            std::lock_guard<std::mutex> lock(channelLock);
+            active.reserve(channels.size());
+            for (const auto& chan : channels) {
+                active.push_back(chan.second);
+            }
+        }
+        for (const auto& chan : active) {
+            std::lock_guard<std::recursive_mutex> callLock(chan->callLock);
+            if (chan->active && chan->error) {
+                chan->error(error);
+            }
+        }
+    }
+
+}  // namespace tcp
+}  // namespace helics
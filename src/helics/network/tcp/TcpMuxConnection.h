@@ -0,0 +1,115 @@
+/*
+Copyright (c) 2017-2021,
+Battelle Memorial Institute; Lawrence Livermore National Security, LLC; Alliance for Sustainable
+Energy, LLC.  See the top-level NOTICE for additional details. All rights reserved.
+SPDX-License-Identifier: BSD-3-Clause
+*/
+#pragma once
+
+/** @file
+@details process wide sharing of outgoing tcp connections between single socket comms.  Each comms
+object using a shared connection is assigned a channel and every message sent over the shared socket
+is prefixed with a frame header containing the channel so the receiver can keep the different
+comms objects separate.
+*/
+
+#include "TcpHelperClasses.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+namespace asio {
+class io_context;
+}  // namespace asio
+
+namespace helics {
+class ActionMessage;
+
+namespace tcp {
+    /** marker byte starting a multiplexed frame, the standard packet marker is 0xF3*/
+    constexpr char muxFrameMarker{'\xF5'};
+    /** size of the multiplexed frame header, a marker and a 32 bit channel*/
+    constexpr std::size_t muxHeaderSize{5};
+
+    /** generate a packet for a command wrapped in a multiplexed frame for the given channel
+    @details a channel of 0 generates a standard packet without the frame header*/
+    std::string generateMuxFrame(std::uint32_t channel, const ActionMessage& cmd);
+
+    /** extract the commands from a block of data containing standard packets and multiplexed frames
+    @param data the data to process
+    @param dataSize the number of bytes available
+    @param handler the function to call with the channel(0 for standard packets) and the command
+    @return the number of bytes used*/
+    std::size_t extractMuxFrames(const char* data,
+                                 std::size_t dataSize,
+                                 const std::function<void(std::uint32_t, ActionMessage&&)>& handler);
+
+    /** a tcp connection shared by all the single socket comms in a process targeting the same
+    address*/
+    class TcpMuxConnection {
+      public:
+        /** callback for commands received on a channel*/
+        using ReceiveCallback = std::function<void(ActionMessage&&)>;
+        /** callback for errors on the shared socket*/
+        using ErrorCallback = std::function<void(const std::error_code&)>;
+
+        /** get the shared connection to a specific address, creating it if necessary
+        @return a pointer to the connection or nullptr if the connection could not be made*/
+        static std::shared_ptr<TcpMuxConnection> getConnection(asio::io_context& io_context,
+                                                               const std::string& host,
+                                                               const std::string& port,
+                                                               std::size_t bufferSize,
+                                                               std::chrono::milliseconds timeOut);
+        /** get the number of shared connections currently open in the process*/
+        static std::size_t activeConnectionCount();
+
+        ~TcpMuxConnection();
+        /** add a channel to the connection
+        @return the channel number to use for sending*/
+        std::uint32_t addChannel(ReceiveCallback receive, ErrorCallback error);
+        /** remove a channel, no callbacks for the channel are executed after this returns*/
+        void removeChannel(std::uint32_t channel);
+        /** get the number of channels using the connection*/
+        std::size_t channelCount() const;
+        /** send a command on a channel
+        @throws std::system_error on failure*/
+        void send(std::uint32_t channel, const ActionMessage& cmd);
+        /** get the identifier of the underlying socket*/
+        int getIdentifier() const { return connection->getIdentifier(); }
+
+      private:
+        explicit TcpMuxConnection(TcpConnection::pointer conn);
+        std::size_t dataReceive(const char* data, std::size_t bytesReceived);
+        void errorReceive(const std::error_code& error);
+
+        /** the callbacks of a channel, shared so they can be called without holding channelLock*/
+        struct Channel {
+            Channel(ReceiveCallback rcv, ErrorCallback err):
+                receive(std::move(rcv)), error(std::move(err))
+            {
+            }
+            ReceiveCallback receive;
+            ErrorCallback error;
+            /// held while a callback runs, recursive so a callback can remove its own channel
+            std::recursive_mutex callLock;
+            bool active{true};  //!< cleared under callLock when the channel is removed
+        };
+        /** get the channel state for a channel number or nullptr if it does not exist*/
+        std::shared_ptr<Channel> findChannel(std::uint32_t channel) const;
+        TcpConnection::pointer connection;  //!< the shared socket
+        std::mutex sendLock;  //!< lock serializing the transmit threads of the different channels
+        mutable std::mutex channelLock;  //!< lock protecting the channel map
+        std::map<std::uint32_t, std::shared_ptr<Channel>> channels;
+        std::uint32_t nextChannel{1};
+        std::atomic<bool> failed{false};  //!< set if the shared socket reported an error
+    };
+
+}  // namespace tcp
+}  // namespace helics
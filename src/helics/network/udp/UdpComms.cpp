@@ -26,6 +26,7 @@ namespace udp {
         NetworkCommsInterface(InterfaceTypes::UDP), promisePort(std::promise<int>())
     {
         futurePort = promisePort.get_future();
+        orderedDelivery = false;
     }
 
     int UdpComms::getDefaultBrokerPort() const { return DEFAULT_UDP_BROKER_PORT_NUMBER; }
@@ -298,7 +299,7 @@ namespace udp {
                             broker_endpoint = *resolver.resolve(query);
                             continue;
                         } else if (m.messageID == DELAY_CONNECTION) {
-                            std::this_thread::sleep_for(std::chrono::seconds(2));
+                            std::this_thread::sleep_for(nextConnectionDelay());
                         } else if (m.messageID == DISCONNECT) {
                             if (PortNumber <= 0) {
                                 PortNumber = -1;
@@ -400,6 +401,7 @@ namespace udp {
             if (processed) {
                 continue;
             }
+            compressForRoute(rid, cmd);
 
             if (rid == parent_route_id) {
                 if (hasBroker) {
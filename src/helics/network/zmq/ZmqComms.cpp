@@ -21,6 +21,8 @@ SPDX-License-Identifier: BSD-3-Clause
 #include <csignal>
 #include <map>
 #include <memory>
+#include <optional>
+#include <set>
 #include <utility>
 #include <vector>
 
@@ -66,10 +68,35 @@ namespace zeromq {
                 return (-1);
             }
         }
-        ActionMessage M(static_cast<std::byte*>(msg.data()), msg.size());
+        return processIncomingCommand(
+            ActionMessage(static_cast<std::byte*>(msg.data()), msg.size()));
+    }
+
+    int ZmqComms::processIncomingFrames(zmq::socket_t& socket, zmq::message_t& msg)
+    {
+        while (true) {
+            int status{0};
+            bool more{false};
+            if (hasPayloadFrame(msg)) {
+                zmq::message_t payload;
+                socket.recv(payload);
+                more = payload.more();
+                status = processIncomingCommand(decodeCommandFrames(msg, payload));
+            } else {
+                more = msg.more();
+                status = processIncomingMessage(msg);
+            }
+            if (status < 0 || !more) {
+                return status;
+            }
+            socket.recv(msg);
+        }
+    }
+
+    int ZmqComms::processIncomingCommand(ActionMessage&& M)
+    {
         if (!isValidCommand(M)) {
             logError("invalid command received");
-            ActionMessage Q(static_cast<std::byte*>(msg.data()), msg.size());
             return 0;
         }
         if (isProtocolCommand(M)) {
@@ -207,14 +234,14 @@ namespace zeromq {
                 if (zmq::has_message(poller[0])) {
                     controlSocket.recv(msg);
 
-                    auto status = processIncomingMessage(msg);
+                    auto status = processIncomingFrames(controlSocket, msg);
                     if (status < 0) {
                         break;
                     }
                 }
                 if (zmq::has_message(poller[1])) {
                     pullSocket.recv(msg);
-                    auto status = processIncomingMessage(msg);
+                    auto status = processIncomingFrames(pullSocket, msg);
                     if (status < 0) {
                         break;
                     }
@@ -381,7 +408,7 @@ namespace zeromq {
                                     return (-1);
                                 }
                             } else if (rxcmd.messageID == DELAY_CONNECTION) {
-                                std::this_thread::sleep_for(std::chrono::seconds(2));
+                                std::this_thread::sleep_for(nextConnectionDelay());
                             }
                         }
                     }
@@ -408,7 +435,6 @@ namespace zeromq {
 
     void ZmqComms::queue_tx_function()
     {
-        std::vector<char> buffer;
         if (!brokerTargetAddress.empty()) {
             hasBroker = true;
         }
@@ -444,13 +470,23 @@ namespace zeromq {
             brokerPushSocket.connect(makePortAddress(brokerTargetAddress, brokerPort));
         }
         setTxStatus(connection_status::connected);
-        zmq::message_t msg;
+        std::vector<zmq::message_t> frames;
+        // routes whose receiver reported it can decode payloads in a separate frame
+        std::set<route_id> payloadFrameRoutes;
+        // a command taken from the queue while batching that goes in the next message
+        std::optional<std::pair<route_id, ActionMessage>> held;
         bool continueProcessing{true};
         while (continueProcessing) {
             route_id rid;
             ActionMessage cmd;
 
-            std::tie(rid, cmd) = txQueue.pop();
+            if (held) {
+                std::tie(rid, cmd) = std::move(*held);
+                held.reset();
+            } else {
+                std::tie(rid, cmd) = txQueue.pop();
+            }
+            frames.clear();
             bool processed = false;
             if (isProtocolCommand(cmd)) {
                 if (control_route == rid) {
@@ -487,6 +523,11 @@ namespace zeromq {
                         } break;
                         case REMOVE_ROUTE:
                             routes.erase(route_id{cmd.getExtraData()});
+                            payloadFrameRoutes.erase(route_id{cmd.getExtraData()});
+                            processed = true;
+                            break;
+                        case ENABLE_PAYLOAD_FRAMES:
+                            payloadFrameRoutes.insert(route_id{cmd.getExtraData()});
                             processed = true;
                             break;
                         case DISCONNECT:
@@ -501,23 +542,44 @@ namespace zeromq {
             }
             if (getRouteTypeCode(rid) == json_route_code || useJsonSerialization) {
                 auto str = cmd.to_json_string();
-                buffer.resize(str.size());
-                std::copy(str.begin(), str.end(), buffer.begin());
-
+                frames.emplace_back(str.data(), str.size());
             } else {
-                cmd.to_vector(buffer);
+                // compressed payloads are binary so only used with the binary serialization
+                compressForRoute(rid, cmd);
+                const bool batch =
+                    rid != control_route && static_cast<std::size_t>(cmd.serializedByteCount()) <
+                        batchCommandSize;
+                // the local receiver always decodes payload frames
+                const bool payloadFrame =
+                    rid == control_route || payloadFrameRoutes.count(rid) > 0;
+                appendCommandFrames(cmd, frames, payloadFrame);
+                // small commands waiting for the same route go out in the same multipart message
+                std::size_t commandCount{1};
+                while (batch && commandCount < maxBatchCommands) {
+                    auto next = txQueue.try_pop();
+                    if (!next) {
+                        break;
+                    }
+                    if (next->first != rid || isProtocolCommand(next->second) ||
+                        static_cast<std::size_t>(next->second.serializedByteCount()) >=
+                            batchCommandSize) {
+                        held = std::move(next);
+                        break;
+                    }
+                    compressForRoute(rid, next->second);
+                    appendCommandFrames(next->second, frames, payloadFrame);
+                    ++commandCount;
+                }
             }
             if (rid == parent_route_id) {
                 if (hasBroker) {
-                    brokerPushSocket.send(zmq::const_buffer(buffer.data(), buffer.size()),
-                                          zmq::send_flags::none);
+                    sendFrames(brokerPushSocket, frames);
                 } else {
                     logWarning("no route to broker for message");
                 }
             } else if (rid == control_route) {  // send to rx thread loop
                 try {
-                    controlSocket.send(zmq::const_buffer(buffer.data(), buffer.size()),
-                                       zmq::send_flags::dontwait);
+                    sendFrames(controlSocket, frames, true);
                 }
                 catch (const zmq::error_t& e) {
                     if ((getRxStatus() == connection_status::terminated) ||
@@ -530,10 +592,10 @@ namespace zeromq {
             } else {
                 auto rt_find = routes.find(rid);
                 if (rt_find != routes.end()) {
-                    rt_find->second.send(zmq::const_buffer(buffer.data(), buffer.size()));
+                    sendFrames(rt_find->second, frames);
                 } else {
                     if (hasBroker) {
-                        brokerPushSocket.send(zmq::const_buffer(buffer.data(), buffer.size()));
+                        sendFrames(brokerPushSocket, frames);
                     } else {
                         if (!isDisconnectCommand(cmd)) {
                             logWarning(
@@ -28,6 +28,7 @@ namespace zeromq {
         ~ZmqComms();
         /** load network information into the comms object*/
         virtual void loadNetworkInfo(const NetworkBrokerData& netInfo) override;
+        virtual bool supportsPayloadFrames() const override { return true; }
         /** set the port numbers for the local ports*/
 
       private:
@@ -39,6 +40,12 @@ namespace zeromq {
         /** process an incoming message
     return code for required action 0=NONE, -1 TERMINATE*/
         int processIncomingMessage(zmq::message_t& msg);
+        /** process the frames of an incoming multipart message starting with msg
+    return code for required action 0=NONE, -1 TERMINATE*/
+        int processIncomingFrames(zmq::socket_t& socket, zmq::message_t& msg);
+        /** process a decoded incoming command
+    return code for required action 0=NONE, -1 TERMINATE*/
+        int processIncomingCommand(ActionMessage&& M);
         /** process an incoming message and send and ack in response
     return code for required action 0=NONE, -1 TERMINATE*/
         int replyToIncomingMessage(zmq::message_t& msg, zmq::socket_t& sock);
@@ -6,6 +6,7 @@ SPDX-License-Identifier: BSD-3-Clause
 */
 #include "ZmqCommsCommon.h"
 
+#include "../../core/ActionMessage.hpp"
 #include "../NetworkBrokerData.hpp"
 #include "cppzmq/zmq.hpp"
 
@@ -50,5 +51,68 @@ namespace zeromq {
             std::to_string(std::get<1>(vers)) + '.' + std::to_string(std::get<2>(vers));
     }
 
+    /** the first byte of a serialized command is the endian marker (0 or 1), this bit is added
+    if the payload follows in the next frame.  Receivers that predate payload frames would read the
+    marked byte as an invalid command so it is only sent on routes that reported support for it*/
+    static constexpr unsigned int payloadFrameMarker{0x02};
+
+    static void releasePayload(void* data, void* /*hint*/)
+    {
+        delete[] static_cast<std::byte*>(data);
+    }
+
+    std::size_t appendCommandFrames(ActionMessage& cmd,
+                                    std::vector<zmq::message_t>& frames,
+                                    bool payloadFrame)
+    {
+        // time requests do not serialize the payload
+        const bool separatePayload = payloadFrame && cmd.payload.size() >= separatePayloadSize &&
+            cmd.action() != CMD_TIME_REQUEST && cmd.payload.ownsHeapMemory();
+        std::size_t payloadSize{0};
+        std::byte* payload{nullptr};
+        if (separatePayload) {
+            payloadSize = cmd.payload.size();
+            payload = cmd.payload.release();
+        }
+        auto size = static_cast<std::size_t>(cmd.serializedByteCount());
+        frames.emplace_back(size);
+        auto* data = frames.back().data<std::byte>();
+        cmd.toByteArray(data, size);
+        if (!separatePayload) {
+            return 1;
+        }
+        data[0] |= std::byte{payloadFrameMarker};
+        frames.emplace_back(payload, payloadSize, &releasePayload);
+        return 2;
+    }
+
+    void sendFrames(zmq::socket_t& socket, std::vector<zmq::message_t>& frames, bool dontWait)
+    {
+        const auto flags = dontWait ? zmq::send_flags::dontwait : zmq::send_flags::none;
+        for (std::size_t ii = 0; ii < frames.size(); ++ii) {
+            socket.send(frames[ii],
+                        (ii + 1 < frames.size()) ? (flags | zmq::send_flags::sndmore) : flags);
+        }
+        frames.clear();
+    }
+
+    bool hasPayloadFrame(const zmq::message_t& frame)
+    {
+        if (frame.size() == 0) {
+            return false;
+        }
+        auto marker = std::to_integer<unsigned int>(frame.data<std::byte>()[0]);
+        return (marker & ~1U) == payloadFrameMarker;
+    }
+
+    ActionMessage decodeCommandFrames(zmq::message_t& header, const zmq::message_t& payload)
+    {
+        auto* data = header.data<std::byte>();
+        data[0] &= ~std::byte{payloadFrameMarker};
+        ActionMessage cmd(data, header.size());
+        cmd.payload.assign(payload.data(), payload.size());
+        return cmd;
+    }
+
 }  // namespace zeromq
 }  // namespace helics
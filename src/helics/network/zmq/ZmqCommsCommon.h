@@ -10,16 +10,26 @@ SPDX-License-Identifier: BSD-3-Clause
 @details function in this file are common function used between the different TCP comms */
 
 #include <chrono>
+#include <cstddef>
 #include <string>
+#include <vector>
 class AsioContextManager;
 
 namespace zmq {
+class message_t;
 class socket_t;
-}
+}  // namespace zmq
 
 namespace helics {
+class ActionMessage;
 namespace zeromq {
     static const std::chrono::milliseconds defaultPeriod(200);
+    /// payloads at least this large are handed to ZeroMQ in a separate frame without a copy
+    constexpr std::size_t separatePayloadSize{4096};
+    /// commands smaller than this are grouped with others to the same route in one message
+    constexpr std::size_t batchCommandSize{1024};
+    /// the maximum number of commands grouped in a single multipart message
+    constexpr std::size_t maxBatchCommands{64};
 
     /** bind a zmq socket, with a timeout and timeout period*/
     bool bindzmqSocket(zmq::socket_t& socket,
@@ -29,6 +39,26 @@ namespace zeromq {
                        std::chrono::milliseconds period = defaultPeriod);
     /** get the ZeroMQ version currently in use*/
     std::string getZMQVersion();
+
+    /** add the frames for a command to a multipart message
+    @details the command is serialized directly into the frame, if payloadFrame is true an owned
+    payload of at least separatePayloadSize bytes is released from the command into its own frame
+    and freed by ZeroMQ once sent
+    @param cmd the command to add
+    @param frames the frames of the multipart message
+    @param payloadFrame true if the receiver has reported it can decode a separate payload frame
+    @return the number of frames added*/
+    std::size_t appendCommandFrames(ActionMessage& cmd,
+                                    std::vector<zmq::message_t>& frames,
+                                    bool payloadFrame);
+    /** send the frames as a single multipart message and clear them*/
+    void sendFrames(zmq::socket_t& socket,
+                    std::vector<zmq::message_t>& frames,
+                    bool dontWait = false);
+    /** check if a frame holds a command whose payload is in the next frame*/
+    bool hasPayloadFrame(const zmq::message_t& frame);
+    /** decode a command sent with its payload in a separate frame*/
+    ActionMessage decodeCommandFrames(zmq::message_t& header, const zmq::message_t& payload);
 }  // namespace zeromq
 
 }  // namespace helics
@@ -141,7 +141,7 @@ namespace zeromq {
                     status = 5;
                 } break;
                 case DELAY_CONNECTION:
-                    std::this_thread::sleep_for(std::chrono::seconds(2));
+                    std::this_thread::sleep_for(nextConnectionDelay());
                     status = 5;  // need to reconnect after this
                     break;
                 default:
@@ -378,6 +378,7 @@ namespace zeromq {
                     }
                 }
                 if (!processed) {
+                    compressForRoute(rid, cmd);
                     buffer.clear();
                     cmd.to_vector(buffer);
                     if (rid == parent_route_id) {
@@ -293,6 +293,27 @@ HELICS_EXPORT void helicsFederateRegisterFromPublicationJSON(HelicsFederate fed,
  */
 HELICS_EXPORT void helicsFederatePublishJSON(HelicsFederate fed, const char* json, HelicsError* err);
 
+/**
+ * Start a batch of publications.
+ *
+ * @details Values published after this call are staged in the federate and sent to the core together when
+ * helicsFederateCommitPublishBatch is called or the next time or mode request is made.
+ *
+ * @param fed The value federate object to start the batch on.
+ *
+ * @param[in,out] err The error object to complete if there is an error.
+ */
+HELICS_EXPORT void helicsFederateBeginPublishBatch(HelicsFederate fed, HelicsError* err);
+
+/**
+ * Send all the values published since helicsFederateBeginPublishBatch to the core and end the batch.
+ *
+ * @param fed The value federate object with the batch to commit.
+ *
+ * @param[in,out] err The error object to complete if there is an error.
+ */
+HELICS_EXPORT void helicsFederateCommitPublishBatch(HelicsFederate fed, HelicsError* err);
+
 /**
  * \defgroup publications Publication functions
  * @details Functions for publishing data of various kinds.
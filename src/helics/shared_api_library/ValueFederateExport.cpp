@@ -322,6 +322,34 @@ void helicsFederatePublishJSON(HelicsFederate fed, const char* json, HelicsError
     }
 }
 
+void helicsFederateBeginPublishBatch(HelicsFederate fed, HelicsError* err)
+{
+    auto* fedObj = getValueFed(fed, err);
+    if (fedObj == nullptr) {
+        return;
+    }
+    try {
+        fedObj->beginPublishBatch();
+    }
+    catch (...) {
+        helicsErrorHandler(err);
+    }
+}
+
+void helicsFederateCommitPublishBatch(HelicsFederate fed, HelicsError* err)
+{
+    auto* fedObj = getValueFed(fed, err);
+    if (fedObj == nullptr) {
+        return;
+    }
+    try {
+        fedObj->commitPublishBatch();
+    }
+    catch (...) {
+        helicsErrorHandler(err);
+    }
+}
+
 static constexpr char invalidPubName[] = "the specified publication name is a not a valid publication name";
 static constexpr char invalidPubIndex[] = "the specified publication index is not valid";
 
@@ -1463,7 +1491,12 @@ void helicsInputSetMinimumChange(HelicsInput inp, double tolerance, HelicsError*
     if (inpObj == nullptr) {
         return;
     }
-    inpObj->inputPtr->setMinimumChange(tolerance);
+    try {
+        inpObj->inputPtr->setMinimumChange(tolerance);
+    }
+    catch (...) {
+        helicsErrorHandler(err);
+    }
 }
 
 HelicsBool helicsInputIsUpdated(HelicsInput inp)
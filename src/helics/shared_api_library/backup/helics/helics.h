@@ -160,7 +160,10 @@ typedef enum {
     HELICS_FLAG_EVENT_TRIGGERED = 81,
     /** specify that that federate should capture the profiling data to the local federate logging
        system*/
-    HELICS_FLAG_LOCAL_PROFILING_CAPTURE = 96
+    HELICS_FLAG_LOCAL_PROFILING_CAPTURE = 96,
+    /** specify that the federate should not round its event times onto the federation time
+       quantum*/
+    HELICS_FLAG_IGNORE_TIME_QUANTUM = 97
 } HelicsFederateFlags;
 
 /** enumeration of additional core flags*/
@@ -282,6 +285,9 @@ typedef enum {
     HELICS_PROPERTY_TIME_INPUT_DELAY = 148,
     /** the property controlling output delay for a federate*/
     HELICS_PROPERTY_TIME_OUTPUT_DELAY = 150,
+    /** the property controlling the time quantum of a federate, event times are rounded up to a
+       multiple of the quantum*/
+    HELICS_PROPERTY_TIME_QUANTUM = 152,
     /** integer property controlling the maximum number of iterations in a federate*/
     HELICS_PROPERTY_INT_MAX_ITERATIONS = 259,
     /** integer property controlling the log level in a federate see \ref HelicsLogLevels*/
@@ -291,7 +297,11 @@ typedef enum {
     HELICS_PROPERTY_INT_FILE_LOG_LEVEL = 272,
     /** integer property controlling the log level for file logging in a federate see \ref
        HelicsLogLevels*/
-    HELICS_PROPERTY_INT_CONSOLE_LOG_LEVEL = 274
+    HELICS_PROPERTY_INT_CONSOLE_LOG_LEVEL = 274,
+    /** integer property placing a federate in a federate group; federates on the same core with
+       the same non-zero group deliver values to each other directly, time coordination is not
+       shared*/
+    HELICS_PROPERTY_INT_FEDERATE_GROUP = 276
 } HelicsProperties;
 
 /** result returned for requesting the value of an invalid/unknown property */
@@ -352,7 +362,9 @@ typedef enum {
     /** specify that the priority list should be cleared or question if it is cleared*/
     HELICS_HANDLE_OPTION_CLEAR_PRIORITY_LIST = 512,
     /** specify the required number of connections or get the actual number of connections*/
-    HELICS_HANDLE_OPTION_CONNECTIONS = 522
+    HELICS_HANDLE_OPTION_CONNECTIONS = 522,
+    /** specify the number of messages an endpoint will queue before senders are held*/
+    HELICS_HANDLE_OPTION_RECEIVE_CAPACITY = 530
 } HelicsHandleOptions;
 
 /** enumeration of the predefined filter types*/
@@ -2419,6 +2431,27 @@ HELICS_EXPORT void helicsFederateRegisterFromPublicationJSON(HelicsFederate fed,
  */
 HELICS_EXPORT void helicsFederatePublishJSON(HelicsFederate fed, const char* json, HelicsError* err);
 
+/**
+ * Start a batch of publications.
+ *
+ * @details Values published after this call are staged in the federate and sent to the core together when
+ * helicsFederateCommitPublishBatch is called or the next time or mode request is made.
+ *
+ * @param fed The value federate object to start the batch on.
+ *
+ * @param[in,out] err The error object to complete if there is an error.
+ */
+HELICS_EXPORT void helicsFederateBeginPublishBatch(HelicsFederate fed, HelicsError* err);
+
+/**
+ * Send all the values published since helicsFederateBeginPublishBatch to the core and end the batch.
+ *
+ * @param fed The value federate object with the batch to commit.
+ *
+ * @param[in,out] err The error object to complete if there is an error.
+ */
+HELICS_EXPORT void helicsFederateCommitPublishBatch(HelicsFederate fed, HelicsError* err);
+
 /**
  * \defgroup publications Publication functions
  * @details Functions for publishing data of various kinds.
@@ -61,7 +61,8 @@ typedef enum {
     HELICS_FLAG_STRICT_CONFIG_CHECKING = 75,
     HELICS_FLAG_USE_JSON_SERIALIZATION = 79,
     HELICS_FLAG_EVENT_TRIGGERED = 81,
-    HELICS_FLAG_LOCAL_PROFILING_CAPTURE = 96
+    HELICS_FLAG_LOCAL_PROFILING_CAPTURE = 96,
+    HELICS_FLAG_IGNORE_TIME_QUANTUM = 97
 } HelicsFederateFlags;
 
 typedef enum { HELICS_FLAG_DELAY_INIT_ENTRY = 45, HELICS_FLAG_ENABLE_INIT_ENTRY = 47, HELICS_FLAG_IGNORE = 999 } HelicsCoreFlags;
@@ -121,10 +122,12 @@ typedef enum {
     HELICS_PROPERTY_TIME_RT_TOLERANCE = 145,
     HELICS_PROPERTY_TIME_INPUT_DELAY = 148,
     HELICS_PROPERTY_TIME_OUTPUT_DELAY = 150,
+    HELICS_PROPERTY_TIME_QUANTUM = 152,
     HELICS_PROPERTY_INT_MAX_ITERATIONS = 259,
     HELICS_PROPERTY_INT_LOG_LEVEL = 271,
     HELICS_PROPERTY_INT_FILE_LOG_LEVEL = 272,
-    HELICS_PROPERTY_INT_CONSOLE_LOG_LEVEL = 274
+    HELICS_PROPERTY_INT_CONSOLE_LOG_LEVEL = 274,
+    HELICS_PROPERTY_INT_FEDERATE_GROUP = 276
 } HelicsProperties;
 
 const int HELICS_INVALID_PROPERTY_VALUE = -972;
@@ -155,7 +158,8 @@ typedef enum {
     HELICS_HANDLE_OPTION_MULTI_INPUT_HANDLING_METHOD = 507,
     HELICS_HANDLE_OPTION_INPUT_PRIORITY_LOCATION = 510,
     HELICS_HANDLE_OPTION_CLEAR_PRIORITY_LIST = 512,
-    HELICS_HANDLE_OPTION_CONNECTIONS = 522
+    HELICS_HANDLE_OPTION_CONNECTIONS = 522,
+    HELICS_HANDLE_OPTION_RECEIVE_CAPACITY = 530
 } HelicsHandleOptions;
 
 typedef enum {
@@ -425,6 +429,8 @@ HelicsInput helicsFederateGetSubscription(HelicsFederate fed, const char* key, H
 void helicsFederateClearUpdates(HelicsFederate fed);
 void helicsFederateRegisterFromPublicationJSON(HelicsFederate fed, const char* json, HelicsError* err);
 void helicsFederatePublishJSON(HelicsFederate fed, const char* json, HelicsError* err);
+void helicsFederateBeginPublishBatch(HelicsFederate fed, HelicsError* err);
+void helicsFederateCommitPublishBatch(HelicsFederate fed, HelicsError* err);
 
 HelicsBool helicsPublicationIsValid(HelicsPublication pub);
 void helicsPublicationPublishBytes(HelicsPublication pub, const void* data, int inputDataLength, HelicsError* err);
@@ -2152,6 +2152,70 @@ TEST_F(filter_test, message_clone_test)
     EXPECT_TRUE(sFed->getCurrentMode() == helics::Federate::Modes::FINALIZE);
 }
 
+/** the clones of a payload sent repeatedly on a route are sent as references to a cached copy
+when payload deduplication is enabled*/
+TEST_F(filter_test, message_clone_dedup_test)
+{
+    extraBrokerArgs = "--payload_dedup";
+    extraCoreArgs = "--payload_dedup";
+    auto broker = AddBroker("test", 3);
+    AddFederates<helics::MessageFederate>("test", 1, broker, 1.0, "source");
+    AddFederates<helics::MessageFederate>("test", 1, broker, 1.0, "dest");
+    AddFederates<helics::MessageFederate>("test", 1, broker, 1.0, "dest_clone");
+
+    auto sFed = GetFederateAs<helics::MessageFederate>(0);
+    auto dFed = GetFederateAs<helics::MessageFederate>(1);
+    auto dcFed = GetFederateAs<helics::MessageFederate>(2);
+
+    auto& p1 = sFed->registerGlobalEndpoint("src");
+    auto& p2 = dFed->registerGlobalEndpoint("dest");
+    auto& p3 = dcFed->registerGlobalEndpoint("cm");
+
+    helics::CloningFilter cFilt(dcFed.get());
+    cFilt.addSourceTarget("src");
+    cFilt.addDeliveryEndpoint("cm");
+
+    sFed->enterExecutingModeAsync();
+    dcFed->enterExecutingModeAsync();
+    dFed->enterExecutingMode();
+    sFed->enterExecutingModeComplete();
+    dcFed->enterExecutingModeComplete();
+
+    std::string data(800, 'a');
+    for (std::size_t ii = 0; ii < data.size(); ++ii) {
+        data[ii] = static_cast<char>('a' + ii % 23);
+    }
+    std::string data2(data.rbegin(), data.rend());
+    const std::vector<std::string> sent{data, data, data2, data};
+    for (const auto& payload : sent) {
+        p1.sendTo(payload, "dest");
+    }
+
+    sFed->requestTimeAsync(1.0);
+    dcFed->requestTimeAsync(1.0);
+    dFed->requestTime(1.0);
+    sFed->requestTimeComplete();
+    dcFed->requestTimeComplete();
+
+    ASSERT_EQ(dFed->pendingMessageCount(p2), sent.size());
+    ASSERT_EQ(dcFed->pendingMessageCount(p3), sent.size());
+    for (const auto& payload : sent) {
+        auto m = dFed->getMessage(p2);
+        ASSERT_TRUE(m);
+        EXPECT_EQ(m->data.to_string(), payload);
+        auto mc = dcFed->getMessage(p3);
+        ASSERT_TRUE(mc);
+        EXPECT_EQ(mc->original_dest, "dest");
+        EXPECT_EQ(mc->data.to_string(), payload);
+    }
+
+    sFed->finalizeAsync();
+    dFed->finalizeAsync();
+    dcFed->finalize();
+    sFed->finalizeComplete();
+    dFed->finalizeComplete();
+}
+
 TEST_F(filter_test, message_multi_clone_test)
 {
     auto broker = AddBroker("test", 4);
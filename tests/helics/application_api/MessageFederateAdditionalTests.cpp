@@ -9,6 +9,7 @@ SPDX-License-Identifier: BSD-3-Clause
 #include "helics/application_api/Endpoints.hpp"
 #include "helics/application_api/Filters.hpp"
 #include "helics/application_api/MessageFederate.hpp"
+#include "helics/common/JsonProcessingFunctions.hpp"
 #include "helics/core/core-exceptions.hpp"
 #include "helics/core/flagOperations.hpp"
 #include "testFixtures.hpp"
@@ -901,3 +902,81 @@ TEST_F(mfed_tests, missing_endpoint)
     mm.unlock();
     mFed1->finalize();
 }
+
+TEST_F(mfed_tests, receive_capacity)
+{
+    using ::testing::HasSubstr;
+    extraCoreArgs = "--credittimeout=500ms";
+    SetupTest<helics::MessageFederate>("test", 2, 1.0);
+    auto mFed1 = GetFederateAs<helics::MessageFederate>(0);
+    auto mFed2 = GetFederateAs<helics::MessageFederate>(1);
+
+    auto& ep1 = mFed1->registerGlobalEndpoint("ep1");
+    auto& ep2 = mFed2->registerGlobalEndpoint("ep2");
+    ep2.setOption(HELICS_HANDLE_OPTION_RECEIVE_CAPACITY, 2);
+    EXPECT_EQ(ep2.getOption(HELICS_HANDLE_OPTION_RECEIVE_CAPACITY), 2);
+
+    gmlc::libguarded::guarded<std::vector<std::pair<int, std::string>>> mlog;
+    mFed1->setLoggingCallback(
+        [&mlog](int level, std::string_view /*unused*/, std::string_view message) {
+            mlog.lock()->emplace_back(level, message);
+        });
+
+    mFed1->enterExecutingModeAsync();
+    mFed2->enterExecutingMode();
+    mFed1->enterExecutingModeComplete();
+
+    // the first message advertises the capacity of ep2 to mFed1
+    ep1.sendTo("a", "ep2");
+    mFed1->requestTimeAsync(1.0);
+    EXPECT_EQ(mFed2->requestTime(1.0), 1.0);
+    mFed1->requestTimeComplete();
+    EXPECT_EQ(mFed2->pendingMessageCount(ep2), 1U);
+
+    auto res = helics::fileops::loadJsonStr(mFed2->query("queues"));
+    ASSERT_TRUE(res["endpoints"].isArray());
+    ASSERT_EQ(res["endpoints"].size(), 1U);
+    EXPECT_EQ(res["endpoints"][0]["name"].asString(), "ep2");
+    EXPECT_EQ(res["endpoints"][0]["capacity"].asInt(), 2);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    ep1.sendTo("b", "ep2");
+    ep1.sendTo("c", "ep2");
+    // ep2 will not take any more messages until mFed2 receives them at its next grant
+    auto blockedSend = std::async(std::launch::async, [&]() { ep1.sendTo("d", "ep2"); });
+    EXPECT_EQ(blockedSend.wait_for(std::chrono::milliseconds(100)), std::future_status::timeout);
+    // the sender times out and sends anyway
+    blockedSend.get();
+
+    auto mm = mlog.lock();
+    ASSERT_FALSE(mm->empty());
+    EXPECT_EQ(mm->back().first, HELICS_LOG_LEVEL_WARNING);
+    EXPECT_THAT(mm->back().second, HasSubstr("ep2"));
+    auto warningCount = mm->size();
+    mm.unlock();
+
+    // the window is overdrawn so further sends do not wait again
+    auto overdrawnSend = std::async(std::launch::async, [&]() { ep1.sendTo("e", "ep2"); });
+    EXPECT_EQ(overdrawnSend.wait_for(std::chrono::milliseconds(300)), std::future_status::ready);
+    overdrawnSend.get();
+    EXPECT_EQ(mlog.lock()->size(), warningCount);
+
+    // the grant receives the messages and returns the credits
+    mFed1->requestTimeAsync(2.0);
+    EXPECT_EQ(mFed2->requestTime(2.0), 2.0);
+    mFed1->requestTimeComplete();
+    EXPECT_EQ(mFed2->pendingMessageCount(ep2), 5U);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    // messages for a later time hold their credits until they are received
+    ep1.sendToAt("f", "ep2", 3.0);
+    ep1.sendToAt("g", "ep2", 3.0);
+    EXPECT_EQ(mlog.lock()->size(), warningCount);
+    blockedSend = std::async(std::launch::async, [&]() { ep1.sendToAt("h", "ep2", 3.0); });
+    EXPECT_EQ(blockedSend.wait_for(std::chrono::milliseconds(100)), std::future_status::timeout);
+    blockedSend.get();
+    EXPECT_EQ(mlog.lock()->size(), warningCount + 1);
+
+    mFed1->finalize();
+    mFed2->finalize();
+}
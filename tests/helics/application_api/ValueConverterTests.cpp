@@ -129,6 +129,17 @@ TEST(valueConverter_tests, vector_string)
     EXPECT_TRUE(val3 == test2);
 }
 
+TEST(valueConverter_tests, raw_double)
+{
+    std::byte raw[helics::detail::rawDoubleSize];
+    helics::detail::convertToRawBinary(raw, -45.125);
+    // the double converter reads both the raw and the coded forms
+    helics::data_view dv(reinterpret_cast<const char*>(raw), sizeof(raw));
+    EXPECT_EQ(helics::ValueConverter<double>::interpret(dv), -45.125);
+    auto coded = helics::ValueConverter<double>::convert(-45.125);
+    EXPECT_EQ(helics::ValueConverter<double>::interpret(coded), -45.125);
+}
+
 /** check that the converters do actually throw on invalid sizes*/
 TEST(valueConverter_tests, errors)
 {
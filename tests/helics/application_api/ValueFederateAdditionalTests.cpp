@@ -11,7 +11,9 @@ SPDX-License-Identifier: BSD-3-Clause
 #include "helics/application_api/Subscriptions.hpp"
 #include "helics/application_api/ValueFederate.hpp"
 #include "helics/core/BrokerFactory.hpp"
+#include "helics/core/Core.hpp"
 #include "helics/core/CoreFactory.hpp"
+#include "helics/core/core-exceptions.hpp"
 #include "testFixtures.hpp"
 
 #include <future>
@@ -1233,3 +1235,161 @@ TEST(valuefederate, duplicate_targets)
 
     Fed1->finalize();
 }
+
+TEST(valuefederate, publish_batch)
+{
+    helics::FederateInfo fi(helics::CoreType::TEST);
+    fi.coreName = "core_batch";
+    fi.coreInitString = "-f 1 --autobroker";
+
+    auto Fed1 = std::make_shared<helics::ValueFederate>("vfed1", fi);
+    auto& p1 = Fed1->registerGlobalPublication<int64_t>("pub1");
+    auto& p2 = Fed1->registerGlobalPublication<std::string>("pub2");
+
+    auto& s1 = Fed1->registerSubscription("pub1");
+    auto& s2 = Fed1->registerSubscription("pub2");
+    auto& s3 = Fed1->registerSubscription("pub2");
+    Fed1->enterExecutingMode();
+
+    Fed1->beginPublishBatch();
+    p1.publish(8);
+    p2.publish("batch1");
+    Fed1->commitPublishBatch();
+    Fed1->requestNextStep();
+
+    EXPECT_EQ(s1.getValue<int64_t>(), 8);
+    EXPECT_EQ(s2.getValue<std::string>(), "batch1");
+    EXPECT_EQ(s3.getValue<std::string>(), "batch1");
+
+    // an open batch is sent with the next time request
+    Fed1->beginPublishBatch();
+    p1.publish(11);
+    p2.publish("batch2");
+    Fed1->requestNextStep();
+    EXPECT_EQ(s1.getValue<int64_t>(), 11);
+    EXPECT_EQ(s2.getValue<std::string>(), "batch2");
+
+    // publications after the time request are sent directly
+    p1.publish(15);
+    Fed1->requestNextStep();
+    EXPECT_EQ(s1.getValue<int64_t>(), 15);
+
+    Fed1->finalize();
+}
+
+TEST(valuefederate, publish_batch_finalize)
+{
+    helics::FederateInfo fi(helics::CoreType::TEST);
+    fi.coreName = "core_batch_finalize";
+    fi.coreInitString = "-f 3 --autobroker";
+
+    auto Fed1 = std::make_shared<helics::ValueFederate>("vfed1", fi);
+    auto Fed2 = std::make_shared<helics::ValueFederate>("vfed2", fi);
+    auto Fed3 = std::make_shared<helics::ValueFederate>("vfed3", fi);
+    auto& p1 = Fed1->registerGlobalPublication<int64_t>("pub1");
+    auto& p2 = Fed2->registerGlobalPublication<int64_t>("pub2");
+
+    auto& s1 = Fed3->registerSubscription("pub1");
+    auto& s2 = Fed3->registerSubscription("pub2");
+    Fed1->enterExecutingModeAsync();
+    Fed2->enterExecutingModeAsync();
+    Fed3->enterExecutingMode();
+    Fed1->enterExecutingModeComplete();
+    Fed2->enterExecutingModeComplete();
+
+    // an open batch is sent when the federate finalizes
+    Fed1->beginPublishBatch();
+    p1.publish(8);
+    Fed1->finalize();
+
+    Fed2->beginPublishBatch();
+    p2.publish(12);
+    Fed2->finalizeAsync();
+
+    Fed3->requestTime(1.0);
+    EXPECT_EQ(s1.getValue<int64_t>(), 8);
+    EXPECT_EQ(s2.getValue<int64_t>(), 12);
+
+    Fed2->finalizeComplete();
+    Fed3->finalize();
+}
+
+TEST(valuefederate, publish_batch_other_federate)
+{
+    helics::FederateInfo fi(helics::CoreType::TEST);
+    fi.coreName = "core_batch_owner";
+    fi.coreInitString = "-f 2 --autobroker";
+
+    auto Fed1 = std::make_shared<helics::ValueFederate>("vfed1", fi);
+    auto Fed2 = std::make_shared<helics::ValueFederate>("vfed2", fi);
+    auto& p1 = Fed1->registerGlobalPublication<int64_t>("pub1");
+    auto& p2 = Fed2->registerGlobalPublication<int64_t>("pub2");
+    auto& s1 = Fed2->registerSubscription("pub1");
+    Fed1->enterExecutingModeAsync();
+    Fed2->enterExecutingMode();
+    Fed1->enterExecutingModeComplete();
+
+    // a batch may only contain publications of the federate publishing it
+    const auto& core = Fed2->getCorePointer();
+    std::vector<std::pair<helics::InterfaceHandle, helics::SmallBuffer>> values;
+    values.emplace_back(p2.getHandle(), helics::SmallBuffer("2"));
+    values.emplace_back(p1.getHandle(), helics::SmallBuffer("1"));
+    EXPECT_THROW(core->setValues(Fed2->getID(), values), helics::InvalidIdentifier);
+
+    // nothing from the rejected batch was published
+    Fed1->requestTimeAsync(1.0);
+    Fed2->requestTime(1.0);
+    Fed1->requestTimeComplete();
+    EXPECT_FALSE(s1.isUpdated());
+
+    Fed1->finalize();
+    Fed2->finalize();
+}
+
+TEST(valuefederate, typed_double)
+{
+    helics::FederateInfo fi(helics::CoreType::TEST);
+    fi.coreName = "core_typed_double";
+    fi.coreInitString = "-f 1 --autobroker";
+
+    auto Fed1 = std::make_shared<helics::ValueFederate>("vfed1", fi);
+    helics::PublicationT<double> p1(helics::InterfaceVisibility::GLOBAL, Fed1.get(), "pub1");
+    auto& p2 = Fed1->registerGlobalPublication<int64_t>("pub2");
+
+    helics::InputT<double> in1(Fed1.get(), "in1");
+    in1.addTarget("pub1");
+    helics::InputT<double> in2(Fed1.get(), "in2");
+    in2.addTarget("pub2");
+    // a general input has not accepted the raw encoding so pub3 sends the coded form
+    helics::PublicationT<double> p3(helics::InterfaceVisibility::GLOBAL, Fed1.get(), "pub3");
+    helics::InputT<double> in3(Fed1.get(), "in3");
+    in3.addTarget("pub3");
+    auto& s1 = Fed1->registerSubscription("pub3");
+    Fed1->enterExecutingMode();
+    EXPECT_EQ(p1.getOption(helics::detail::rawDoubleEncodingOption), 1);
+    EXPECT_EQ(p3.getOption(helics::detail::rawDoubleEncodingOption), 0);
+
+    p1.publish(27.5);
+    p2.publish(12);
+    p3.publish(3.25);
+    Fed1->requestNextStep();
+
+    EXPECT_DOUBLE_EQ(in1.getValue(), 27.5);
+    EXPECT_TRUE(in1.directExtraction());
+    EXPECT_EQ(Fed1->getBytes(in1).size(), helics::detail::rawDoubleSize);
+
+    EXPECT_DOUBLE_EQ(in3.getValue(), 3.25);
+    EXPECT_NE(Fed1->getBytes(in3).size(), helics::detail::rawDoubleSize);
+    EXPECT_DOUBLE_EQ(s1.getValue<double>(), 3.25);
+    EXPECT_EQ(s1.getValue<int64_t>(), 3);
+
+    // an integer publication goes through the general conversion
+    EXPECT_DOUBLE_EQ(in2.getValue(), 12.0);
+    EXPECT_FALSE(in2.directExtraction());
+
+    // the last value is kept when there is no update
+    Fed1->requestNextStep();
+    EXPECT_DOUBLE_EQ(in1.getValue(), 27.5);
+
+    Fed1->finalize();
+}
@@ -10,7 +10,10 @@ SPDX-License-Identifier: BSD-3-Clause
 #include "helics/application_api/CoreApp.hpp"
 #include "helics/application_api/Subscriptions.hpp"
 #include "helics/application_api/ValueFederate.hpp"
+#include "helics/application_api/queryFunctions.hpp"
+#include "helics/common/JsonProcessingFunctions.hpp"
 #include "helics/core/Core.hpp"
+#include "helics/core/core-exceptions.hpp"
 #include "helics/core/helics_definitions.hpp"
 #include "helics/helics_enums.h"
 
@@ -24,6 +27,8 @@ SPDX-License-Identifier: BSD-3-Clause
 #endif
 #include <fstream>
 #include <streambuf>
+#include <string>
+#include <vector>
 
 /** these test cases test out the value federates
  */
@@ -223,6 +228,53 @@ TEST_P(valuefed_all_type_tests, dual_transfer)
     EXPECT_TRUE(res);
 }
 
+TEST_F(valuefed_tests, federate_group_direct_delivery)
+{
+    SetupTest<helics::ValueFederate>("test", 3);
+    auto vFed1 = GetFederateAs<helics::ValueFederate>(0);
+    auto vFed2 = GetFederateAs<helics::ValueFederate>(1);
+    auto vFed3 = GetFederateAs<helics::ValueFederate>(2);
+
+    vFed1->setProperty(helics::defs::Properties::FEDERATE_GROUP, 5);
+    vFed2->setProperty(helics::defs::Properties::FEDERATE_GROUP, 5);
+    auto& pubid = vFed1->registerGlobalPublication<double>("pub1");
+    auto& sub2 = vFed2->registerSubscription("pub1");
+    // the third federate is outside the group so its value goes through the core
+    auto& sub3 = vFed3->registerSubscription("pub1");
+
+    auto f1 = std::async(std::launch::async, [&]() { vFed1->enterExecutingMode(); });
+    auto f3 = std::async(std::launch::async, [&]() { vFed3->enterExecutingMode(); });
+    vFed2->enterExecutingMode();
+    f1.get();
+    f3.get();
+
+    pubid.publish(2.5);
+    f1 = std::async(std::launch::async, [&]() { vFed1->requestTime(1.0); });
+    f3 = std::async(std::launch::async, [&]() { vFed3->requestTime(1.0); });
+    vFed2->requestTime(1.0);
+    f1.get();
+    f3.get();
+    EXPECT_DOUBLE_EQ(sub2.getValue<double>(), 2.5);
+    EXPECT_DOUBLE_EQ(sub3.getValue<double>(), 2.5);
+
+    auto groups = helics::fileops::loadJsonStr(vFed1->query("core", "federate_groups"));
+    // only the delivery to the group member is direct
+    EXPECT_EQ(groups["direct_deliveries"].asUInt64(), 1U);
+    ASSERT_EQ(groups["federates"].size(), 3U);
+    for (const auto& fed : groups["federates"]) {
+        const auto name = fed["name"].asString();
+        if (name == vFed3->getName()) {
+            EXPECT_EQ(fed["group"].asInt(), 0);
+        } else {
+            EXPECT_EQ(fed["group"].asInt(), 5);
+        }
+    }
+
+    vFed1->finalize();
+    vFed2->finalize();
+    vFed3->finalize();
+}
+
 TEST_P(valuefed_all_type_tests, dual_transfer_json)
 {
     SetupTest<helics::ValueFederate>(GetParam(), 2);
@@ -315,6 +367,23 @@ TEST_F(valuefed_tests, dual_transfer_brokerApp_link)
     EXPECT_TRUE(res);
 }
 
+TEST_F(valuefed_tests, dual_transfer_federate_group)
+{
+    SetupTest<helics::ValueFederate>("test", 2);
+    auto vFed1 = GetFederateAs<helics::ValueFederate>(0);
+    auto vFed2 = GetFederateAs<helics::ValueFederate>(1);
+
+    vFed1->setProperty(helics::defs::Properties::FEDERATE_GROUP, 3);
+    vFed2->setProperty(helics::defs::Properties::FEDERATE_GROUP, 3);
+    EXPECT_EQ(vFed2->getIntegerProperty(helics::defs::Properties::FEDERATE_GROUP), 3);
+    // register the publications
+    auto& pubid = vFed1->registerGlobalPublication<std::string>("pub1");
+
+    auto& subid = vFed2->registerSubscription("pub1");
+    bool res = dual_transfer_test(vFed1, vFed2, pubid, subid);
+    EXPECT_TRUE(res);
+}
+
 #ifdef HELICS_ENABLE_ZMQ_CORE
 static constexpr const char* config_files[] = {"bes_config.json",
                                                "bes_config.toml",
@@ -1106,3 +1175,84 @@ TEST_F(valuefed_tests, empty_get_complex)
 
     vFed1->finalize();
 }
+
+TEST_F(valuefed_tests, history_read_at_time)
+{
+    SetupTest<helics::ValueFederate>("test", 1);
+    auto vFed1 = GetFederateAs<helics::ValueFederate>(0);
+
+    auto& pub = vFed1->registerGlobalPublication<double>("pub1");
+    auto& ipt = vFed1->registerInput<double>("ipt1");
+    ipt.addTarget("pub1");
+    ipt.setHistory(5);
+    vFed1->enterExecutingMode();
+    for (int ii = 1; ii <= 10; ++ii) {
+        vFed1->requestTime(ii);
+        pub.publish(static_cast<double>(ii));
+    }
+    vFed1->requestTime(11.0);
+    EXPECT_EQ(ipt.getValue<double>(), 10.0);
+    EXPECT_EQ(ipt.getValueAt<double>(10.0), 10.0);
+    EXPECT_EQ(ipt.getValueAt<double>(7.5), 7.0);
+    EXPECT_EQ(ipt.getValueAt<double>(6.0), 6.0);
+    // only the last 5 values are retained
+    EXPECT_EQ(ipt.getValueAt<double>(5.0), helics::invalidDouble);
+    EXPECT_TRUE(ipt.getBytesAt(3.0).empty());
+
+    ipt.setHistory(0, 2.0);
+    pub.publish(11.0);
+    vFed1->requestTime(12.0);
+    EXPECT_EQ(ipt.getValueAt<double>(9.0), 9.0);
+    EXPECT_EQ(ipt.getValueAt<double>(8.5), helics::invalidDouble);
+
+    vFed1->finalize();
+}
+
+TEST_F(valuefed_tests, parallel_registration)
+{
+    SetupTest<helics::ValueFederate>("test", 4);
+    std::vector<std::shared_ptr<helics::ValueFederate>> feds;
+    for (int ii = 0; ii < 4; ++ii) {
+        feds.push_back(GetFederateAs<helics::ValueFederate>(ii));
+    }
+    std::vector<std::thread> threads;
+    for (int ii = 0; ii < 4; ++ii) {
+        threads.emplace_back([&feds, ii]() {
+            for (int jj = 0; jj < 200; ++jj) {
+                feds[ii]->registerGlobalPublication<double>("pub" + std::to_string(ii) + "_" +
+                                                            std::to_string(jj));
+            }
+        });
+    }
+    for (auto& thrd : threads) {
+        thrd.join();
+    }
+    // names are still checked across federates while the registrations are staged
+    EXPECT_THROW(feds[1]->registerGlobalPublication<double>("pub0_5"),
+                 helics::RegistrationFailure);
+
+    auto& ipt = feds[0]->registerInput<double>("ipt");
+    ipt.addTarget("pub3_199");
+    for (int ii = 1; ii < 4; ++ii) {
+        feds[ii]->enterExecutingModeAsync();
+    }
+    feds[0]->enterExecutingMode();
+    for (int ii = 1; ii < 4; ++ii) {
+        feds[ii]->enterExecutingModeComplete();
+    }
+    auto pubs = helics::vectorizeQueryResult(feds[0]->query("core", "publications"));
+    EXPECT_EQ(pubs.size(), 800U);
+
+    feds[3]->getPublication("pub3_199").publish(3.5);
+    for (int ii = 1; ii < 4; ++ii) {
+        feds[ii]->requestTimeAsync(1.0);
+    }
+    feds[0]->requestTime(1.0);
+    for (int ii = 1; ii < 4; ++ii) {
+        feds[ii]->requestTimeComplete();
+    }
+    EXPECT_EQ(ipt.getValue<double>(), 3.5);
+    for (auto& fed : feds) {
+        fed->finalize();
+    }
+}
@@ -64,3 +64,50 @@ TEST(error_generation, egen2)
     EXPECT_EQ(V["error"]["code"].asInt(), code);
     EXPECT_EQ(V["error"]["message"].asString(), message);
 }
+
+TEST(binary_json, round_trip)
+{
+    Json::Value base;
+    base["name"] = "core1";
+    base["id"] = 131072;
+    base["parent"] = -1;
+    base["next_time"] = 1.25;
+    base["active"] = true;
+    base["missing"] = Json::Value();
+    base["large"] = Json::UInt64(0xFFFF'FFFF'FFFF'FFFFULL);
+    base["federates"] = Json::arrayValue;
+    for (int ii = 0; ii < 40; ++ii) {
+        Json::Value fed;
+        fed["id"] = ii * 1000;
+        fed["name"] = std::string("fed") + std::to_string(ii);
+        base["federates"].append(fed);
+    }
+    base["empty"] = Json::objectValue;
+
+    auto bin = generateBinaryJson(base);
+    EXPECT_TRUE(isBinaryJson(bin));
+    EXPECT_LT(bin.size(), generateJsonString(base).size());
+
+    Json::Value result;
+    EXPECT_NO_THROW(result = loadBinaryJson(bin));
+    EXPECT_EQ(generateJsonString(result), generateJsonString(base));
+    // loadJsonStr should transparently detect the binary form
+    EXPECT_NO_THROW(result = loadJsonStr(bin));
+    EXPECT_EQ(result["federates"].size(), 40U);
+    EXPECT_EQ(result["parent"].asInt(), -1);
+    EXPECT_EQ(result["large"].asUInt64(), 0xFFFF'FFFF'FFFF'FFFFULL);
+}
+
+TEST(binary_json, invalid)
+{
+    Json::Value base;
+    base["name"] = "core1";
+    base["values"] = Json::arrayValue;
+    base["values"].append(4.5);
+    auto bin = generateBinaryJson(base);
+
+    EXPECT_FALSE(isBinaryJson(generateJsonString(base)));
+    EXPECT_THROW(loadBinaryJson(bin.substr(0, bin.size() - 2)), std::invalid_argument);
+    EXPECT_THROW(loadBinaryJson(bin + "a"), std::invalid_argument);
+    EXPECT_THROW(loadBinaryJson("{\"name\":\"core1\"}"), std::invalid_argument);
+}
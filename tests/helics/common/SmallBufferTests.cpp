@@ -496,3 +496,23 @@ TEST(small_buffer_tests, release)
     EXPECT_EQ(buffer[13], std::byte{'r'});
     delete[] buffer;
 }
+
+TEST(small_buffer_tests, heap_accounting)
+{
+    const auto initial = SmallBuffer::allocatedHeapBytes();
+    {
+        SmallBuffer sb1(std::string(5000, 'a'));
+        EXPECT_GE(SmallBuffer::allocatedHeapBytes() - initial, 5000);
+        SmallBuffer sb2(std::move(sb1));
+        EXPECT_GE(SmallBuffer::allocatedHeapBytes() - initial, 5000);
+        EXPECT_LT(SmallBuffer::allocatedHeapBytes() - initial, 10000);
+        sb2.reserve(20000);
+        EXPECT_GE(SmallBuffer::allocatedHeapBytes() - initial, 20000);
+    }
+    EXPECT_EQ(SmallBuffer::allocatedHeapBytes(), initial);
+
+    SmallBuffer sb3(std::string(3000, 'b'));
+    auto* buffer = sb3.release();
+    EXPECT_EQ(SmallBuffer::allocatedHeapBytes(), initial);
+    delete[] buffer;
+}
@@ -5,11 +5,17 @@ Energy, LLC.  See the top-level NOTICE for additional details. All rights reserv
 SPDX-License-Identifier: BSD-3-Clause
 */
 #include "helics/core/ActionMessage.hpp"
+#include "helics/core/MessageTrace.hpp"
+#include "helics/core/PayloadCompression.hpp"
+#include "helics/core/PayloadDedup.hpp"
 #include "helics/core/flagOperations.hpp"
 
 #include "gtest/gtest.h"
 #include <cstdio>
+#include <random>
 #include <set>
+#include <string>
+#include <vector>
 
 using namespace helics;
 
@@ -539,3 +545,257 @@ TEST(ActionMessage, jsonconversion_test_binary_strings)
     EXPECT_EQ(cmd.flags, cmd2.flags);
     EXPECT_TRUE(cmd.getStringData() == cmd2.getStringData());
 }
+
+TEST(ActionMessage, packed_multi_message)
+{
+    helics::ActionMessage multi(helics::CMD_MULTI_MESSAGE);
+    helics::ActionMessage cmd(helics::CMD_PUB);
+    cmd.source_id = GlobalFederateId{1};
+    cmd.source_handle = InterfaceHandle{2};
+    cmd.dest_id = GlobalFederateId{3};
+    cmd.dest_handle = InterfaceHandle{4};
+    cmd.actionTime = 45.7;
+    cmd.payload = "test payload";
+    cmd.setStringData("target", "source");
+
+    helics::ActionMessage treq(helics::CMD_TIME_REQUEST);
+    treq.source_id = GlobalFederateId{5};
+    treq.actionTime = 2.0;
+    treq.Te = 3.0;
+    treq.Tdemin = 4.0;
+
+    EXPECT_EQ(appendPackedMessage(multi, cmd), 1);
+    EXPECT_EQ(appendPackedMessage(multi, treq), 2);
+    EXPECT_EQ(appendPackedMessage(multi, cmd), 3);
+    EXPECT_TRUE(checkActionFlag(multi, packed_messages_flag));
+    // a packed container can't be mixed with string form messages
+    EXPECT_EQ(appendMessage(multi, cmd), -1);
+    helics::ActionMessage stringForm(helics::CMD_MULTI_MESSAGE);
+    appendMessage(stringForm, cmd);
+    EXPECT_EQ(appendPackedMessage(stringForm, cmd), -1);
+
+    // check the serialized form survives the trip
+    helics::ActionMessage multi2(multi.to_string());
+    std::size_t offset{0};
+    helics::ActionMessage res;
+    ASSERT_TRUE(extractPackedMessage(multi2, offset, res));
+    EXPECT_EQ(res.action(), helics::CMD_PUB);
+    EXPECT_EQ(res.actionTime, cmd.actionTime);
+    EXPECT_EQ(res.source_id, cmd.source_id);
+    EXPECT_EQ(res.dest_handle, cmd.dest_handle);
+    EXPECT_EQ(res.payload, cmd.payload);
+    EXPECT_TRUE(res.getStringData() == cmd.getStringData());
+    ASSERT_TRUE(extractPackedMessage(multi2, offset, res));
+    EXPECT_EQ(res.action(), helics::CMD_TIME_REQUEST);
+    EXPECT_EQ(res.Te, treq.Te);
+    EXPECT_EQ(res.Tdemin, treq.Tdemin);
+    ASSERT_TRUE(extractPackedMessage(multi2, offset, res));
+    EXPECT_EQ(res.action(), helics::CMD_PUB);
+    EXPECT_FALSE(extractPackedMessage(multi2, offset, res));
+}
+
+TEST(ActionMessage, compact_endpoint_names)
+{
+    const std::string dest(60, 'd');
+    const std::string source(60, 's');
+    helics::ActionMessage cmd(helics::CMD_SEND_MESSAGE);
+    cmd.payload = "message";
+    cmd.setStringData(dest, source, source);
+    auto fullSize = cmd.to_string().size();
+    EXPECT_TRUE(compactEndpointNames(cmd));
+    EXPECT_TRUE(cmd.getString(targetStringLoc).empty());
+    EXPECT_LE(cmd.to_string().size() + dest.size() + source.size(), fullSize);
+    helics::ActionMessage cmd2(cmd.to_string());
+    restoreEndpointNames(cmd2, dest);
+    EXPECT_EQ(cmd2.getStringData(), std::vector<std::string>({dest, source, source}));
+
+    // layouts from sendMessage
+    cmd.setStringData(dest, source, "", "");
+    EXPECT_TRUE(compactEndpointNames(cmd));
+    restoreEndpointNames(cmd, dest);
+    EXPECT_EQ(cmd.getStringData(), std::vector<std::string>({dest, source, "", ""}));
+
+    cmd.setStringData(dest, source, source, dest);
+    EXPECT_TRUE(compactEndpointNames(cmd));
+    restoreEndpointNames(cmd, dest);
+    EXPECT_EQ(cmd.getStringData(), std::vector<std::string>({dest, source, source, dest}));
+
+    // messages that have been rerouted keep all their names
+    cmd.setStringData(dest, source, "original", "other");
+    EXPECT_FALSE(compactEndpointNames(cmd));
+    restoreEndpointNames(cmd, "ignored");
+    EXPECT_EQ(cmd.getStringData(),
+              std::vector<std::string>({dest, source, "original", "other"}));
+}
+
+TEST(ActionMessage, message_trace_round_trip)
+{
+    const std::string traceFile{"action_message_test.trace"};
+    helics::ActionMessage reg(helics::CMD_REG_FED);
+    reg.name("fed1");
+    helics::ActionMessage treq(helics::CMD_TIME_REQUEST);
+    treq.source_id = helics::GlobalFederateId(131072);
+    treq.actionTime = 45.7;
+    {
+        helics::MessageTraceWriter writer;
+        writer.open(traceFile);
+        writer.record(reg);
+        writer.record(treq);
+        EXPECT_EQ(writer.recordCount(), 2U);
+    }
+    auto records = helics::loadMessageTrace(traceFile);
+    std::remove(traceFile.c_str());
+    ASSERT_EQ(records.size(), 2U);
+    EXPECT_EQ(records[0].command.action(), helics::CMD_REG_FED);
+    EXPECT_EQ(records[0].command.name(), "fed1");
+    EXPECT_EQ(records[1].command.action(), helics::CMD_TIME_REQUEST);
+    EXPECT_EQ(records[1].command.source_id, treq.source_id);
+    EXPECT_EQ(records[1].command.actionTime, treq.actionTime);
+    EXPECT_LE(records[0].processed, records[1].processed);
+}
+
+TEST(ActionMessage, payload_dedup_round_trip)
+{
+    helics::PayloadDedupEncoder encoder;
+    helics::PayloadDedupDecoder decoder;
+    const helics::GlobalBrokerId source{5};
+    const helics::route_id rid{7};
+
+    helics::ActionMessage msg(helics::CMD_SEND_MESSAGE);
+    msg.payload = std::string(1000, 'a');
+    msg.setString(0, "dest1");
+    msg.setString(1, "source");
+    helics::ActionMessage clone(msg);
+    clone.setString(0, "dest2");
+
+    helics::ActionMessage wrapper;
+    helics::ActionMessage restored;
+    ASSERT_TRUE(encoder.encode(source, rid, msg, wrapper));
+    EXPECT_EQ(wrapper.action(), helics::CMD_DEDUPLICATED_MESSAGE);
+    EXPECT_GT(wrapper.payload.size(), msg.payload.size());
+    ASSERT_TRUE(decoder.decode(wrapper, restored));
+    EXPECT_EQ(restored.to_string(), msg.to_string());
+
+    // the second copy on the route only carries a reference
+    ASSERT_TRUE(encoder.encode(source, rid, clone, wrapper));
+    EXPECT_LT(wrapper.payload.size(), 200U);
+    EXPECT_EQ(encoder.referenceCount(), 1U);
+    EXPECT_EQ(encoder.bytesSaved(), 1000U);
+    ASSERT_TRUE(decoder.decode(wrapper, restored));
+    EXPECT_EQ(restored.to_string(), clone.to_string());
+
+    // a different route has its own cache
+    ASSERT_TRUE(encoder.encode(source, helics::route_id{8}, clone, wrapper));
+    EXPECT_GT(wrapper.payload.size(), clone.payload.size());
+
+    // a reference the receiver has never seen cannot be resolved
+    helics::PayloadDedupDecoder emptyDecoder;
+    ASSERT_TRUE(encoder.encode(source, rid, clone, wrapper));
+    EXPECT_FALSE(emptyDecoder.decode(wrapper, restored));
+
+    // small payloads are not worth deduplicating
+    helics::ActionMessage small(helics::CMD_SEND_MESSAGE);
+    small.payload = "short";
+    EXPECT_FALSE(encoder.encode(source, rid, small, wrapper));
+
+    // the cache for a source is dropped once it disconnects
+    EXPECT_EQ(decoder.cachedPayloadCount(), 1U);
+    decoder.removeSource(helics::GlobalBrokerId{6});
+    EXPECT_EQ(decoder.cachedPayloadCount(), 1U);
+    decoder.removeSource(source);
+    EXPECT_EQ(decoder.cachedPayloadCount(), 0U);
+}
+
+TEST(ActionMessage, compress_block_round_trip)
+{
+    std::mt19937 gen(4532);
+    std::uniform_int_distribution<int> dist(0, 3);
+    for (std::size_t size : {0U, 1U, 12U, 13U, 100U, 4000U, 70000U}) {
+        std::vector<std::byte> source(size);
+        // small alphabet so there are plenty of matches of different lengths
+        for (auto& val : source) {
+            val = static_cast<std::byte>('a' + dist(gen));
+        }
+        std::vector<std::byte> compressed(helics::compressedSizeBound(size));
+        auto csize = helics::compressBlock(source.data(), size, compressed.data());
+        EXPECT_LE(csize, compressed.size());
+        std::vector<std::byte> restored(size);
+        ASSERT_TRUE(helics::decompressBlock(compressed.data(), csize, restored.data(), size))
+            << "size " << size;
+        EXPECT_TRUE(restored == source) << "size " << size;
+    }
+}
+
+TEST(ActionMessage, payload_compression_round_trip)
+{
+    helics::PayloadCompressor compressor;
+    helics::ActionMessage msg(helics::CMD_PUB);
+    std::string data;
+    while (data.size() < 4000) {
+        data.append("voltage=1.02;current=35.7;phase=A;");
+    }
+    msg.payload = data;
+    msg.setString(0, "pub1");
+
+    helics::ActionMessage wrapper;
+    helics::ActionMessage restored;
+    ASSERT_TRUE(compressor.compress(msg, wrapper));
+    EXPECT_EQ(wrapper.action(), helics::CMD_COMPRESSED_MESSAGE);
+    EXPECT_LT(wrapper.payload.size(), msg.payload.size() / 4);
+    ASSERT_TRUE(helics::decompressMessage(wrapper, restored));
+    EXPECT_EQ(restored.to_string(), msg.to_string());
+    EXPECT_EQ(compressor.statistics().compressed, 1U);
+    EXPECT_GT(compressor.statistics().bytesIn, compressor.statistics().bytesOut);
+
+    // a damaged message is detected
+    auto truncated = wrapper;
+    truncated.payload.resize(truncated.payload.size() - 3);
+    EXPECT_FALSE(helics::decompressMessage(truncated, restored));
+
+    // a restored size the compressed data could not produce is rejected before allocating
+    auto oversized = wrapper;
+    oversized.payload[0] = std::byte{0xFF};
+    EXPECT_FALSE(helics::decompressMessage(oversized, restored));
+
+    // small payloads and protocol messages are left alone
+    helics::ActionMessage small(helics::CMD_PUB);
+    small.payload = "short";
+    EXPECT_FALSE(compressor.compress(small, wrapper));
+    helics::ActionMessage protocol(helics::CMD_PROTOCOL);
+    protocol.payload = data;
+    EXPECT_FALSE(compressor.compress(protocol, wrapper));
+}
+
+TEST(ActionMessage, payload_compression_backoff)
+{
+    helics::PayloadCompressor compressor;
+    std::mt19937 gen(1823);
+    std::uniform_int_distribution<int> dist(0, 255);
+    std::string noise(2048, '\0');
+    for (auto& val : noise) {
+        val = static_cast<char>(dist(gen));
+    }
+    helics::ActionMessage msg(helics::CMD_SEND_MESSAGE);
+    msg.payload = noise;
+    helics::ActionMessage wrapper;
+
+    // random data is rejected and each rejection doubles the number of messages skipped
+    EXPECT_FALSE(compressor.compress(msg, wrapper));
+    EXPECT_EQ(compressor.statistics().rejected, 1U);
+    EXPECT_FALSE(compressor.compress(msg, wrapper));
+    EXPECT_EQ(compressor.statistics().skipped, 1U);
+    EXPECT_FALSE(compressor.compress(msg, wrapper));
+    EXPECT_EQ(compressor.statistics().rejected, 2U);
+    EXPECT_FALSE(compressor.compress(msg, wrapper));
+    EXPECT_FALSE(compressor.compress(msg, wrapper));
+    EXPECT_EQ(compressor.statistics().skipped, 3U);
+    EXPECT_EQ(compressor.statistics().compressed, 0U);
+
+    // compressible data resets the backoff
+    msg.payload = std::string(2048, 'z');
+    EXPECT_TRUE(compressor.compress(msg, wrapper));
+    msg.payload = noise;
+    EXPECT_FALSE(compressor.compress(msg, wrapper));
+    EXPECT_EQ(compressor.statistics().rejected, 3U);
+    EXPECT_EQ(compressor.statistics().skipped, 3U);
+}
@@ -4,6 +4,8 @@ Battelle Memorial Institute; Lawrence Livermore National Security, LLC; Alliance
 Energy, LLC.  See the top-level NOTICE for additional details. All rights reserved.
 SPDX-License-Identifier: BSD-3-Clause
 */
+#include "helics/core/ActionMessage.hpp"
+#include "helics/core/BrokerBase.hpp"
 #include "helics/core/BrokerFactory.hpp"
 #include "helics/core/CoreBroker.hpp"
 #include "helics/core/CoreFactory.hpp"
@@ -12,6 +14,8 @@ SPDX-License-Identifier: BSD-3-Clause
 
 #include "gtest/gtest.h"
 #include <future>
+#include <mutex>
+#include <vector>
 
 /** test the assignment and retrieval of global value from a broker object*/
 TEST(broker_tests, global_value_test)
@@ -108,3 +112,57 @@ TEST(broker_tests, broker_log_command_failures)
                                                "--fileloglevel=-4 --root"),
                  std::exception);
 }
+
+/** minimal broker that records the commands reaching it from the processing loop*/
+class RecordingBroker: public helics::BrokerBase {
+  public:
+    RecordingBroker(): BrokerBase(std::string("recorder")) { disable_timer = true; }
+    ~RecordingBroker() override { joinAllThreads(); }
+
+    std::vector<helics::action_message_def::action_t> received() const
+    {
+        std::lock_guard<std::mutex> lock(receivedLock);
+        return actions;
+    }
+
+  protected:
+    void processDisconnect(bool /*skipUnregister*/) override {}
+    bool tryReconnect() override { return false; }
+    void processCommand(helics::ActionMessage&& cmd) override { record(cmd); }
+    void processPriorityCommand(helics::ActionMessage&& cmd) override { record(cmd); }
+    std::string generateLocalAddressString() const override { return identifier; }
+
+  private:
+    void record(const helics::ActionMessage& cmd)
+    {
+        std::lock_guard<std::mutex> lock(receivedLock);
+        actions.push_back(cmd.action());
+    }
+    mutable std::mutex receivedLock;
+    std::vector<helics::action_message_def::action_t> actions;
+};
+
+/** a ping bundled between two data messages must not cause the message after it to be lost*/
+TEST(broker_tests, packed_ping_between_messages)
+{
+    RecordingBroker brk;
+    brk.configureBase();
+
+    helics::ActionMessage multi(helics::CMD_MULTI_MESSAGE);
+    helics::ActionMessage val(helics::CMD_PUB);
+    val.payload = "first";
+    EXPECT_EQ(appendPackedMessage(multi, val), 1);
+    EXPECT_EQ(appendPackedMessage(multi, helics::ActionMessage(helics::CMD_PING)), 2);
+    val.payload = "second";
+    EXPECT_EQ(appendPackedMessage(multi, val), 3);
+
+    brk.addActionMessage(std::move(multi));
+    brk.addActionMessage(helics::ActionMessage(helics::CMD_STOP));
+    brk.joinAllThreads();
+
+    std::vector<helics::action_message_def::action_t> expected{helics::CMD_PUB,
+                                                               helics::CMD_PING,
+                                                               helics::CMD_PUB,
+                                                               helics::CMD_STOP};
+    EXPECT_EQ(brk.received(), expected);
+}
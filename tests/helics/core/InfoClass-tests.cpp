@@ -5,6 +5,7 @@ Energy, LLC.  See the top-level NOTICE for additional details. All rights reserv
 SPDX-License-Identifier: BSD-3-Clause
 */
 #include "helics/core/BasicHandleInfo.hpp"
+#include "helics/core/DenseRoutingTable.hpp"
 #include "helics/core/EndpointInfo.hpp"
 #include "helics/core/FilterInfo.hpp"
 #include "helics/core/InputInfo.hpp"
@@ -238,6 +239,55 @@ TEST(InfoClass_tests, endpointinfo_test)
     EXPECT_TRUE(endPI.getMessage(maxT) == nullptr);
 }
 
+TEST(InfoClass_tests, endpoint_message_index_test)
+{
+    helics::MessageHeadIndex index;
+    helics::EndpointInfo ep1({helics::GlobalFederateId(5), helics::InterfaceHandle(1)},
+                             "ep1",
+                             "type",
+                             &index);
+    helics::EndpointInfo ep2({helics::GlobalFederateId(5), helics::InterfaceHandle(2)},
+                             "ep2",
+                             "type",
+                             &index);
+    auto makeMessage = [](double time) {
+        auto msg = std::make_unique<helics::Message>();
+        msg->time = helics::Time(time);
+        return msg;
+    };
+    helics::Time first;
+    EXPECT_EQ(index.first(first), nullptr);
+    EXPECT_EQ(first, helics::Time::maxVal());
+
+    ep1.addMessage(makeMessage(3.0));
+    ep2.addMessage(makeMessage(2.0));
+    ep2.addMessage(makeMessage(4.0));
+    EXPECT_EQ(index.first(first), &ep2);
+    EXPECT_EQ(first, helics::Time(2.0));
+    // messages are not available until the time is updated
+    EXPECT_EQ(index.available(), 0);
+    ep1.updateTimeInclusive(3.0);
+    ep2.updateTimeInclusive(3.0);
+    EXPECT_EQ(index.available(), 2);
+
+    EXPECT_TRUE(ep2.getMessage(3.0));
+    EXPECT_EQ(index.available(), 1);
+    EXPECT_EQ(index.first(first), &ep1);
+    EXPECT_EQ(first, helics::Time(3.0));
+    // equal times are ordered by handle
+    ep2.addMessage(makeMessage(3.0));
+    EXPECT_EQ(index.first(first), &ep1);
+
+    EXPECT_TRUE(ep1.getMessage(3.0));
+    EXPECT_EQ(index.first(first), &ep2);
+    EXPECT_EQ(index.firstTime(), helics::Time(3.0));
+
+    ep2.clearQueue();
+    EXPECT_EQ(index.first(first), nullptr);
+    EXPECT_EQ(index.firstTime(), helics::Time::maxVal());
+    EXPECT_EQ(index.available(), 0);
+}
+
 TEST(InfoClass_tests, filterinfo_test)
 {
     // Mostly testing ordering of message sorting and maxTime function arguments
@@ -332,3 +382,84 @@ TEST(InfoClass_tests, inputinfo_test)
     ret_data = subI.getData(0);
     EXPECT_EQ(ret_data->to_string(), "time one");
 }
+
+TEST(InfoClass_tests, inputinfo_history_test)
+{
+    helics::InputInfo subI(helics::GlobalHandle(helics::GlobalFederateId(5),
+                                                helics::InterfaceHandle(13)),
+                           "key",
+                           "type",
+                           "units");
+    helics::GlobalHandle src1(helics::GlobalFederateId(5), helics::InterfaceHandle(45));
+    helics::GlobalHandle src2(helics::GlobalFederateId(6), helics::InterfaceHandle(46));
+    subI.addSource(src1, "", "string", std::string());
+    subI.addSource(src2, "", "string", std::string());
+    EXPECT_FALSE(subI.getDataAt(5.0, nullptr));
+
+    subI.setHistoryRetention(3, helics::timeZero);
+    for (int ii = 1; ii <= 5; ++ii) {
+        subI.addData(src1, ii, 0, std::make_shared<helics::SmallBuffer>(std::to_string(ii)));
+    }
+    subI.addData(src2, 2.5, 0, std::make_shared<helics::SmallBuffer>("src2"));
+    // all values up to time 5 are consumed in a single update
+    subI.updateTimeInclusive(5.0);
+    EXPECT_EQ(subI.getData(0)->to_string(), "5");
+
+    uint32_t index{10};
+    EXPECT_EQ(subI.getDataAt(4.0, &index)->to_string(), "4");
+    EXPECT_EQ(index, 0U);
+    EXPECT_EQ(subI.getDataAt(3.5, &index)->to_string(), "3");
+    EXPECT_EQ(subI.getDataAt(2.7, &index)->to_string(), "src2");
+    EXPECT_EQ(index, 1U);
+    // values 1 and 2 of the first source were dropped
+    EXPECT_FALSE(subI.getDataAt(2.0, &index));
+
+    // the retained values share the buffer with the current value
+    EXPECT_EQ(subI.getDataAt(5.0, nullptr).get(), subI.getData(0).get());
+
+    subI.setHistoryRetention(0, 1.5);
+    subI.addData(src1, 6, 0, std::make_shared<helics::SmallBuffer>("6"));
+    subI.updateTimeInclusive(6.0);
+    EXPECT_EQ(subI.getDataAt(4.5, nullptr)->to_string(), "4");
+    // the first source no longer has a value at 3.5 so the second source is used
+    EXPECT_EQ(subI.getDataAt(3.5, &index)->to_string(), "src2");
+    EXPECT_EQ(index, 1U);
+
+    subI.setHistoryRetention(0, helics::timeZero);
+    EXPECT_FALSE(subI.getDataAt(6.0, nullptr));
+}
+
+TEST(InfoClass_tests, dense_routing_table_test)
+{
+    helics::DenseRoutingTable table;
+    EXPECT_TRUE(table.empty());
+    const helics::GlobalFederateId fed1(helics::gGlobalFederateIdShift + 5);
+    const helics::GlobalFederateId brk1(helics::gGlobalBrokerIdShift + 2);
+    const helics::GlobalFederateId other(helics::gGlobalFederateIdShift - 10);
+
+    EXPECT_EQ(table.getRoute(fed1, helics::parent_route_id), helics::parent_route_id);
+    EXPECT_TRUE(table.emplace(fed1, helics::route_id(3)));
+    EXPECT_FALSE(table.emplace(fed1, helics::route_id(4)));
+    EXPECT_TRUE(table.emplace(brk1, helics::route_id(7)));
+    EXPECT_TRUE(table.emplace(other, helics::route_id(9)));
+    EXPECT_EQ(table.size(), 3U);
+
+    EXPECT_EQ(table.getRoute(fed1, helics::parent_route_id), helics::route_id(3));
+    EXPECT_EQ(table.getRoute(brk1, helics::parent_route_id), helics::route_id(7));
+    EXPECT_EQ(table.getRoute(other, helics::parent_route_id), helics::route_id(9));
+    // an id below the end of the dense array which was never added
+    EXPECT_EQ(table.getRoute(helics::GlobalFederateId(helics::gGlobalFederateIdShift + 1),
+                             helics::parent_route_id),
+              helics::parent_route_id);
+
+    table.setRoute(fed1, helics::route_id(4));
+    EXPECT_EQ(table.getRoute(fed1, helics::parent_route_id), helics::route_id(4));
+    EXPECT_EQ(table.size(), 3U);
+
+    table.erase(brk1);
+    EXPECT_FALSE(table.contains(brk1));
+    EXPECT_EQ(table.size(), 2U);
+    table.clear();
+    EXPECT_TRUE(table.empty());
+    EXPECT_FALSE(table.contains(fed1));
+}
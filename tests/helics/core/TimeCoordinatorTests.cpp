@@ -6,6 +6,7 @@ SPDX-License-Identifier: BSD-3-Clause
 */
 #include "helics/core/ActionMessage.hpp"
 #include "helics/core/TimeCoordinator.hpp"
+#include "helics/core/helics_definitions.hpp"
 
 #include "gtest/gtest.h"
 
@@ -139,6 +140,50 @@ TEST(timeCoord_tests, dependent_test_message)
     EXPECT_TRUE(deps[0] == fed3);
 }
 
+TEST(timeCoord_tests, time_quantum)
+{
+    EXPECT_EQ(quantizeTime(1.3, 0.5), Time(1.5));
+    EXPECT_EQ(quantizeTime(1.5, 0.5), Time(1.5));
+    EXPECT_EQ(quantizeTime(1.3, timeZero), Time(1.3));
+    EXPECT_EQ(quantizeTime(Time::maxVal(), 0.5), Time::maxVal());
+
+    TimeCoordinator ftc;
+    ftc.setProperty(defs::Properties::TIME_QUANTUM, Time(0.5));
+    EXPECT_EQ(ftc.getTimeProperty(defs::Properties::TIME_QUANTUM), Time(0.5));
+    ftc.enteringExecMode(IterationRequest::NO_ITERATIONS);
+    EXPECT_EQ(ftc.checkExecEntry(), MessageProcessingResult::NEXT_STEP);
+
+    ftc.timeRequest(1.3, IterationRequest::NO_ITERATIONS, Time::maxVal(), Time::maxVal());
+    EXPECT_EQ(ftc.checkTimeGrant(), MessageProcessingResult::NEXT_STEP);
+    EXPECT_EQ(ftc.getGrantedTime(), Time(1.5));
+
+    // a federate can opt out of the quantum
+    ftc.setOptionFlag(defs::Flags::IGNORE_TIME_QUANTUM, true);
+    EXPECT_TRUE(ftc.getOptionFlag(defs::Flags::IGNORE_TIME_QUANTUM));
+    ftc.timeRequest(2.3, IterationRequest::NO_ITERATIONS, Time::maxVal(), Time::maxVal());
+    EXPECT_EQ(ftc.checkTimeGrant(), MessageProcessingResult::NEXT_STEP);
+    EXPECT_EQ(ftc.getGrantedTime(), Time(2.3));
+}
+
+TEST(timeCoord_tests, time_quantum_period)
+{
+    TimeCoordinator ftc;
+    ftc.setProperty(defs::Properties::TIME_QUANTUM, Time(0.5));
+    ftc.setProperty(defs::Properties::PERIOD, Time(0.75));
+    ftc.enteringExecMode(IterationRequest::NO_ITERATIONS);
+    EXPECT_EQ(ftc.checkExecEntry(), MessageProcessingResult::NEXT_STEP);
+
+    // 0.2 is moved to 0.75 by the period and 1.0 by the quantum, then up to the period grid
+    ftc.timeRequest(0.2, IterationRequest::NO_ITERATIONS, Time::maxVal(), Time::maxVal());
+    EXPECT_EQ(ftc.checkTimeGrant(), MessageProcessingResult::NEXT_STEP);
+    EXPECT_EQ(ftc.getGrantedTime(), Time(1.5));
+
+    // times that are on both grids are not moved
+    ftc.timeRequest(3.0, IterationRequest::NO_ITERATIONS, Time::maxVal(), Time::maxVal());
+    EXPECT_EQ(ftc.checkTimeGrant(), MessageProcessingResult::NEXT_STEP);
+    EXPECT_EQ(ftc.getGrantedTime(), Time(3.0));
+}
+
 class TimeCoordinatorTester1: public ::testing::Test, helics::TimeCoordinator {
   public:
     void setup1()
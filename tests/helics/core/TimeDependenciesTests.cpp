@@ -6,8 +6,13 @@ SPDX-License-Identifier: BSD-3-Clause
 */
 #include "helics/core/ActionMessage.hpp"
 #include "helics/core/TimeDependencies.hpp"
+// the array layout is kept with the benchmarks that compare it with TimeDependencies
+#include "TimeDependencyArrays.hpp"
 
 #include "gtest/gtest.h"
+#include <algorithm>
+#include <random>
+#include <vector>
 
 using namespace helics;
 
@@ -40,3 +45,98 @@ TEST(timeDep_tests, dependency_tests)
     auto total = generateMinTimeTotal(depTest, false, GlobalFederateId{1}, GlobalFederateId{});
     EXPECT_EQ(total.next, 2.0);
 }
+
+static bool sameTimeData(const TimeData& td1, const TimeData& td2)
+{
+    return td1.next == td2.next && td1.Te == td2.Te && td1.minDe == td2.minDe &&
+        td1.TeAlt == td2.TeAlt && td1.minFed == td2.minFed &&
+        td1.minFedActual == td2.minFedActual && td1.time_state == td2.time_state;
+}
+
+TEST(timeDep_tests, dependency_arrays)
+{
+    const Time times[] = {-1.0, timeZero, 1.0, 2.0, Time::maxVal()};
+    const time_state_t states[] = {time_state_t::initialized,
+                                   time_state_t::exec_requested,
+                                   time_state_t::time_granted,
+                                   time_state_t::time_requested_iterative,
+                                   time_state_t::time_requested};
+    std::mt19937 gen(31);
+    for (int trial = 0; trial < 500; ++trial) {
+        std::vector<DependencyInfo> deps(gen() % 12);
+        GlobalFederateId::BaseType id{131072};
+        for (auto& dep : deps) {
+            id += 1 + static_cast<GlobalFederateId::BaseType>(gen() % 3);
+            if (gen() % 6 == 0) {
+                id = (std::max)(id, 1879048192);
+            }
+            dep.fedID = GlobalFederateId{id};
+            dep.next = times[gen() % 5];
+            dep.Te = times[gen() % 5];
+            dep.minDe = times[gen() % 5];
+            dep.time_state = states[gen() % 5];
+            dep.connection = static_cast<ConnectionType>(gen() % 5);
+            dep.dependency = (gen() % 5 != 0);
+            dep.nonGranting = (gen() % 3 == 0);
+            dep.minFed = (gen() % 2 == 0) ? GlobalFederateId{id - 1} : GlobalFederateId{};
+            dep.minFedActual = (gen() % 3 == 0) ? GlobalFederateId{7} : GlobalFederateId{id};
+        }
+        TimeDependencies depTest;
+        depTest.setDependencyVector(deps);
+        TimeDependencyArrays depArrays(depTest);
+        ASSERT_EQ(depArrays.size(), deps.size());
+
+        for (auto grant : times) {
+            EXPECT_EQ(depArrays.checkIfReadyForTimeGrant(false, grant),
+                      depTest.checkIfReadyForTimeGrant(false, grant));
+            EXPECT_EQ(depArrays.checkIfReadyForTimeGrant(true, grant),
+                      depTest.checkIfReadyForTimeGrant(true, grant));
+        }
+        const GlobalFederateId ignore =
+            deps.empty() ? GlobalFederateId{} : deps[gen() % deps.size()].fedID;
+        for (auto self : {GlobalFederateId{}, GlobalFederateId{7}}) {
+            for (bool restricted : {false, true}) {
+                EXPECT_TRUE(sameTimeData(depArrays.generateMinTimeTotal(restricted, self, ignore),
+                                         generateMinTimeTotal(depTest, restricted, self, ignore)));
+                EXPECT_TRUE(
+                    sameTimeData(depArrays.generateMinTimeUpstream(restricted, self, ignore),
+                                 generateMinTimeUpstream(depTest, restricted, self, ignore)));
+                EXPECT_TRUE(
+                    sameTimeData(depArrays.generateMinTimeDownstream(restricted, self, ignore),
+                                 generateMinTimeDownstream(depTest, restricted, self, ignore)));
+            }
+        }
+    }
+}
+
+TEST(timeDep_tests, dependency_arrays_update)
+{
+    TimeDependencies depTest;
+    depTest.addDependency(GlobalFederateId{131073});
+    depTest.addDependency(GlobalFederateId{131074});
+    depTest.addDependent(GlobalFederateId{131075});
+    TimeDependencyArrays depArrays(depTest);
+
+    ActionMessage req(CMD_TIME_REQUEST);
+    req.source_id = GlobalFederateId{131074};
+    req.actionTime = 2.0;
+    req.Te = 3.0;
+    req.Tdemin = 2.5;
+    EXPECT_TRUE(depArrays.updateTime(req));
+    EXPECT_TRUE(depTest.updateTime(req));
+    auto info = depArrays.getDependencyInfo(GlobalFederateId{131074});
+    EXPECT_EQ(info.next, 2.0);
+    EXPECT_EQ(info.Te, 3.0);
+    EXPECT_EQ(info.minDe, 2.5);
+    EXPECT_EQ(info.time_state, time_state_t::time_requested);
+    EXPECT_TRUE(info.dependency);
+
+    // dependents that are not dependencies are not updated
+    req.source_id = GlobalFederateId{131075};
+    EXPECT_FALSE(depArrays.updateTime(req));
+
+    EXPECT_EQ(depArrays.checkIfReadyForTimeGrant(false, 1.0),
+              depTest.checkIfReadyForTimeGrant(false, 1.0));
+    EXPECT_TRUE(sameTimeData(depArrays.generateMinTimeTotal(false, GlobalFederateId{}),
+                             generateMinTimeTotal(depTest, false, GlobalFederateId{})));
+}
@@ -4,6 +4,7 @@ Battelle Memorial Institute; Lawrence Livermore National Security, LLC; Alliance
 Energy, LLC.  See the top-level NOTICE for additional details. All rights reserved.
 SPDX-License-Identifier: BSD-3-Clause
 */
+#include "helics/common/JsonProcessingFunctions.hpp"
 #include "helics/core/BrokerFactory.hpp"
 #include "helics/core/Core.hpp"
 #include "helics/core/CoreFactory.hpp"
@@ -13,6 +14,8 @@ SPDX-License-Identifier: BSD-3-Clause
 #include "helics/core/inproc/InprocCore.h"
 
 #include "gtest/gtest.h"
+#include <thread>
+#include <vector>
 
 using helics::Core;
 using namespace helics::CoreFactory;
@@ -42,6 +45,44 @@ TEST(InprocCore_tests, initialization_test)
     broker = nullptr;
 }
 
+/** cores connecting at the same time each get a unique id*/
+TEST(InprocCore_tests, simultaneous_connections)
+{
+    auto broker = helics::BrokerFactory::create(helics::core_type::INPROC, std::string{});
+    ASSERT_TRUE(broker);
+    const std::string configureString = " --broker=" + broker->getIdentifier();
+    constexpr int coreCount{40};
+    constexpr int threadCount{8};
+    std::vector<std::shared_ptr<Core>> cores(coreCount);
+    for (auto& core : cores) {
+        core = create(helics::core_type::INPROC, configureString);
+        ASSERT_TRUE(core);
+    }
+    std::vector<std::thread> threads;
+    for (int tt = 0; tt < threadCount; ++tt) {
+        threads.emplace_back([&cores, tt]() {
+            for (int ii = tt; ii < coreCount; ii += threadCount) {
+                cores[ii]->connect();
+            }
+        });
+    }
+    for (auto& thrd : threads) {
+        thrd.join();
+    }
+    for (auto& core : cores) {
+        EXPECT_TRUE(core->isConnected());
+    }
+    auto val = helics::fileops::loadJsonStr(broker->query("broker", "counts"));
+    EXPECT_EQ(val["brokers"].asInt(), coreCount);
+    for (auto& core : cores) {
+        core->disconnect();
+    }
+    broker->disconnect();
+    cores.clear();
+    broker = nullptr;
+    helics::CoreFactory::cleanUpCores();
+}
+
 TEST(InprocCore_tests, initialization_test_with_test_broker)
 {
     auto broker = helics::BrokerFactory::create(helics::core_type::TEST, std::string{});
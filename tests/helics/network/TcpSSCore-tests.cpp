@@ -6,6 +6,7 @@ SPDX-License-Identifier: BSD-3-Clause
 */
 #include "helics/common/AsioContextManager.h"
 #include "helics/common/GuardedTypes.hpp"
+#include "helics/common/JsonProcessingFunctions.hpp"
 #include "helics/core/ActionMessage.hpp"
 #include "helics/core/BrokerFactory.hpp"
 #include "helics/core/Core.hpp"
@@ -16,6 +17,7 @@ SPDX-License-Identifier: BSD-3-Clause
 #include "helics/network/tcp/TcpCommsSS.h"
 #include "helics/network/tcp/TcpCore.h"
 #include "helics/network/tcp/TcpHelperClasses.h"
+#include "helics/network/tcp/TcpMuxConnection.h"
 
 #include "gtest/gtest.h"
 #include <future>
@@ -447,6 +449,35 @@ TEST(TcpSSCore, tcpSSCore_core_broker_default)
     helics::BrokerFactory::cleanUpBrokers(100ms);
 }
 
+/** test that multiplexed cores share a single connection to the broker*/
+TEST(TcpSSCore, tcpSSCore_multiplexed)
+{
+    std::this_thread::sleep_for(std::chrono::milliseconds(400));
+    auto broker = helics::BrokerFactory::create(helics::CoreType::TCP_SS, "-f 3");
+    ASSERT_TRUE(broker);
+    std::vector<std::shared_ptr<Core>> cores;
+    for (int ii = 0; ii < 3; ++ii) {
+        auto core = helics::CoreFactory::create(helics::CoreType::TCP_SS,
+                                                "-f 1 --multiplex --name=mcore" +
+                                                    std::to_string(ii));
+        ASSERT_TRUE(core);
+        EXPECT_TRUE(core->connect());
+        cores.push_back(std::move(core));
+    }
+    EXPECT_EQ(helics::tcp::TcpMuxConnection::activeConnectionCount(), 1U);
+    auto val = helics::fileops::loadJsonStr(broker->query("broker", "counts"));
+    EXPECT_EQ(val["brokers"].asInt(), 3);
+    for (auto& core : cores) {
+        core->disconnect();
+    }
+    broker->disconnect();
+    cores.clear();
+    broker = nullptr;
+    helics::CoreFactory::cleanUpCores(100ms);
+    helics::BrokerFactory::cleanUpBrokers(100ms);
+    EXPECT_EQ(helics::tcp::TcpMuxConnection::activeConnectionCount(), 0U);
+}
+
 TEST(TcpSSCore, commFactory)
 {
     auto comm = helics::CommFactory::create("tcpss");
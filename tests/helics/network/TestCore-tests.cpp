@@ -88,6 +88,13 @@ TEST(TestCore_tests, testcore_pubsub_value_test)
     ASSERT_EQ(valueUpdates.size(), 1u);
     EXPECT_EQ(valueUpdates[0], sub1);
 
+    const auto& snapshot = core->getValueSnapshot(id);
+    ASSERT_EQ(snapshot.size(), 1u);
+    EXPECT_EQ(snapshot[0].handle, sub1);
+    ASSERT_TRUE(snapshot[0].data);
+    EXPECT_EQ(snapshot[0].data->to_string(), str1);
+    EXPECT_TRUE(snapshot[0].allData.empty());
+
     data = core->getValue(sub1);
     std::string str2(data->to_string());
     EXPECT_EQ(str1, str2);
@@ -103,9 +110,13 @@ TEST(TestCore_tests, testcore_pubsub_value_test)
     EXPECT_EQ(data->to_string(), std::string("hello\n\0helloAgain", 17));
     EXPECT_EQ(data->size(), 17u);
 
+    ASSERT_EQ(core->getValueSnapshot(id).size(), 1u);
+    EXPECT_EQ(core->getValueSnapshot(id)[0].data, data);
+
     core->timeRequest(id, 200.0);
     valueUpdates = core->getValueUpdates(id);
     EXPECT_TRUE(valueUpdates.empty());
+    EXPECT_TRUE(core->getValueSnapshot(id).empty());
     core->finalize(id);
     core->disconnect();
     core = nullptr;
@@ -0,0 +1,102 @@
+/*
+Copyright (c) 2017-2021,
+Battelle Memorial Institute; Lawrence Livermore National Security, LLC; Alliance for Sustainable
+Energy, LLC.  See the top-level NOTICE for additional details. All rights reserved.
+SPDX-License-Identifier: BSD-3-Clause
+*/
+#include "helics/network/TransmitQueue.hpp"
+
+#include "gtest/gtest.h"
+#include <chrono>
+#include <string>
+#include <vector>
+
+using namespace helics;
+
+static ActionMessage generateMessage(action_message_def::action_t action,
+                                     int id,
+                                     std::size_t payloadSize = 0)
+{
+    ActionMessage cmd(action);
+    cmd.messageID = id;
+    if (payloadSize > 0) {
+        cmd.payload = std::string(payloadSize, 'a');
+    }
+    return cmd;
+}
+
+TEST(TransmitQueue, classification)
+{
+    route_id rid{5};
+    EXPECT_EQ(TransmitQueue::classify(control_route, generateMessage(CMD_PROTOCOL, 0)),
+              TrafficClass::CONTROL);
+    EXPECT_EQ(TransmitQueue::classify(rid, generateMessage(CMD_TIME_REQUEST, 0)),
+              TrafficClass::TIMING);
+    EXPECT_EQ(TransmitQueue::classify(rid, generateMessage(CMD_PUB, 0, 10)), TrafficClass::DATA);
+    EXPECT_EQ(TransmitQueue::classify(rid,
+                                      generateMessage(CMD_SEND_MESSAGE,
+                                                      0,
+                                                      TransmitQueue::bulkMessageSize)),
+              TrafficClass::BULK);
+}
+
+TEST(TransmitQueue, ordering)
+{
+    TransmitQueue txQueue;
+    route_id r1{1};
+    route_id r2{2};
+    txQueue.emplace(r1, generateMessage(CMD_PUB, 1, TransmitQueue::bulkMessageSize));
+    // timing messages never pass data on the same route
+    txQueue.emplace(r1, generateMessage(CMD_TIME_REQUEST, 2));
+    txQueue.emplace(r2, generateMessage(CMD_TIME_REQUEST, 3));
+    // a barrier waits for everything before it
+    txQueue.emplace(control_route, generateMessage(CMD_PROTOCOL, 4));
+    txQueue.emplace(r2, generateMessage(CMD_TIME_REQUEST, 5));
+    txQueue.emplacePriority(r1, generateMessage(CMD_REG_PUB, 6));
+    EXPECT_EQ(txQueue.size(), 6U);
+    std::vector<int> order;
+    while (!txQueue.empty()) {
+        order.push_back(txQueue.pop().second.messageID);
+    }
+    EXPECT_EQ(order, (std::vector<int>{6, 3, 1, 2, 4, 5}));
+    EXPECT_FALSE(txQueue.try_pop());
+    EXPECT_FALSE(txQueue.pop(std::chrono::milliseconds(10)));
+}
+
+TEST(TransmitQueue, timing_priority)
+{
+    TransmitQueue txQueue;
+    for (int ii = 0; ii < 10; ++ii) {
+        txQueue.emplace(route_id{100 + ii},
+                        generateMessage(CMD_PUB, 100 + ii, TransmitQueue::bulkMessageSize));
+    }
+    for (int ii = 0; ii < 10; ++ii) {
+        txQueue.emplace(route_id{200 + ii}, generateMessage(CMD_TIME_GRANT, 200 + ii));
+    }
+    // the timing lane gets its full weight before any bulk message goes out
+    for (int ii = 0; ii < TransmitQueue::laneWeights[0]; ++ii) {
+        EXPECT_EQ(txQueue.pop().second.action(), CMD_TIME_GRANT);
+    }
+    EXPECT_EQ(txQueue.pop().second.action(), CMD_PUB);
+    EXPECT_EQ(txQueue.size(), 11U);
+}
+
+TEST(TransmitQueue, backpressure)
+{
+    TransmitQueue txQueue;
+    route_id rid{1};
+    txQueue.setDataLimit(1000);
+    txQueue.emplace(rid, generateMessage(CMD_PUB, 1, 2000));
+    EXPECT_GT(txQueue.dataBytes(), 1000U);
+    // the limit is only reported while a transmitter is draining the queue
+    EXPECT_FALSE(txQueue.overDataLimit());
+    txQueue.setBackpressure(true);
+    EXPECT_TRUE(txQueue.overDataLimit());
+    // queueing more data does not block the caller
+    txQueue.emplace(rid, generateMessage(CMD_PUB, 2));
+    EXPECT_EQ(txQueue.size(), 2U);
+    EXPECT_EQ(txQueue.pop().second.messageID, 1);
+    EXPECT_FALSE(txQueue.overDataLimit());
+    EXPECT_EQ(txQueue.pop().second.messageID, 2);
+    EXPECT_EQ(txQueue.dataBytes(), 0U);
+}
@@ -205,6 +205,36 @@ TEST_F(vfed2_tests, json_publish)
     CE(helicsFederateFinalize(vFed1, &err));
 }
 
+TEST_F(vfed2_tests, publish_batch)
+{
+    SetupTest(helicsCreateValueFederate, "test", 1);
+    auto vFed1 = GetFederateAt(0);
+    ASSERT_FALSE(vFed1 == nullptr);
+
+    auto pub1 =
+        helicsFederateRegisterGlobalPublication(vFed1, "pub1", HELICS_DATA_TYPE_DOUBLE, "", &err);
+    auto pub2 =
+        helicsFederateRegisterGlobalPublication(vFed1, "pub2", HELICS_DATA_TYPE_INT, "", &err);
+    auto s1 = helicsFederateRegisterSubscription(vFed1, "pub1", nullptr, &err);
+    auto s2 = helicsFederateRegisterSubscription(vFed1, "pub2", nullptr, &err);
+    CE(helicsFederateEnterExecutingMode(vFed1, &err));
+
+    CE(helicsFederateBeginPublishBatch(vFed1, &err));
+    CE(helicsPublicationPublishDouble(pub1, 27.5, &err));
+    CE(helicsPublicationPublishInteger(pub2, 19, &err));
+    CE(helicsFederateCommitPublishBatch(vFed1, &err));
+    CE(helicsFederateRequestTime(vFed1, 1.0, &err));
+    EXPECT_EQ(helicsInputGetDouble(s1, &err), 27.5);
+    EXPECT_EQ(helicsInputGetInteger(s2, &err), 19);
+
+    CE(helicsFederateBeginPublishBatch(vFed1, &err));
+    CE(helicsPublicationPublishDouble(pub1, 12.25, &err));
+    CE(helicsFederateRequestTime(vFed1, 2.0, &err));
+    EXPECT_EQ(helicsInputGetDouble(s1, &err), 12.25);
+
+    CE(helicsFederateFinalize(vFed1, &err));
+}
+
 TEST_F(vfed2_tests, json_register_publish)
 {
     SetupTest(helicsCreateValueFederate, "test", 1);
@@ -18,7 +18,11 @@ SPDX-License-Identifier: BSD-3-Clause
 
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
+#include <gmlc/libguarded/guarded.hpp>
+#include <memory>
+#include <string>
 #include <thread>
+#include <vector>
 
 struct query: public FederateTestFixture, public ::testing::Test {
 };
@@ -526,6 +530,132 @@ TEST_F(query, current_state_core)
     helics::cleanupHelicsLibrary();
 }
 
+TEST_F(query, queue_latency)
+{
+    extraCoreArgs = "--queue_latency";
+    extraBrokerArgs = "--queue_latency";
+    SetupTest<helics::ValueFederate>("test", 2);
+    auto vFed1 = GetFederateAs<helics::ValueFederate>(0);
+    auto vFed2 = GetFederateAs<helics::ValueFederate>(1);
+    auto& pub = vFed1->registerGlobalPublication<double>("pub1");
+    vFed2->registerSubscription("pub1");
+    vFed1->enterExecutingModeAsync();
+    vFed2->enterExecutingMode();
+    vFed1->enterExecutingModeComplete();
+    for (int ii = 1; ii <= 5; ++ii) {
+        pub.publish(static_cast<double>(ii));
+        vFed1->requestTimeAsync(ii);
+        vFed2->requestTime(ii);
+        vFed1->requestTimeComplete();
+    }
+
+    auto val = loadJsonStr(vFed1->query("core", "queue_latency"));
+    EXPECT_GT(val["action_queue"]["count"].asUInt64(), 0U);
+    EXPECT_EQ(val["action_queue"]["buckets"].size(), 24U);
+    EXPECT_TRUE(val["transmit_queue"].isObject());
+    ASSERT_EQ(val["federates"].size(), 2U);
+    EXPECT_GT(val["federates"][0]["federate_queue"]["count"].asUInt64(), 0U);
+
+    val = loadJsonStr(vFed1->query("queue_latency"));
+    EXPECT_GT(val["federate_queue"]["count"].asUInt64(), 0U);
+
+    val = loadJsonStr(vFed1->query("root", "queue_latency"));
+    EXPECT_GT(val["action_queue"]["count"].asUInt64(), 0U);
+    // the test comms deliver directly to the queue so only the object is checked
+    EXPECT_TRUE(val["receive_dispatch"].isObject());
+
+    vFed1->finalize();
+    vFed2->finalize();
+    helics::cleanupHelicsLibrary();
+}
+
+TEST_F(query, memory)
+{
+    extraCoreArgs = "--memory_limit=1GB";
+    SetupTest<helics::MessageFederate>("test", 2);
+    auto mFed1 = GetFederateAs<helics::MessageFederate>(0);
+    auto mFed2 = GetFederateAs<helics::MessageFederate>(1);
+    auto& ept1 = mFed1->registerGlobalEndpoint("ept1");
+    mFed2->registerGlobalEndpoint("ept2");
+    mFed1->enterExecutingModeAsync();
+    mFed2->enterExecutingMode();
+    mFed1->enterExecutingModeComplete();
+    ept1.sendTo(std::string(4000, 'a'), "ept2");
+    ept1.sendTo(std::string(4000, 'b'), "ept2");
+    mFed1->requestTimeAsync(1.0);
+    mFed2->requestTime(1.0);
+    mFed1->requestTimeComplete();
+
+    auto val = loadJsonStr(mFed2->query("memory"));
+    EXPECT_GE(val["endpoints"].asUInt64(), 8000U);
+    EXPECT_GE(val["total"].asUInt64(), val["endpoints"].asUInt64());
+
+    val = loadJsonStr(mFed1->query("core", "memory"));
+    ASSERT_EQ(val["federates"].size(), 2U);
+    EXPECT_GE(val["federates"][1]["endpoints"].asUInt64(), 8000U);
+    EXPECT_GT(val["handles"].asUInt64(), 0U);
+    EXPECT_GE(val["total"].asUInt64(), 8000U);
+    EXPECT_EQ(val["limit"].asUInt64(), 1024U * 1024U * 1024U);
+    EXPECT_FALSE(val["limit_exceeded"].asBool());
+
+    val = loadJsonStr(mFed1->query("root", "memory"));
+    EXPECT_TRUE(val["total"].isUInt64());
+    EXPECT_TRUE(val["handles"].isUInt64());
+
+    mFed1->finalize();
+    mFed2->finalize();
+    helics::cleanupHelicsLibrary();
+}
+
+TEST_F(query, memory_limit_exceeded)
+{
+    extraCoreArgs = "--memory_limit=4KB";
+    SetupTest<helics::MessageFederate>("test", 2);
+    auto mFed1 = GetFederateAs<helics::MessageFederate>(0);
+    auto mFed2 = GetFederateAs<helics::MessageFederate>(1);
+    auto& ept1 = mFed1->registerGlobalEndpoint("ept1");
+    auto& ept2 = mFed2->registerGlobalEndpoint("ept2");
+    mFed1->enterExecutingModeAsync();
+    mFed2->enterExecutingMode();
+    mFed1->enterExecutingModeComplete();
+    ept1.sendTo(std::string(4000, 'a'), "ept2");
+    ept1.sendTo(std::string(4000, 'b'), "ept2");
+    mFed1->requestTimeAsync(1.0);
+    mFed2->requestTime(1.0);
+    mFed1->requestTimeComplete();
+
+    // the limit is checked at the end of each processing pass of the core
+    auto waitForLimitState = [&mFed1](bool exceeded) {
+        Json::Value val;
+        for (int ii = 0; ii < 20; ++ii) {
+            val = loadJsonStr(mFed1->query("core", "memory"));
+            if (val["limit_exceeded"].asBool() == exceeded) {
+                break;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        }
+        return val["limit_exceeded"].asBool();
+    };
+    // the unread messages in the endpoint put the core over the limit
+    EXPECT_TRUE(waitForLimitState(true));
+
+    // sending is slowed while the limit is exceeded but nothing is dropped
+    ept1.sendTo(std::string(100, 'c'), "ept2");
+    mFed1->requestTimeAsync(2.0);
+    mFed2->requestTime(2.0);
+    mFed1->requestTimeComplete();
+    EXPECT_EQ(ept2.pendingMessageCount(), 3U);
+    while (ept2.hasMessage()) {
+        ept2.getMessage();
+    }
+    // reading the messages brings the core back under the limit
+    EXPECT_FALSE(waitForLimitState(false));
+
+    mFed1->finalize();
+    mFed2->finalize();
+    helics::cleanupHelicsLibrary();
+}
+
 TEST_F(query, data_flow_graph)
 {
     SetupTest<helics::ValueFederate>("test", 2);
@@ -559,6 +689,66 @@ TEST_F(query, data_flow_graph)
     helics::cleanupHelicsLibrary();
 }
 
+TEST_F(query, data_flow_graph_subscription)
+{
+    SetupTest<helics::ValueFederate>("test", 2);
+    auto vFed1 = GetFederateAs<helics::ValueFederate>(0);
+    auto vFed2 = GetFederateAs<helics::ValueFederate>(1);
+    // the callback owns its storage so it stays valid however long the subscription lasts
+    auto updates = std::make_shared<gmlc::libguarded::guarded<std::vector<Json::Value>>>();
+    auto subId =
+        brokers[0]->subscribeToGraph("data_flow_graph", [updates](std::string_view update) {
+            updates->lock()->push_back(loadJsonStr(update));
+        });
+    EXPECT_GE(subId, 0);
+    EXPECT_LT(brokers[0]->subscribeToGraph("federate_map", [](std::string_view /*update*/) {}),
+              0);
+
+    vFed1->registerGlobalInput<double>("ipt1");
+    auto& p1 = vFed2->registerGlobalPublication<double>("pub1");
+    p1.addTarget("ipt1");
+    vFed1->enterInitializingModeAsync();
+    vFed2->enterInitializingMode();
+    vFed1->enterInitializingModeComplete();
+
+    // the publication shows up in the full graph or in a later delta
+    bool found{false};
+    for (int ii = 0; ii < 100 && !found; ++ii) {
+        {
+            auto handle = updates->lock();
+            for (const auto& update : *handle) {
+                if (helics::fileops::generateJsonString(update).find("pub1") !=
+                    std::string::npos) {
+                    found = true;
+                }
+            }
+        }
+        if (!found) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        }
+    }
+    EXPECT_TRUE(found);
+    brokers[0]->unsubscribeFromGraph(subId);
+    std::size_t updateCount{0};
+    {
+        auto received = updates->lock();
+        ASSERT_FALSE(received->empty());
+        EXPECT_EQ(received->front()["type"].asString(), "full");
+        for (std::size_t ii = 1; ii < received->size(); ++ii) {
+            EXPECT_EQ((*received)[ii]["type"].asString(), "delta");
+            EXPECT_EQ((*received)[ii]["version"].asInt64(),
+                      received->front()["version"].asInt64() + static_cast<std::int64_t>(ii));
+        }
+        updateCount = received->size();
+    }
+    // no callbacks are made after unsubscribeFromGraph returns
+    vFed1->finalize();
+    vFed2->finalize();
+    brokers[0]->query("root", "data_flow_graph");
+    EXPECT_EQ(updates->lock()->size(), updateCount);
+    helics::cleanupHelicsLibrary();
+}
+
 TEST_F(query, interfaces)
 {
     SetupTest<helics::CombinationFederate>("test", 1);
@@ -207,6 +207,42 @@ TEST_F(iteration_tests, time_iteration_test)
     EXPECT_EQ(val2, val);
 }
 
+TEST_F(iteration_tests, time_iteration_convergence)
+{
+    SetupTest<helics::ValueFederate>("test", 1);
+    auto vFed1 = GetFederateAs<helics::ValueFederate>(0);
+    // register the publications
+    auto pubid = vFed1->registerGlobalPublication<double>("pub1");
+
+    auto& subid = vFed1->registerSubscription("pub1");
+    subid.setMinimumChange(0.1);
+    vFed1->setProperty(HELICS_PROPERTY_TIME_PERIOD, 1.0);
+    vFed1->setProperty(HELICS_PROPERTY_TIME_DELTA, 1.0);
+    vFed1->enterExecutingMode();
+    pubid.publish(27.0);
+
+    auto comp = vFed1->requestTimeIterative(1.0, helics::IterationRequest::ITERATE_IF_NEEDED);
+
+    EXPECT_TRUE(comp.state == helics::IterationResult::ITERATING);
+    EXPECT_EQ(comp.grantedTime, helics::timeZero);
+    EXPECT_EQ(subid.getValue<double>(), 27.0);
+    // a change smaller than the tolerance should end the iteration
+    pubid.publish(27.05);
+    comp = vFed1->requestTimeIterative(1.0, helics::IterationRequest::ITERATE_IF_NEEDED);
+
+    EXPECT_TRUE(comp.state == helics::IterationResult::NEXT_STEP);
+    EXPECT_EQ(comp.grantedTime, 1.0);
+    EXPECT_EQ(subid.getValue<double>(), 27.0);
+    // a larger change should still iterate
+    pubid.publish(29.0);
+    comp = vFed1->requestTimeIterative(2.0, helics::IterationRequest::ITERATE_IF_NEEDED);
+
+    EXPECT_TRUE(comp.state == helics::IterationResult::ITERATING);
+    EXPECT_EQ(comp.grantedTime, 1.0);
+    EXPECT_EQ(subid.getValue<double>(), 29.0);
+    vFed1->finalize();
+}
+
 TEST_F(iteration_tests, time_iteration_test_2fed)
 {
     SetupTest<helics::ValueFederate>("test", 2, 1.0);
@@ -7,9 +7,13 @@ SPDX-License-Identifier: BSD-3-Clause
 
 #include "../application_api/testFixtures.hpp"
 #include "helics/ValueFederates.hpp"
+#include "helics/common/JsonProcessingFunctions.hpp"
 #include "helics/helics-config.h"
 
 #include "gtest/gtest.h"
+#include <algorithm>
+#include <string>
+#include <vector>
 
 /** tests for some network options*/
 
@@ -83,6 +87,52 @@ TEST_F(network_tests, test_external_tcpss_ipv4)
     vFed1->finalize();
 }
 
+/** send large repetitive values over a loopback connection with compression negotiated*/
+TEST_F(network_tests, test_tcp_compression)
+{
+    extraCoreArgs = "--compression";
+    extraBrokerArgs = "--compression";
+    SetupTest<helics::ValueFederate>("tcp_2", 2, 1.0);
+    auto vFed1 = GetFederateAs<helics::ValueFederate>(0);
+    auto vFed2 = GetFederateAs<helics::ValueFederate>(1);
+    ASSERT_TRUE(vFed1);
+    ASSERT_TRUE(vFed2);
+    auto& pub = vFed1->registerGlobalPublication<std::string>("pub1");
+    auto& sub = vFed2->registerSubscription("pub1");
+    vFed1->enterExecutingModeAsync();
+    vFed2->enterExecutingMode();
+    vFed1->enterExecutingModeComplete();
+
+    std::string value;
+    while (value.size() < 5000) {
+        value.append("bus=12;voltage=1.034;angle=-12.5;");
+    }
+    for (int ii = 1; ii <= 4; ++ii) {
+        value[0] = static_cast<char>('a' + ii);
+        pub.publish(value);
+        vFed1->requestTimeAsync(ii);
+        vFed2->requestTime(ii);
+        vFed1->requestTimeComplete();
+        EXPECT_EQ(sub.getValue<std::string>(), value);
+    }
+
+    std::uint64_t compressed{0};
+    double ratio{0.0};
+    for (const auto* target : {"core", "root"}) {
+        auto val = helics::fileops::loadJsonStr(vFed1->query(target, "compression"));
+        ASSERT_TRUE(val["routes"].isArray()) << target;
+        for (const auto& route : val["routes"]) {
+            compressed += route["compressed"].asUInt64();
+            ratio = std::max(ratio, route["ratio"].asDouble());
+        }
+    }
+    EXPECT_GT(compressed, 0U);
+    EXPECT_GT(ratio, 4.0);
+
+    vFed1->finalize();
+    vFed2->finalize();
+}
+
 #endif
 
 #ifdef HELICS_ENABLE_UDP_CORE
@@ -155,6 +205,50 @@ TEST_F(network_tests, test_otherport2)
     }
 }
 
+TEST_F(network_tests, test_zmq_payload_frames)
+{
+    SetupTest<helics::ValueFederate>("zmq_2", 2, 1.0);
+    auto vFed1 = GetFederateAs<helics::ValueFederate>(0);
+    auto vFed2 = GetFederateAs<helics::ValueFederate>(1);
+    ASSERT_TRUE(vFed1);
+    ASSERT_TRUE(vFed2);
+    // the large value goes in a separate payload frame and the small ones are batched
+    auto& pubLarge = vFed1->registerGlobalPublication<std::string>("large");
+    auto& subLarge = vFed2->registerSubscription("large");
+    std::vector<helics::Publication*> pubs;
+    std::vector<helics::Input*> subs;
+    for (int ii = 0; ii < 50; ++ii) {
+        auto key = std::string("small") + std::to_string(ii);
+        pubs.push_back(&vFed1->registerGlobalPublication<double>(key));
+        subs.push_back(&vFed2->registerSubscription(key));
+    }
+    vFed1->enterExecutingModeAsync();
+    vFed2->enterExecutingMode();
+    vFed1->enterExecutingModeComplete();
+
+    std::string value(20000, 'a');
+    for (std::size_t ii = 0; ii < value.size(); ++ii) {
+        value[ii] = static_cast<char>('a' + (ii * 7919U) % 26U);
+    }
+    for (int tt = 1; tt <= 3; ++tt) {
+        value[0] = static_cast<char>('0' + tt);
+        pubLarge.publish(value);
+        for (std::size_t ii = 0; ii < pubs.size(); ++ii) {
+            pubs[ii]->publish(static_cast<double>(tt * 100 + static_cast<int>(ii)));
+        }
+        vFed1->requestTimeAsync(tt);
+        vFed2->requestTime(tt);
+        vFed1->requestTimeComplete();
+        EXPECT_EQ(subLarge.getValue<std::string>(), value);
+        for (std::size_t ii = 0; ii < subs.size(); ++ii) {
+            EXPECT_EQ(subs[ii]->getValue<double>(),
+                      static_cast<double>(tt * 100 + static_cast<int>(ii)));
+        }
+    }
+    vFed1->finalize();
+    vFed2->finalize();
+}
+
 TEST_F(network_tests, test_otherport_fail)
 {
     const std::string brokerArgs = "--local_interface=tcp://127.0.0.1:33100";